@@ -0,0 +1,370 @@
+/*
+ * Alpha Miner
+ * Discovers an accepting Petri net from an XES event log (see alpha_miner.txt)
+ * Implemented in ANSI C on top of the XES importer (c_xes.c) and the PNML exporter (c_pnml.c)
+ *
+ * Build: cc -O2 -DK_LIB -o c_alpha_miner c_alpha_miner.c c_xes.c c_pnml.c
+ * Usage: c_alpha_miner input.xes output.pnml
+ * Entry point: alpha_miner (declared in k.h)
+ *
+ * **Main Components:**
+
+- **Footprint:**
+  - The log is encoded over activity ids (`encode_log`), then the directly-follows relation
+    (`a > b`) is collected in one pass over the events.
+  - Causality (`->`), parallel (`||`) and choice (`#`) are derived from it as n x n bitset
+    matrices (one row of 64-bit words per activity), so the set operations below are word-wise.
+
+- **Maximal pairs (Y_W):**
+  - A pair (A, B) is valid when A x A and B x B contain no `>` and A x B is contained in `->`.
+  - Consider the graph over 2n vertices (one "left" and one "right" copy of every activity)
+    where left a ~ left a' iff a # a', right b ~ right b' iff b # b' and left a ~ right b iff
+    a -> b. Valid pairs are exactly its cliques, and maximal pairs are its maximal cliques with
+    both sides non-empty.
+  - The maximal cliques are enumerated with Bron-Kerbosch with pivoting over bitsets. Branches
+    whose remaining vertices cannot produce a non-empty left and right side are pruned, so the
+    work follows the number of places instead of the 2^n subsets of activities.
+
+- **Petri net:**
+  - One transition per activity, one place per maximal pair, plus the input place (initial
+    marking 1) and the output place (final marking 1), exported with `exportPNML`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_bitset.h"
+#include "c_pnml.h"
+#include "c_xes.h"
+
+/* Footprint of the log as bitset matrices over activity ids */
+typedef struct {
+    int n;                   /* number of activities */
+    int words;               /* words per row */
+    bitset_word *follows;    /* a > b */
+    bitset_word *causal;     /* a -> b */
+    bitset_word *parallel;   /* a || b */
+    bitset_word *choice;     /* a # b (a # a iff a has no self-loop) */
+    bitset_word *start;      /* start activities */
+    bitset_word *end;        /* end activities */
+} Footprint;
+
+/* Maximal pairs (A, B): the bitsets of pair k are sets[2k] (A) and sets[2k + 1] (B) */
+typedef struct {
+    int count;
+    int capacity;
+    int words;
+    bitset_word *sets;
+} AlphaPlaces;
+
+/* State of the clique enumeration */
+typedef struct {
+    int n;
+    int words;               /* words per row of the 2n-vertex graph */
+    bitset_word *adjacency;  /* compatibility graph, 2n rows */
+    bitset_word *left;       /* vertices 0 .. n-1 */
+    bitset_word *right;      /* vertices n .. 2n-1 */
+    bitset_word *scratch;    /* four bitsets per recursion level */
+    AlphaPlaces *places;
+} CliqueSearch;
+
+/* Function prototypes */
+Footprint *compute_footprint(const EncodedLog *enc);
+void free_footprint(Footprint *fp);
+AlphaPlaces *find_maximal_pairs(const Footprint *fp);
+void free_alpha_places(AlphaPlaces *places);
+PetriNet *alpha_miner(const EncodedLog *enc);
+
+#define ROW(matrix, i, words) ((matrix) + (size_t)(i) * (words))
+
+/* Compute the footprint matrices of an encoded log */
+Footprint *compute_footprint(const EncodedLog *enc) {
+    Footprint *fp = (Footprint *)malloc(sizeof(Footprint));
+    int n = enc->dictionary.count;
+    int w = bitset_words(n);
+    size_t matrix_words = (size_t)n * w;
+    fp->n = n;
+    fp->words = w;
+    fp->follows = bitset_alloc((int)matrix_words);
+    fp->causal = bitset_alloc((int)matrix_words);
+    fp->parallel = bitset_alloc((int)matrix_words);
+    fp->choice = bitset_alloc((int)matrix_words);
+    fp->start = bitset_alloc(w);
+    fp->end = bitset_alloc(w);
+
+    /* Directly-follows relation, start and end activities */
+    for (int c = 0; c < enc->case_count; c++) {
+        int from = enc->case_offsets[c];
+        int to = enc->case_offsets[c + 1];
+        if (from == to) continue;
+        bitset_set(fp->start, enc->events[from]);
+        bitset_set(fp->end, enc->events[to - 1]);
+        for (int i = from; i + 1 < to; i++) {
+            bitset_set(ROW(fp->follows, enc->events[i], w), enc->events[i + 1]);
+        }
+    }
+
+    /* Transpose of '>' (row b holds the activities a with a > b) */
+    bitset_word *preceded = bitset_alloc((int)matrix_words);
+    for (int a = 0; a < n; a++) {
+        BITSET_FOREACH(b, ROW(fp->follows, a, w), w) {
+            bitset_set(ROW(preceded, b, w), a);
+        }
+    }
+
+    for (int a = 0; a < n; a++) {
+        bitset_word *f = ROW(fp->follows, a, w);
+        bitset_word *p = ROW(preceded, a, w);
+        bitset_word *causal = ROW(fp->causal, a, w);
+        bitset_word *parallel = ROW(fp->parallel, a, w);
+        bitset_word *choice = ROW(fp->choice, a, w);
+        for (int k = 0; k < w; k++) {
+            causal[k] = f[k] & ~p[k];
+            parallel[k] = f[k] & p[k];
+            choice[k] = ~(f[k] | p[k]);
+        }
+        /* Clear the padding bits of the last word */
+        if (n & 63) choice[w - 1] &= ((bitset_word)1 << (n & 63)) - 1;
+    }
+    free(preceded);
+    return fp;
+}
+
+void free_footprint(Footprint *fp) {
+    free(fp->follows);
+    free(fp->causal);
+    free(fp->parallel);
+    free(fp->choice);
+    free(fp->start);
+    free(fp->end);
+    free(fp);
+}
+
+static void add_alpha_place(AlphaPlaces *places, const bitset_word *a_set, const bitset_word *b_set) {
+    if (places->count >= places->capacity) {
+        places->capacity *= 2;
+        places->sets = (bitset_word *)realloc(places->sets, sizeof(bitset_word) * places->words * 2 * places->capacity);
+    }
+    bitset_copy(ROW(places->sets, 2 * places->count, places->words), a_set, places->words);
+    bitset_copy(ROW(places->sets, 2 * places->count + 1, places->words), b_set, places->words);
+    places->count++;
+}
+
+/* Record a maximal clique as the pair (A, B) */
+static void report_clique(CliqueSearch *s, const bitset_word *clique) {
+    AlphaPlaces *places = s->places;
+    bitset_word *a_set = bitset_alloc(places->words);
+    bitset_word *b_set = bitset_alloc(places->words);
+    BITSET_FOREACH(v, clique, s->words) {
+        if (v < s->n) bitset_set(a_set, v);
+        else bitset_set(b_set, v - s->n);
+    }
+    add_alpha_place(places, a_set, b_set);
+    free(a_set);
+    free(b_set);
+}
+
+/* Bron-Kerbosch with pivoting: r is the current clique, p the candidates, x the excluded vertices */
+static void enumerate_cliques(CliqueSearch *s, int depth, bitset_word *r, bitset_word *p, bitset_word *x) {
+    int w = s->words;
+
+    if (bitset_is_empty(p, w)) {
+        if (bitset_is_empty(x, w) && bitset_intersects(r, s->left, w) && bitset_intersects(r, s->right, w)) {
+            report_clique(s, r);
+        }
+        return;
+    }
+
+    /* Prune: every extension of r must end up with both a left and a right vertex */
+    int has_left = 0, has_right = 0;
+    for (int k = 0; k < w; k++) {
+        bitset_word reachable = r[k] | p[k];
+        has_left |= (reachable & s->left[k]) != 0;
+        has_right |= (reachable & s->right[k]) != 0;
+    }
+    if (!has_left || !has_right) return;
+
+    /* Pivot: the vertex of p | x with the most neighbours in p */
+    int pivot = -1, best = -1;
+    for (int pass = 0; pass < 2; pass++) {
+        bitset_word *set = pass == 0 ? p : x;
+        BITSET_FOREACH(u, set, w) {
+            int degree = bitset_and_count(p, ROW(s->adjacency, u, w), w);
+            if (degree > best) {
+                best = degree;
+                pivot = u;
+            }
+        }
+    }
+
+    bitset_word *level = ROW(s->scratch, 4 * depth, w);
+    bitset_word *candidates = level;
+    bitset_word *r_next = level + w;
+    bitset_word *p_next = level + 2 * w;
+    bitset_word *x_next = level + 3 * w;
+    bitset_and_not(candidates, p, ROW(s->adjacency, pivot, w), w);
+
+    BITSET_FOREACH(v, candidates, w) {
+        const bitset_word *neighbours = ROW(s->adjacency, v, w);
+        bitset_copy(r_next, r, w);
+        bitset_set(r_next, v);
+        bitset_and(p_next, p, neighbours, w);
+        bitset_and(x_next, x, neighbours, w);
+        enumerate_cliques(s, depth + 1, r_next, p_next, x_next);
+        bitset_clear(p, v);
+        bitset_set(x, v);
+    }
+}
+
+/* Find the maximal pairs (A, B) of the footprint */
+AlphaPlaces *find_maximal_pairs(const Footprint *fp) {
+    int n = fp->n;
+    int fw = fp->words;
+    AlphaPlaces *places = (AlphaPlaces *)malloc(sizeof(AlphaPlaces));
+    places->count = 0;
+    places->capacity = 16;
+    places->words = fw;
+    places->sets = (bitset_word *)malloc(sizeof(bitset_word) * fw * 2 * places->capacity);
+
+    CliqueSearch s;
+    s.n = n;
+    s.words = bitset_words(2 * n);
+    s.places = places;
+    int w = s.words;
+    s.adjacency = bitset_alloc(2 * n * w);
+    s.left = bitset_alloc(w);
+    s.right = bitset_alloc(w);
+    s.scratch = bitset_alloc(4 * (2 * n + 2) * w);
+
+    /* Activities with a self-loop (not a # a) cannot appear in any pair */
+    bitset_word *eligible = bitset_alloc(fw);
+    for (int a = 0; a < n; a++) {
+        if (bitset_test(ROW(fp->choice, a, fw), a)) bitset_set(eligible, a);
+        bitset_set(s.left, a);
+        bitset_set(s.right, n + a);
+    }
+
+    /* Compatibility graph */
+    for (int a = 0; a < n; a++) {
+        if (!bitset_test(eligible, a)) continue;
+        bitset_word *left_row = ROW(s.adjacency, a, w);
+        BITSET_FOREACH(b, ROW(fp->choice, a, fw), fw) {
+            if (b != a && bitset_test(eligible, b)) {
+                bitset_set(left_row, b);
+                bitset_set(ROW(s.adjacency, n + a, w), n + b);
+            }
+        }
+        BITSET_FOREACH(b, ROW(fp->causal, a, fw), fw) {
+            if (bitset_test(eligible, b)) {
+                bitset_set(left_row, n + b);
+                bitset_set(ROW(s.adjacency, n + b, w), a);
+            }
+        }
+    }
+
+    /* Only vertices with at least one causal edge can be part of a pair */
+    bitset_word *r = bitset_alloc(w);
+    bitset_word *p = bitset_alloc(w);
+    bitset_word *x = bitset_alloc(w);
+    for (int v = 0; v < 2 * n; v++) {
+        const bitset_word *opposite = v < n ? s.right : s.left;
+        if (bitset_intersects(ROW(s.adjacency, v, w), opposite, w)) bitset_set(p, v);
+    }
+    enumerate_cliques(&s, 0, r, p, x);
+
+    free(r);
+    free(p);
+    free(x);
+    free(eligible);
+    free(s.adjacency);
+    free(s.left);
+    free(s.right);
+    free(s.scratch);
+    return places;
+}
+
+void free_alpha_places(AlphaPlaces *places) {
+    free(places->sets);
+    free(places);
+}
+
+/* Apply the Alpha Miner to an encoded log */
+PetriNet *alpha_miner(const EncodedLog *enc) {
+    Footprint *fp = compute_footprint(enc);
+    AlphaPlaces *places = find_maximal_pairs(fp);
+    PetriNet *net = createPetriNet();
+    const char **names = (const char **)enc->dictionary.names;
+    int w = fp->words;
+    int arc_counter = 0;
+    char id[50], source[50], target[50];
+
+    /* Transitions */
+    for (int a = 0; a < fp->n; a++) {
+        snprintf(id, sizeof(id), "t_%d", a);
+        addTransition(net, id, (char *)names[a], 1);
+    }
+
+    /* Places of Y_W and their arcs */
+    for (int k = 0; k < places->count; k++) {
+        char place_id[50];
+        snprintf(place_id, sizeof(place_id), "p_%d", k + 1);
+        addPlace(net, place_id, 0);
+        BITSET_FOREACH(a, ROW(places->sets, 2 * k, w), w) {
+            snprintf(id, sizeof(id), "arc_%d", ++arc_counter);
+            snprintf(source, sizeof(source), "t_%d", a);
+            addArc(net, id, source, place_id);
+        }
+        BITSET_FOREACH(b, ROW(places->sets, 2 * k + 1, w), w) {
+            snprintf(id, sizeof(id), "arc_%d", ++arc_counter);
+            snprintf(target, sizeof(target), "t_%d", b);
+            addArc(net, id, place_id, target);
+        }
+    }
+
+    /* Input place i_W and output place o_W */
+    addPlace(net, "p_input", 1);
+    addPlace(net, "p_output", 0);
+    addFinalMarking(net, "p_output", 1);
+    BITSET_FOREACH(a, fp->start, w) {
+        snprintf(id, sizeof(id), "arc_%d", ++arc_counter);
+        snprintf(target, sizeof(target), "t_%d", a);
+        addArc(net, id, "p_input", target);
+    }
+    BITSET_FOREACH(a, fp->end, w) {
+        snprintf(id, sizeof(id), "arc_%d", ++arc_counter);
+        snprintf(source, sizeof(source), "t_%d", a);
+        addArc(net, id, source, "p_output");
+    }
+
+    free_alpha_places(places);
+    free_footprint(fp);
+    return net;
+}
+
+#ifndef K_CLI
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s input.xes output.pnml\n", argv[0]);
+        return 1;
+    }
+
+    FILE *fp_in = fopen(argv[1], "r");
+    if (!fp_in) {
+        perror("Failed to open input file");
+        return 1;
+    }
+    Log *log = create_log();
+    parse_xes(fp_in, log);
+    fclose(fp_in);
+
+    EncodedLog *enc = encode_log(log);
+    PetriNet *net = alpha_miner(enc);
+    exportPNML(net, argv[2]);
+
+    freePetriNet(net);
+    free_encoded_log(enc);
+    free_log(log);
+    return 0;
+}
+#endif
@@ -0,0 +1,320 @@
+/*
+ * Appendable log with incrementally maintained DFG and variants (see c_append_log.h)
+ * Implemented in ANSI C without external dependencies
+ *
+ * **Main Components:**
+
+- **Storage:**
+  - Events are stored in arrival order with a link to the next event of their case, so an event
+    of an old case is appended without moving anything. encode_append_log follows the links to
+    build the CSR layout of an EncodedLog.
+
+- **DFG:**
+  - Appending activity b to a case ending with a adds the edge (a, b) and moves one end count
+    from a to b; the first event of a case adds a start count. A new activity grows the DFG
+    with resize_dfg to at least twice its size (checked once per delta for whole traces), so
+    its n may exceed the number of activities; the counts beyond are zero.
+
+- **Variants:**
+  - A trie of activity sequences: every case points to the node of its sequence, and appending
+    an event moves it to the child for the activity, found in an open-addressing table keyed by
+    (parent, activity). The cases per node are the variant frequencies, with no hashing of
+    whole traces.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_append_log.h"
+#include "c_sort_log.h"
+
+#define INITIAL_CAPACITY 64
+#define MAX_DELTA_STRING (1 << 20)     /* bytes of a case name or activity in a binary delta */
+
+/* Make room for one more element in array (count and capacity are int lvalues) */
+#define GROW(array, count, capacity)                                                    \
+    do {                                                                                \
+        if ((count) >= (capacity)) {                                                    \
+            (capacity) = (capacity) ? (capacity) * 2 : INITIAL_CAPACITY;                \
+            (array) = realloc((array), sizeof(*(array)) * (size_t)(capacity));          \
+        }                                                                               \
+    } while (0)
+
+AppendLog *create_append_log(void) {
+    AppendLog *log = (AppendLog *)calloc(1, sizeof(AppendLog));
+    init_activity_dictionary(&log->dictionary);
+    init_activity_dictionary(&log->case_names);
+    log->dfg = create_dfg(0);
+
+    GROW(log->variants, log->variant_node_count, log->variant_node_capacity);
+    VariantNode *root = &log->variants[log->variant_node_count++];
+    root->parent = -1;
+    root->activity = -1;
+    root->length = 0;
+    root->case_count = 0;
+
+    log->child_slot_capacity = INITIAL_CAPACITY * 2;
+    log->child_slots = (int *)malloc(sizeof(int) * log->child_slot_capacity);
+    for (int i = 0; i < log->child_slot_capacity; i++) log->child_slots[i] = -1;
+    return log;
+}
+
+void free_append_log(AppendLog *log) {
+    free_activity_dictionary(&log->dictionary);
+    free_activity_dictionary(&log->case_names);
+    free_dfg(log->dfg);
+    free(log->events);
+    free(log->next_event);
+    free(log->case_first);
+    free(log->case_last);
+    free(log->case_variant);
+    free(log->named_cases);
+    free(log->variants);
+    free(log->child_slots);
+    free(log);
+}
+
+/* Variant trie */
+
+static unsigned int hash_child(int parent, int activity) {
+    return (unsigned int)parent * 2654435761u ^ (unsigned int)activity * 2246822519u;
+}
+
+static void insert_child(AppendLog *log, int node) {
+    unsigned int mask = (unsigned int)log->child_slot_capacity - 1;
+    unsigned int slot = hash_child(log->variants[node].parent, log->variants[node].activity) & mask;
+    while (log->child_slots[slot] >= 0) slot = (slot + 1) & mask;
+    log->child_slots[slot] = node;
+}
+
+/* Node of the sequence of parent followed by activity, added if needed */
+static int child_variant(AppendLog *log, int parent, int activity) {
+    unsigned int mask = (unsigned int)log->child_slot_capacity - 1;
+    unsigned int slot = hash_child(parent, activity) & mask;
+    int node;
+    while ((node = log->child_slots[slot]) >= 0) {
+        if (log->variants[node].parent == parent && log->variants[node].activity == activity) return node;
+        slot = (slot + 1) & mask;
+    }
+
+    GROW(log->variants, log->variant_node_count, log->variant_node_capacity);
+    node = log->variant_node_count++;
+    VariantNode *v = &log->variants[node];
+    v->parent = parent;
+    v->activity = activity;
+    v->length = log->variants[parent].length + 1;
+    v->case_count = 0;
+
+    /* Keep the load factor below 1/2 (the root is not in the table) */
+    if (log->variant_node_count * 2 > log->child_slot_capacity) {
+        free(log->child_slots);
+        log->child_slot_capacity *= 2;
+        log->child_slots = (int *)malloc(sizeof(int) * log->child_slot_capacity);
+        for (int i = 0; i < log->child_slot_capacity; i++) log->child_slots[i] = -1;
+        for (int i = 1; i < log->variant_node_count; i++) insert_child(log, i);
+    } else {
+        log->child_slots[slot] = node;
+    }
+    return node;
+}
+
+static void move_case_variant(AppendLog *log, int c, int node) {
+    VariantNode *old = &log->variants[log->case_variant[c]];
+    if (--old->case_count == 0) log->variant_count--;
+    if (log->variants[node].case_count++ == 0) log->variant_count++;
+    log->case_variant[c] = node;
+}
+
+void variant_sequence(const AppendLog *log, int v, int *out) {
+    for (int i = log->variants[v].length - 1; i >= 0; i--) {
+        out[i] = log->variants[v].activity;
+        v = log->variants[v].parent;
+    }
+}
+
+/* Appending */
+
+int append_case(AppendLog *log, const char *name) {
+    int name_id = -1;
+    if (name) {
+        name_id = intern_activity(&log->case_names, name);
+        if (name_id < log->named_case_capacity && log->named_cases[name_id] >= 0) return log->named_cases[name_id];
+    }
+
+    if (log->case_count >= log->case_capacity) {
+        log->case_capacity = log->case_capacity ? log->case_capacity * 2 : INITIAL_CAPACITY;
+        log->case_first = (int *)realloc(log->case_first, sizeof(int) * log->case_capacity);
+        log->case_last = (int *)realloc(log->case_last, sizeof(int) * log->case_capacity);
+        log->case_variant = (int *)realloc(log->case_variant, sizeof(int) * log->case_capacity);
+    }
+    int c = log->case_count++;
+    log->case_first[c] = -1;
+    log->case_last[c] = -1;
+    log->case_variant[c] = 0;
+    if (log->variants[0].case_count++ == 0) log->variant_count++;
+
+    if (name_id >= 0) {
+        if (name_id >= log->named_case_capacity) {
+            int capacity = log->named_case_capacity ? log->named_case_capacity : INITIAL_CAPACITY;
+            while (capacity <= name_id) capacity *= 2;
+            log->named_cases = (int *)realloc(log->named_cases, sizeof(int) * capacity);
+            for (int i = log->named_case_capacity; i < capacity; i++) log->named_cases[i] = -1;
+            log->named_case_capacity = capacity;
+        }
+        log->named_cases[name_id] = c;
+    }
+    return c;
+}
+
+/* Append the event with activity id a to case c */
+static void append_activity(AppendLog *log, int c, int a) {
+    if (log->event_count >= log->event_capacity) {
+        log->event_capacity = log->event_capacity ? log->event_capacity * 2 : INITIAL_CAPACITY;
+        log->events = (int *)realloc(log->events, sizeof(int) * log->event_capacity);
+        log->next_event = (int *)realloc(log->next_event, sizeof(int) * log->event_capacity);
+    }
+    int e = log->event_count++;
+    log->events[e] = a;
+    log->next_event[e] = -1;
+
+    int last = log->case_last[c];
+    if (last < 0) {
+        log->case_first[c] = e;
+        add_dfg_start(log->dfg, a, 1);
+    } else {
+        log->next_event[last] = e;
+        add_dfg_edge(log->dfg, log->events[last], a, 1);
+        add_dfg_end(log->dfg, log->events[last], -1);
+    }
+    add_dfg_end(log->dfg, a, 1);
+    log->case_last[c] = e;
+    move_case_variant(log, c, child_variant(log, log->case_variant[c], a));
+}
+
+/* Grow the DFG over all interned activities, at least doubling it */
+static void grow_dfg(AppendLog *log) {
+    int n = log->dfg->n;
+    if (log->dictionary.count <= n) return;
+    resize_dfg(log->dfg, log->dictionary.count > 2 * n ? log->dictionary.count : 2 * n);
+}
+
+void append_event(AppendLog *log, int c, const char *activity) {
+    int a = intern_activity(&log->dictionary, activity);
+    if (a >= log->dfg->n) grow_dfg(log);
+    append_activity(log, c, a);
+}
+
+void append_traces(AppendLog *log, const Log *delta) {
+    /* Intern the new activities first to grow the DFG once */
+    for (int i = 0; i < delta->case_count; i++) {
+        for (int j = 0; j < delta->cases[i].activity_count; j++) {
+            intern_activity(&log->dictionary, delta->cases[i].activities[j]);
+        }
+    }
+    grow_dfg(log);
+
+    for (int i = 0; i < delta->case_count; i++) {
+        const Case *t = &delta->cases[i];
+        int c = append_case(log, NULL);
+        for (int j = 0; j < t->activity_count; j++) {
+            append_activity(log, c, lookup_activity(&log->dictionary, t->activities[j]));
+        }
+    }
+}
+
+int append_xes(AppendLog *log, FILE *fp) {
+    Log *delta = create_log();
+    parse_xes(fp, delta);
+    sort_log_events(delta);
+    int events = 0;
+    for (int i = 0; i < delta->case_count; i++) events += delta->cases[i].activity_count;
+    append_traces(log, delta);
+    free_log(delta);
+    return events;
+}
+
+/* Binary delta */
+
+/*
+ * Read a length-prefixed string into *buffer (grown as needed): 1 if read, 0 at the end, -1 if
+ * truncated, -2 if longer than MAX_DELTA_STRING or out of memory (a corrupt length prefix)
+ */
+static int read_delta_string(FILE *fp, char **buffer, size_t *capacity) {
+    unsigned char prefix[4];
+    size_t n = fread(prefix, 1, 4, fp);
+    if (n == 0) return 0;
+    if (n < 4) return -1;
+    size_t length = (size_t)prefix[0] | (size_t)prefix[1] << 8 | (size_t)prefix[2] << 16 | (size_t)prefix[3] << 24;
+    if (length > MAX_DELTA_STRING) return -2;
+    if (length + 1 > *capacity) {
+        char *grown = (char *)realloc(*buffer, length + 1);
+        if (!grown) return -2;
+        *buffer = grown;
+        *capacity = length + 1;
+    }
+    if (fread(*buffer, 1, length, fp) != length) return -1;
+    (*buffer)[length] = '\0';
+    return 1;
+}
+
+int append_delta(AppendLog *log, FILE *fp) {
+    char *case_name = NULL, *activity = NULL;
+    size_t case_capacity = 0, activity_capacity = 0;
+    int events = 0, status;
+    while ((status = read_delta_string(fp, &case_name, &case_capacity)) > 0) {
+        status = read_delta_string(fp, &activity, &activity_capacity);
+        if (status <= 0) {
+            if (status == 0) status = -1;
+            break;
+        }
+        append_event(log, append_case(log, case_name), activity);
+        events++;
+    }
+    free(case_name);
+    free(activity);
+    if (status == -2) {
+        fprintf(stderr, "Invalid string length in delta after %d events\n", events);
+        return -1;
+    }
+    if (status < 0) {
+        fprintf(stderr, "Truncated delta after %d events\n", events);
+        return -1;
+    }
+    return events;
+}
+
+static void write_delta_string(FILE *fp, const char *s) {
+    size_t length = strlen(s);
+    unsigned char prefix[4] = {
+        (unsigned char)length, (unsigned char)(length >> 8), (unsigned char)(length >> 16), (unsigned char)(length >> 24)
+    };
+    fwrite(prefix, 1, 4, fp);
+    fwrite(s, 1, length, fp);
+}
+
+void write_delta_event(FILE *fp, const char *case_name, const char *activity) {
+    write_delta_string(fp, case_name);
+    write_delta_string(fp, activity);
+}
+
+/* Snapshot */
+
+EncodedLog *encode_append_log(const AppendLog *log) {
+    EncodedLog *enc = (EncodedLog *)malloc(sizeof(EncodedLog));
+    init_activity_dictionary(&enc->dictionary);
+    for (int a = 0; a < log->dictionary.count; a++) intern_activity(&enc->dictionary, log->dictionary.names[a]);
+
+    enc->case_count = log->case_count;
+    enc->event_count = log->event_count;
+    enc->case_offsets = (int *)malloc(sizeof(int) * (enc->case_count + 1));
+    enc->events = (int *)malloc(sizeof(int) * (enc->event_count > 0 ? enc->event_count : 1));
+
+    int pos = 0;
+    for (int c = 0; c < log->case_count; c++) {
+        enc->case_offsets[c] = pos;
+        for (int e = log->case_first[c]; e >= 0; e = log->next_event[e]) enc->events[pos++] = log->events[e];
+    }
+    enc->case_offsets[enc->case_count] = pos;
+    return enc;
+}
@@ -0,0 +1,84 @@
+/*
+ * Appendable log with incrementally maintained DFG and variants
+ *
+ * An AppendLog grows by new traces (XES fragments, parsed with parse_xes and
+ * put in timestamp order like the logs loaded by k, see c_sort_log.h) and
+ * by single events of new or existing cases (binary deltas). Every appended
+ * event updates the activity dictionary, the DFG (edge, start and end counts)
+ * and the variant of its case in O(1) amortized time, so keeping the derived
+ * structures current costs time proportional to the delta, not the history.
+ * encode_append_log takes an EncodedLog snapshot for the batch algorithms.
+ * Library module without a main.
+ *
+ * Binary delta: a sequence of events, each two length-prefixed strings (32-bit
+ * little-endian byte count, then the bytes, no terminator): the case name and
+ * the activity, at most 1 MB each. A case name seen before extends that case;
+ * traces appended from XES fragments are anonymous and can not be extended.
+ */
+
+#ifndef C_APPEND_LOG_H
+#define C_APPEND_LOG_H
+
+#include <stdio.h>
+
+#include "c_dfg.h"
+#include "c_xes.h"
+
+/* Node of the variant trie: the sequence of activities from the root to the node */
+typedef struct {
+    int parent;         /* -1 for the root */
+    int activity;       /* last activity of the sequence (-1 for the root) */
+    int length;
+    int case_count;     /* cases whose events are exactly this sequence */
+} VariantNode;
+
+typedef struct {
+    ActivityDictionary dictionary;
+    DFG *dfg;                   /* over the activities of the dictionary (dfg->n >= activities) */
+
+    /* Events in arrival order; the events of a case are linked through next_event */
+    int *events;                /* activity id */
+    int *next_event;            /* next event of the same case, -1 at the last */
+    int event_count;
+    int event_capacity;
+
+    int *case_first;            /* first and last event of each case, -1 if empty */
+    int *case_last;
+    int *case_variant;          /* variant trie node of each case */
+    int case_count;
+    int case_capacity;
+
+    ActivityDictionary case_names;  /* names of the cases of binary deltas */
+    int *named_cases;           /* case name id -> case */
+    int named_case_capacity;
+
+    VariantNode *variants;      /* node 0 is the root (empty sequence) */
+    int variant_node_count;
+    int variant_node_capacity;
+    int variant_count;          /* nodes with case_count > 0 */
+    int *child_slots;           /* open-addressing table of (parent, activity) -> node, -1 if empty */
+    int child_slot_capacity;    /* power of two */
+} AppendLog;
+
+AppendLog *create_append_log(void);
+void free_append_log(AppendLog *log);
+
+/* Add an empty case: named (an existing name returns its case) or anonymous (name NULL) */
+int append_case(AppendLog *log, const char *name);
+void append_event(AppendLog *log, int c, const char *activity);
+/* Append the cases of delta as new traces */
+void append_traces(AppendLog *log, const Log *delta);
+
+/* Append an XES fragment (traces, with or without the enclosing log); returns the events read */
+int append_xes(AppendLog *log, FILE *fp);
+/* Append a binary delta; returns the events read or -1 if the delta is truncated */
+int append_delta(AppendLog *log, FILE *fp);
+/* Write one event of a binary delta */
+void write_delta_event(FILE *fp, const char *case_name, const char *activity);
+
+/* Activities of variant node v, in order, to out (v's length entries) */
+void variant_sequence(const AppendLog *log, int v, int *out);
+
+EncodedLog *encode_append_log(const AppendLog *log);
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Region (arena) allocator for the records of the models
+ *
+ * An Arena hands out memory by bumping an offset in large chunks, so adding
+ * a string or a record costs no malloc call, and everything allocated from it
+ * is freed at once by arena_release (one free per chunk; the chunks double in
+ * size, so a model of n bytes has O(log n) of them). arena_reset empties an
+ * arena but keeps its largest chunk, for arenas that live through several
+ * phases (e.g. one record at a time when streaming). Individual allocations
+ * cannot be freed or grown in place: arena_grow copies.
+ *
+ * A zero-initialized Arena is empty and ready for use. Not thread-safe: use
+ * one arena per thread. Header only, like c_bitset.h; with -DK_STATS the
+ * chunks are counted as allocations of the including file (c_stats.h).
+ */
+
+#ifndef C_ARENA_H
+#define C_ARENA_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_stats.h"
+
+#define ARENA_FIRST_CHUNK_SIZE 65536
+#define ARENA_MAX_CHUNK_SIZE (16 * 1024 * 1024)
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;    /* previous (older) chunk */
+    size_t size;                /* bytes of data */
+    size_t used;
+} ArenaChunk;
+
+typedef struct {
+    ArenaChunk *chunks;         /* current chunk, NULL if none */
+    size_t bytes;               /* bytes handed out since the last reset */
+} Arena;
+
+/* Data of a chunk, aligned after its header */
+#define ARENA_HEADER_SIZE ((sizeof(ArenaChunk) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+#define ARENA_CHUNK_DATA(chunk) ((char *)(chunk) + ARENA_HEADER_SIZE)
+
+/* size bytes at a multiple of alignment (a power of two, at most ARENA_ALIGNMENT) */
+static inline void *arena_alloc_aligned(Arena *arena, size_t size, size_t alignment) {
+    ArenaChunk *chunk = arena->chunks;
+    size_t offset = chunk ? (chunk->used + alignment - 1) & ~(alignment - 1) : 0;
+    if (!chunk || offset > chunk->size || chunk->size - offset < size) {
+        size_t chunk_size = chunk ? chunk->size * 2 : ARENA_FIRST_CHUNK_SIZE;
+        if (chunk_size > ARENA_MAX_CHUNK_SIZE) chunk_size = ARENA_MAX_CHUNK_SIZE;
+        if (chunk_size < size) chunk_size = size;
+        ArenaChunk *fresh = (ArenaChunk *)malloc(ARENA_HEADER_SIZE + chunk_size);
+        fresh->size = chunk_size;
+        fresh->used = 0;
+        fresh->next = chunk;
+        arena->chunks = chunk = fresh;
+        offset = 0;
+    }
+    void *p = ARENA_CHUNK_DATA(chunk) + offset;
+    chunk->used = offset + size;
+    arena->bytes += size;
+    return p;
+}
+
+/* size bytes aligned for any type */
+static inline void *arena_alloc(Arena *arena, size_t size) {
+    return arena_alloc_aligned(arena, size, ARENA_ALIGNMENT);
+}
+
+static inline char *arena_strdup(Arena *arena, const char *s) {
+    size_t length = strlen(s) + 1;
+    char *copy = (char *)arena_alloc_aligned(arena, length, 1);
+    memcpy(copy, s, length);
+    return copy;
+}
+
+/* New copy of the first size bytes of p (NULL: none) with room for capacity bytes */
+static inline void *arena_grow(Arena *arena, const void *p, size_t size, size_t capacity) {
+    void *q = arena_alloc(arena, capacity);
+    if (p && size) memcpy(q, p, size);
+    return q;
+}
+
+/* Free all chunks */
+static inline void arena_release(Arena *arena) {
+    ArenaChunk *chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arena->chunks = NULL;
+    arena->bytes = 0;
+}
+
+/* Forget all allocations, keeping the current (largest) chunk for the next ones */
+static inline void arena_reset(Arena *arena) {
+    ArenaChunk *chunk = arena->chunks;
+    if (!chunk) return;
+    ArenaChunk *older = chunk->next;
+    while (older) {
+        ArenaChunk *next = older->next;
+        free(older);
+        older = next;
+    }
+    chunk->next = NULL;
+    chunk->used = 0;
+    arena->bytes = 0;
+}
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Concurrent import of several logs
+ *
+ * The importers keep all their state in the model they fill (Log, OcelLog)
+ * and in parser structures on the stack, so different files can be imported
+ * at the same time from different threads. import_logs does that for a batch
+ * of XES and OCEL files (the format is chosen by the file extension: .xes,
+ * .json/.jsonocel, .xml/.xmlocel, see c_file_format.h), one file per OpenMP
+ * thread at a time.
+ * The events of XES cases are put in timestamp order (c_sort_log.h), as by
+ * the k command line. Library module without a main.
+ *
+ * Not with -DK_STATS: the instrumentation of c_stats.c is process-wide and
+ * not synchronized.
+ */
+
+#ifndef C_BATCH_IMPORT_H
+#define C_BATCH_IMPORT_H
+
+#include "c_xes.h"
+#include "c_ocel.h"
+
+typedef struct {
+    const char *filename;
+    Log *xes;               /* set if an XES log was loaded */
+    OcelLog *ocel;          /* set if an OCEL log was loaded */
+    int status;             /* 0 if loaded, -1 on error (reported on stderr) */
+} ImportJob;
+
+/* Load the file of every job, concurrently; returns the number of jobs that failed */
+int import_logs(ImportJob *jobs, int count);
+/* Free the logs of the jobs */
+void free_import_jobs(ImportJob *jobs, int count);
+
+#endif
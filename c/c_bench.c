@@ -0,0 +1,396 @@
+/*
+ * Benchmark harness for the importers/exporters
+ * Generates a deterministic input (c_bench_gen.c), then times import and export in-process and
+ * prints one JSON object per phase (JSON lines), to be tracked across commits
+ * Implemented in C for POSIX systems (clock_gettime, getrusage)
+ *
+ * One harness is built per format (each compiles its module in, see below):
+ *   cc -O2 -DK_LIB -DBENCH_XES       -o bench_xes       c_bench.c c_bench_gen.c
+ *   cc -O2 -DK_LIB -DBENCH_PNML      -o bench_pnml      c_bench.c c_bench_gen.c
+ *   cc -O2 -DK_LIB -DBENCH_OCEL_JSON -o bench_ocel_json c_bench.c c_bench_gen.c
+ *   cc -O2 -DK_LIB -DBENCH_OCEL_XML  -o bench_ocel_xml  c_bench.c c_bench_gen.c
+ * (run_bench.sh builds and runs all of them)
+ *
+ * Usage: bench_<format> [--iterations N] [--label TEXT] [--dir DIR] [generator options]
+ *        generator options: --cases --events-per-case --activities --objects --object-types
+ *                           --attributes --seed (see c_bench_gen.c)
+ *
+ * **Main Components:**
+
+- **Allocation counting:**
+  - The module under test is compiled into this file (#include of its .c) with malloc, calloc,
+    realloc, strdup and free redirected to counting wrappers. Every block carries a small
+    header with its size, so the harness reports allocation calls, allocated bytes and the peak
+    of live heap bytes of each phase.
+
+- **Measurements (per phase, over the iterations):**
+  - Wall time (minimum and mean, CLOCK_MONOTONIC), throughput in MB/s of the file read or
+    written and in items/s (events for logs; places, transitions and arcs for PNML).
+  - Peak RSS of the process after the phase (getrusage, in KB).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include "c_bench_gen.h"
+
+/* Counting allocator */
+
+typedef struct {
+    long long allocations;  /* malloc/calloc/realloc/strdup calls */
+    long long bytes;        /* bytes requested */
+    long long live;         /* bytes currently allocated */
+    long long peak;         /* maximum of live */
+} AllocationStats;
+
+static AllocationStats alloc_stats;
+
+/* Header in front of every block, keeping the payload aligned for any type */
+typedef union {
+    size_t size;
+    long double align_ld;
+    void *align_ptr;
+    long long align_ll;
+} BlockHeader;
+
+static void track(long long delta) {
+    alloc_stats.live += delta;
+    if (alloc_stats.live > alloc_stats.peak) alloc_stats.peak = alloc_stats.live;
+}
+
+void *bench_malloc(size_t size) {
+    BlockHeader *h = (BlockHeader *)malloc(sizeof(BlockHeader) + size);
+    if (!h) return NULL;
+    h->size = size;
+    alloc_stats.allocations++;
+    alloc_stats.bytes += (long long)size;
+    track((long long)size);
+    return h + 1;
+}
+
+void *bench_calloc(size_t count, size_t size) {
+    void *p = bench_malloc(count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+void bench_free(void *p) {
+    if (!p) return;
+    BlockHeader *h = (BlockHeader *)p - 1;
+    track(-(long long)h->size);
+    free(h);
+}
+
+void *bench_realloc(void *p, size_t size) {
+    if (!p) return bench_malloc(size);
+    BlockHeader *h = (BlockHeader *)p - 1;
+    size_t old_size = h->size;
+    BlockHeader *n = (BlockHeader *)realloc(h, sizeof(BlockHeader) + size);
+    if (!n) return NULL;
+    n->size = size;
+    alloc_stats.allocations++;
+    alloc_stats.bytes += (long long)size;
+    track((long long)size - (long long)old_size);
+    return n + 1;
+}
+
+char *bench_strdup(const char *s) {
+    size_t len = strlen(s) + 1;
+    char *p = (char *)bench_malloc(len);
+    if (p) memcpy(p, s, len);
+    return p;
+}
+
+/* The module under test, with its allocations redirected */
+
+#undef strdup
+#define malloc(size) bench_malloc(size)
+#define calloc(count, size) bench_calloc(count, size)
+#define realloc(p, size) bench_realloc(p, size)
+#define free(p) bench_free(p)
+#define strdup(s) bench_strdup(s)
+
+#if defined(BENCH_XES)
+#include "c_xes.c"
+#define BENCH_FORMAT "xes"
+#define BENCH_EXTENSION "xes"
+#define BENCH_ITEM "events"
+#elif defined(BENCH_PNML)
+#include "c_pnml.c"
+#define BENCH_FORMAT "pnml"
+#define BENCH_EXTENSION "pnml"
+#define BENCH_ITEM "elements"
+#elif defined(BENCH_OCEL_JSON)
+#include "c_ocel.c"
+#include "c_ocel20_json.c"
+#define BENCH_FORMAT "ocel-json"
+#define BENCH_EXTENSION "json"
+#define BENCH_ITEM "events"
+#elif defined(BENCH_OCEL_XML)
+#include "c_ocel.c"
+#include "c_ocel20_xml.c"
+#define BENCH_FORMAT "ocel-xml"
+#define BENCH_EXTENSION "xml"
+#define BENCH_ITEM "events"
+#else
+#error "Define one of BENCH_XES, BENCH_PNML, BENCH_OCEL_JSON, BENCH_OCEL_XML"
+#endif
+
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+#undef strdup
+
+/*
+ * Format adapters: generate the input, import it, export it and release it.
+ * bench_import returns the number of items read.
+ */
+
+#if defined(BENCH_XES)
+
+static Log *bench_log;
+
+static void bench_generate(FILE *fp, const GeneratorConfig *config) {
+    generate_xes(fp, config);
+}
+
+static long long bench_import(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) return -1;
+    bench_log = create_log();
+    parse_xes(fp, bench_log);
+    fclose(fp);
+    long long items = 0;
+    for (int c = 0; c < bench_log->case_count; c++) items += bench_log->cases[c].activity_count;
+    return items;
+}
+
+static void bench_export(const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (!fp) return;
+    export_xes(fp, bench_log);
+    fclose(fp);
+}
+
+static void bench_release(void) {
+    free_log(bench_log);
+    bench_log = NULL;
+}
+
+#elif defined(BENCH_PNML)
+
+static PetriNet *bench_net;
+
+static void bench_generate(FILE *fp, const GeneratorConfig *config) {
+    generate_pnml(fp, config);
+}
+
+static long long bench_import(const char *path) {
+    bench_net = createPetriNet();
+    importPNML(bench_net, path);
+    long long items = 0;
+    for (Place *p = bench_net->places; p; p = p->next) items++;
+    for (Transition *t = bench_net->transitions; t; t = t->next) items++;
+    for (Arc *a = bench_net->arcs; a; a = a->next) items++;
+    return items;
+}
+
+static void bench_export(const char *path) {
+    exportPNML(bench_net, path);
+}
+
+static void bench_release(void) {
+    freePetriNet(bench_net);
+    bench_net = NULL;
+}
+
+#elif defined(BENCH_OCEL_JSON) || defined(BENCH_OCEL_XML)
+
+static OcelLog *bench_ocel;
+
+static void bench_generate(FILE *fp, const GeneratorConfig *config) {
+#ifdef BENCH_OCEL_JSON
+    generate_ocel_json(fp, config);
+#else
+    generate_ocel_xml(fp, config);
+#endif
+}
+
+static long long bench_import(const char *path) {
+    bench_ocel = create_ocel();
+#ifdef BENCH_OCEL_JSON
+    if (import_ocel_json(bench_ocel, path) != 0) return -1;
+#else
+    if (import_ocel_xml(bench_ocel, path) != 0) return -1;
+#endif
+    return bench_ocel->event_count;
+}
+
+static void bench_export(const char *path) {
+#ifdef BENCH_OCEL_JSON
+    export_ocel_json(bench_ocel, path);
+#else
+    export_ocel_xml(bench_ocel, path);
+#endif
+}
+
+static void bench_release(void) {
+    free_ocel(bench_ocel);
+    bench_ocel = NULL;
+}
+
+#endif
+
+
+/* Measurements */
+
+typedef struct {
+    double min_seconds;
+    double total_seconds;
+    long long allocations;
+    long long bytes;
+    long long peak_heap;
+    long peak_rss_kb;
+} PhaseResult;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static long long file_size(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return -1;
+    fseek(fp, 0, SEEK_END);
+    long long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+static void begin_phase(void) {
+    alloc_stats.allocations = 0;
+    alloc_stats.bytes = 0;
+    alloc_stats.peak = alloc_stats.live;
+}
+
+static void end_phase(PhaseResult *r, double seconds, long long base_live) {
+    if (seconds < r->min_seconds) r->min_seconds = seconds;
+    r->total_seconds += seconds;
+    /* Allocation counts are deterministic: keep the last iteration */
+    r->allocations = alloc_stats.allocations;
+    r->bytes = alloc_stats.bytes;
+    r->peak_heap = alloc_stats.peak - base_live;
+    r->peak_rss_kb = peak_rss_kb();
+}
+
+/* Print the JSON string s (escaped) */
+static void print_json_string(const char *s) {
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') printf("\\%c", *s);
+        else if ((unsigned char)*s < 0x20) printf("\\u%04x", (unsigned char)*s);
+        else putchar(*s);
+    }
+    putchar('"');
+}
+
+static void print_result(const char *phase, const char *label, const GeneratorConfig *config,
+                         int iterations, long long file_bytes, long long items, const PhaseResult *r) {
+    double seconds = r->min_seconds > 0 ? r->min_seconds : 1e-9;
+    printf("{\"format\":\"%s\",\"phase\":\"%s\",\"label\":", BENCH_FORMAT, phase);
+    print_json_string(label);
+    printf(",\"cases\":%d,\"events_per_case\":%d,\"activities\":%d,\"objects\":%d,\"object_types\":%d,"
+           "\"attributes\":%d,\"seed\":%llu,",
+           config->cases, config->events_per_case, config->activities, config->objects, config->object_types,
+           config->attributes, config->seed);
+    printf("\"iterations\":%d,\"file_bytes\":%lld,\"items\":%lld,\"item_unit\":\"%s\",", iterations, file_bytes, items, BENCH_ITEM);
+    printf("\"seconds_min\":%.6f,\"seconds_mean\":%.6f,\"mb_per_s\":%.2f,\"items_per_s\":%.0f,",
+           r->min_seconds, r->total_seconds / iterations, (double)file_bytes / 1e6 / seconds, (double)items / seconds);
+    printf("\"allocations\":%lld,\"allocated_bytes\":%lld,\"peak_heap_bytes\":%lld,\"peak_rss_kb\":%ld}\n",
+           r->allocations, r->bytes, r->peak_heap, r->peak_rss_kb);
+}
+
+int main(int argc, char *argv[]) {
+    GeneratorConfig config;
+    int iterations = 5;
+    const char *label = "";
+    const char *dir = ".";
+    init_generator_config(&config);
+
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--iterations") == 0) {
+            iterations = atoi(argv[i + 1]);
+            if (iterations < 1) iterations = 1;
+        } else if (strcmp(argv[i], "--label") == 0) {
+            label = argv[i + 1];
+        } else if (strcmp(argv[i], "--dir") == 0) {
+            dir = argv[i + 1];
+        } else if (!parse_generator_option(&config, argv[i], argv[i + 1])) {
+            fprintf(stderr, "Usage: %s [--iterations N] [--label TEXT] [--dir DIR] [--cases N] [--events-per-case N]\n"
+                            "       [--activities N] [--objects N] [--object-types N] [--attributes N] [--seed N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    char input_path[4096], output_path[4096];
+    snprintf(input_path, sizeof(input_path), "%s/bench_input_%s.%s", dir, BENCH_FORMAT, BENCH_EXTENSION);
+    snprintf(output_path, sizeof(output_path), "%s/bench_output_%s.%s", dir, BENCH_FORMAT, BENCH_EXTENSION);
+    FILE *fp = fopen(input_path, "w");
+    if (!fp) {
+        perror("Failed to create the benchmark input");
+        return 1;
+    }
+    bench_generate(fp, &config);
+    fclose(fp);
+    long long input_bytes = file_size(input_path);
+
+    PhaseResult import_result = { 1e30, 0, 0, 0, 0, 0 };
+    PhaseResult export_result = { 1e30, 0, 0, 0, 0, 0 };
+    long long items = 0, output_bytes = 0;
+    for (int it = 0; it < iterations; it++) {
+        long long base_live = alloc_stats.live;
+        begin_phase();
+        double t0 = now_seconds();
+        items = bench_import(input_path);
+        double t1 = now_seconds();
+        end_phase(&import_result, t1 - t0, base_live);
+        if (items < 0) {
+            fprintf(stderr, "Failed to import %s\n", input_path);
+            return 1;
+        }
+
+        base_live = alloc_stats.live;
+        begin_phase();
+        t0 = now_seconds();
+        bench_export(output_path);
+        t1 = now_seconds();
+        end_phase(&export_result, t1 - t0, base_live);
+        output_bytes = file_size(output_path);
+
+        bench_release();
+    }
+
+    print_result("import", label, &config, iterations, input_bytes, items, &import_result);
+    print_result("export", label, &config, iterations, output_bytes, items, &export_result);
+    remove(input_path);
+    remove(output_path);
+    return 0;
+}
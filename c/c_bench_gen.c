@@ -0,0 +1,319 @@
+/*
+ * Synthetic input generator for the benchmarks
+ * Writes deterministic XES, PNML and OCEL 2.0 (JSON/XML) files of configurable size
+ * Implemented in ANSI C without external dependencies
+ *
+ * Build: cc -O2 -o c_bench_gen c_bench_gen.c
+ * Usage: c_bench_gen xes|pnml|ocel-json|ocel-xml output_file [--cases N] [--events-per-case N]
+ *        [--activities N] [--objects N] [--object-types N] [--attributes N] [--seed N]
+ *
+ * **Main Components:**
+
+- **Random numbers:**
+  - xorshift64* seeded from the configuration (never from the clock or the address space), so
+    the output only depends on the options.
+
+- **Formats:**
+  - XES: one element per line, as read by c_xes.c; every event has `concept:name`,
+    `time:timestamp` and the requested number of string attributes.
+  - PNML: a net with one transition per activity, a chain of places through all of them plus
+    random extra arcs, initial and final marking.
+  - OCEL 2.0: object types and event types with attribute declarations, objects with
+    timestamped attributes and object-to-object relationships, events with attributes and 1 to
+    3 event-to-object relationships, in the layouts of ocel20_json.txt and ocel20_xml.txt.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_bench_gen.h"
+
+#define BASE_TIMESTAMP 1640995200LL /* 2022-01-01T00:00:00Z */
+
+static const char *QUALIFIERS[] = { "creates", "reads", "updates", "closes" };
+
+void init_generator_config(GeneratorConfig *config) {
+    config->cases = 1000;
+    config->events_per_case = 10;
+    config->activities = 20;
+    config->objects = 200;
+    config->object_types = 5;
+    config->attributes = 2;
+    config->seed = 42;
+}
+
+/* Set an option given as --name value; returns 0 if the option is unknown or invalid */
+int parse_generator_option(GeneratorConfig *config, const char *name, const char *value) {
+    char *end;
+    long long n = strtoll(value, &end, 10);
+    if (*end != '\0' || n < 0) return 0;
+    if (strcmp(name, "--seed") == 0) {
+        config->seed = (unsigned long long)n;
+        return 1;
+    }
+    if (n < 1 && strcmp(name, "--attributes") != 0) return 0;
+    if (strcmp(name, "--cases") == 0) config->cases = (int)n;
+    else if (strcmp(name, "--events-per-case") == 0) config->events_per_case = (int)n;
+    else if (strcmp(name, "--activities") == 0) config->activities = (int)n;
+    else if (strcmp(name, "--objects") == 0) config->objects = (int)n;
+    else if (strcmp(name, "--object-types") == 0) config->object_types = (int)n;
+    else if (strcmp(name, "--attributes") == 0) config->attributes = (int)n;
+    else return 0;
+    return 1;
+}
+
+/* xorshift64* */
+static unsigned long long next_random(unsigned long long *state) {
+    unsigned long long x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int random_below(unsigned long long *state, int n) {
+    return (int)((next_random(state) >> 33) % (unsigned long long)n);
+}
+
+static unsigned long long initial_state(const GeneratorConfig *config) {
+    /* The state must not be zero */
+    return config->seed * 0x9E3779B97F4A7C15ULL + 0x632BE59BD9B4E019ULL;
+}
+
+/* Format seconds since the epoch as an ISO 8601 UTC timestamp */
+static void format_timestamp(char *out, size_t size, long long seconds) {
+    long long days = seconds / 86400;
+    int rem = (int)(seconds % 86400);
+    /* Civil date from days since 1970-01-01 */
+    long long z = days + 719468;
+    long long era = z / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    int day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    int month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    long long year = yoe + era * 400 + (month <= 2);
+    snprintf(out, size, "%04lld-%02d-%02dT%02d:%02d:%02dZ", year, month, day, rem / 3600, (rem / 60) % 60, rem % 60);
+}
+
+static int case_length(unsigned long long *state, const GeneratorConfig *config) {
+    return 1 + random_below(state, 2 * config->events_per_case - 1);
+}
+
+void generate_xes(FILE *fp, const GeneratorConfig *config) {
+    unsigned long long state = initial_state(config);
+    char timestamp[64];
+
+    fprintf(fp, "<?xml version='1.0' encoding='UTF-8'?>\n");
+    fprintf(fp, "<log xes.version=\"1.0\" xes.features=\"nested-attributes\" openxes.version=\"1.0RC7\">\n");
+    for (int c = 0; c < config->cases; c++) {
+        long long t = BASE_TIMESTAMP + (long long)c * 600;
+        int len = case_length(&state, config);
+        fprintf(fp, "  <trace>\n");
+        fprintf(fp, "    <string key=\"concept:name\" value=\"case_%d\"/>\n", c);
+        for (int e = 0; e < len; e++) {
+            t += 60 + random_below(&state, 3600);
+            format_timestamp(timestamp, sizeof(timestamp), t);
+            fprintf(fp, "    <event>\n");
+            fprintf(fp, "      <string key=\"concept:name\" value=\"activity_%d\"/>\n", random_below(&state, config->activities));
+            fprintf(fp, "      <date key=\"time:timestamp\" value=\"%s\"/>\n", timestamp);
+            for (int a = 0; a < config->attributes; a++) {
+                fprintf(fp, "      <string key=\"attribute_%d\" value=\"value_%d\"/>\n", a, random_below(&state, 100));
+            }
+            fprintf(fp, "    </event>\n");
+        }
+        fprintf(fp, "  </trace>\n");
+    }
+    fprintf(fp, "</log>\n");
+}
+
+void generate_pnml(FILE *fp, const GeneratorConfig *config) {
+    unsigned long long state = initial_state(config);
+    int n = config->activities;
+    int arc = 0;
+
+    fprintf(fp, "<?xml version='1.0' encoding='UTF-8'?>\n<pnml>\n");
+    fprintf(fp, "  <net id=\"generated_net\" type=\"http://www.pnml.org/version-2009/grammar/pnmlcoremodel\">\n");
+    fprintf(fp, "    <page id=\"n0\">\n");
+    for (int p = 0; p <= n; p++) {
+        fprintf(fp, "      <place id=\"p_%d\">\n        <name>\n          <text>p_%d</text>\n        </name>\n", p, p);
+        if (p == 0) fprintf(fp, "        <initialMarking>\n          <text>1</text>\n        </initialMarking>\n");
+        fprintf(fp, "      </place>\n");
+    }
+    for (int t = 0; t < n; t++) {
+        fprintf(fp, "      <transition id=\"t_%d\">\n        <name>\n          <text>activity_%d</text>\n        </name>\n", t, t);
+        if (t % 10 == 9) fprintf(fp, "        <toolspecific tool=\"ProM\" version=\"6.4\" activity=\"$invisible$\"/>\n");
+        fprintf(fp, "      </transition>\n");
+    }
+    /* Chain p_0 -> t_0 -> p_1 -> ... -> p_n, plus backward arcs creating loops */
+    for (int t = 0; t < n; t++) {
+        fprintf(fp, "      <arc id=\"arc_%d\" source=\"p_%d\" target=\"t_%d\"/>\n", ++arc, t, t);
+        fprintf(fp, "      <arc id=\"arc_%d\" source=\"t_%d\" target=\"p_%d\"/>\n", ++arc, t, t + 1);
+    }
+    for (int t = 0; t < n; t++) {
+        if (random_below(&state, 4) == 0) {
+            fprintf(fp, "      <arc id=\"arc_%d\" source=\"t_%d\" target=\"p_%d\"/>\n", ++arc, t, random_below(&state, t + 1));
+        }
+    }
+    fprintf(fp, "    </page>\n");
+    fprintf(fp, "    <finalmarkings>\n      <marking>\n");
+    fprintf(fp, "        <place idref=\"p_%d\">\n          <text>1</text>\n        </place>\n", n);
+    fprintf(fp, "      </marking>\n    </finalmarkings>\n");
+    fprintf(fp, "  </net>\n</pnml>\n");
+}
+
+/*
+ * OCEL: both layouts share the same content, generated from the same random sequence
+ */
+
+static int event_total(const GeneratorConfig *config) {
+    return config->cases * config->events_per_case;
+}
+
+void generate_ocel_json(FILE *fp, const GeneratorConfig *config) {
+    unsigned long long state = initial_state(config);
+    char timestamp[64];
+    int events = event_total(config);
+
+    fprintf(fp, "{\n  \"objectTypes\": [\n");
+    for (int ot = 0; ot < config->object_types; ot++) {
+        fprintf(fp, "    {\n      \"name\": \"object_type_%d\",\n      \"attributes\": [", ot);
+        for (int a = 0; a < config->attributes; a++) {
+            fprintf(fp, "%s\n        {\n          \"name\": \"attribute_%d\",\n          \"type\": \"string\"\n        }", a ? "," : "", a);
+        }
+        fprintf(fp, "%s]\n    }%s\n", config->attributes ? "\n      " : "", ot + 1 < config->object_types ? "," : "");
+    }
+    fprintf(fp, "  ],\n  \"eventTypes\": [\n");
+    for (int et = 0; et < config->activities; et++) {
+        fprintf(fp, "    {\n      \"name\": \"activity_%d\",\n      \"attributes\": [", et);
+        for (int a = 0; a < config->attributes; a++) {
+            fprintf(fp, "%s\n        {\n          \"name\": \"attribute_%d\",\n          \"type\": \"string\"\n        }", a ? "," : "", a);
+        }
+        fprintf(fp, "%s]\n    }%s\n", config->attributes ? "\n      " : "", et + 1 < config->activities ? "," : "");
+    }
+    fprintf(fp, "  ],\n  \"objects\": [\n");
+    for (int o = 0; o < config->objects; o++) {
+        fprintf(fp, "    {\n      \"id\": \"o%d\",\n      \"type\": \"object_type_%d\",\n      \"attributes\": [", o, o % config->object_types);
+        for (int a = 0; a < config->attributes; a++) {
+            format_timestamp(timestamp, sizeof(timestamp), BASE_TIMESTAMP + random_below(&state, 86400 * 30));
+            fprintf(fp, "%s\n        {\n          \"name\": \"attribute_%d\",\n          \"time\": \"%s\",\n          \"value\": \"value_%d\"\n        }",
+                    a ? "," : "", a, timestamp, random_below(&state, 100));
+        }
+        fprintf(fp, "%s],\n      \"relationships\": [", config->attributes ? "\n      " : "");
+        if (o > 0) {
+            fprintf(fp, "\n        {\n          \"objectId\": \"o%d\",\n          \"qualifier\": \"%s\"\n        }\n      ",
+                    random_below(&state, o), QUALIFIERS[random_below(&state, 4)]);
+        }
+        fprintf(fp, "]\n    }%s\n", o + 1 < config->objects ? "," : "");
+    }
+    fprintf(fp, "  ],\n  \"events\": [\n");
+    for (int e = 0; e < events; e++) {
+        format_timestamp(timestamp, sizeof(timestamp), BASE_TIMESTAMP + (long long)e * 60 + random_below(&state, 60));
+        fprintf(fp, "    {\n      \"id\": \"e%d\",\n      \"type\": \"activity_%d\",\n      \"time\": \"%s\",\n      \"attributes\": [",
+                e, random_below(&state, config->activities), timestamp);
+        for (int a = 0; a < config->attributes; a++) {
+            fprintf(fp, "%s\n        {\n          \"name\": \"attribute_%d\",\n          \"value\": \"value_%d\"\n        }",
+                    a ? "," : "", a, random_below(&state, 100));
+        }
+        fprintf(fp, "%s],\n      \"relationships\": [", config->attributes ? "\n      " : "");
+        int related = 1 + random_below(&state, 3);
+        for (int r = 0; r < related; r++) {
+            fprintf(fp, "%s\n        {\n          \"objectId\": \"o%d\",\n          \"qualifier\": \"%s\"\n        }",
+                    r ? "," : "", random_below(&state, config->objects), QUALIFIERS[random_below(&state, 4)]);
+        }
+        fprintf(fp, "\n      ]\n    }%s\n", e + 1 < events ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+}
+
+void generate_ocel_xml(FILE *fp, const GeneratorConfig *config) {
+    unsigned long long state = initial_state(config);
+    char timestamp[64];
+    int events = event_total(config);
+
+    fprintf(fp, "<?xml version='1.0' encoding='UTF-8'?>\n<log>\n  <object-types>\n");
+    for (int ot = 0; ot < config->object_types; ot++) {
+        fprintf(fp, "    <object-type name=\"object_type_%d\">\n      <attributes>\n", ot);
+        for (int a = 0; a < config->attributes; a++) {
+            fprintf(fp, "        <attribute name=\"attribute_%d\" type=\"string\"/>\n", a);
+        }
+        fprintf(fp, "      </attributes>\n    </object-type>\n");
+    }
+    fprintf(fp, "  </object-types>\n  <event-types>\n");
+    for (int et = 0; et < config->activities; et++) {
+        fprintf(fp, "    <event-type name=\"activity_%d\">\n      <attributes>\n", et);
+        for (int a = 0; a < config->attributes; a++) {
+            fprintf(fp, "        <attribute name=\"attribute_%d\" type=\"string\"/>\n", a);
+        }
+        fprintf(fp, "      </attributes>\n    </event-type>\n");
+    }
+    fprintf(fp, "  </event-types>\n  <objects>\n");
+    for (int o = 0; o < config->objects; o++) {
+        fprintf(fp, "    <object id=\"o%d\" type=\"object_type_%d\">\n      <attributes>\n", o, o % config->object_types);
+        for (int a = 0; a < config->attributes; a++) {
+            format_timestamp(timestamp, sizeof(timestamp), BASE_TIMESTAMP + random_below(&state, 86400 * 30));
+            fprintf(fp, "        <attribute name=\"attribute_%d\" time=\"%s\">value_%d</attribute>\n", a, timestamp, random_below(&state, 100));
+        }
+        fprintf(fp, "      </attributes>\n      <objects>\n");
+        if (o > 0) {
+            fprintf(fp, "        <relationship object-id=\"o%d\" qualifier=\"%s\"/>\n", random_below(&state, o), QUALIFIERS[random_below(&state, 4)]);
+        }
+        fprintf(fp, "      </objects>\n    </object>\n");
+    }
+    fprintf(fp, "  </objects>\n  <events>\n");
+    for (int e = 0; e < events; e++) {
+        format_timestamp(timestamp, sizeof(timestamp), BASE_TIMESTAMP + (long long)e * 60 + random_below(&state, 60));
+        fprintf(fp, "    <event id=\"e%d\" type=\"activity_%d\" time=\"%s\">\n      <attributes>\n",
+                e, random_below(&state, config->activities), timestamp);
+        for (int a = 0; a < config->attributes; a++) {
+            fprintf(fp, "        <attribute name=\"attribute_%d\">value_%d</attribute>\n", a, random_below(&state, 100));
+        }
+        fprintf(fp, "      </attributes>\n      <objects>\n");
+        int related = 1 + random_below(&state, 3);
+        for (int r = 0; r < related; r++) {
+            fprintf(fp, "        <relationship object-id=\"o%d\" qualifier=\"%s\"/>\n",
+                    random_below(&state, config->objects), QUALIFIERS[random_below(&state, 4)]);
+        }
+        fprintf(fp, "      </objects>\n    </event>\n");
+    }
+    fprintf(fp, "  </events>\n</log>\n");
+}
+
+#ifndef K_LIB
+int main(int argc, char *argv[]) {
+    if (argc < 3 || argc % 2 == 0) {
+        fprintf(stderr, "Usage: %s xes|pnml|ocel-json|ocel-xml output_file [--cases N] [--events-per-case N]\n"
+                        "       [--activities N] [--objects N] [--object-types N] [--attributes N] [--seed N]\n", argv[0]);
+        return 1;
+    }
+
+    GeneratorConfig config;
+    init_generator_config(&config);
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (!parse_generator_option(&config, argv[i], argv[i + 1])) {
+            fprintf(stderr, "Invalid option: %s %s\n", argv[i], argv[i + 1]);
+            return 1;
+        }
+    }
+
+    FILE *fp = fopen(argv[2], "w");
+    if (!fp) {
+        perror("Failed to open output file");
+        return 1;
+    }
+    if (strcmp(argv[1], "xes") == 0) generate_xes(fp, &config);
+    else if (strcmp(argv[1], "pnml") == 0) generate_pnml(fp, &config);
+    else if (strcmp(argv[1], "ocel-json") == 0) generate_ocel_json(fp, &config);
+    else if (strcmp(argv[1], "ocel-xml") == 0) generate_ocel_xml(fp, &config);
+    else {
+        fprintf(stderr, "Unknown format: %s\n", argv[1]);
+        fclose(fp);
+        return 1;
+    }
+    fclose(fp);
+    return 0;
+}
+#endif
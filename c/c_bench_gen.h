@@ -0,0 +1,31 @@
+/*
+ * Deterministic synthetic input generator for the benchmarks (see c_bench.c)
+ *
+ * The same configuration (sizes and seed) always produces the same file, so
+ * results can be compared across commits. To link c_bench_gen.c into another
+ * program, compile it with -DK_LIB (leaves out its main).
+ */
+
+#ifndef C_BENCH_GEN_H
+#define C_BENCH_GEN_H
+
+#include <stdio.h>
+
+typedef struct {
+    int cases;              /* XES traces; OCEL: events are cases * events_per_case */
+    int events_per_case;    /* average, actual lengths are in 1 .. 2 * events_per_case - 1 */
+    int activities;         /* activities / event types; PNML: transitions */
+    int objects;            /* OCEL objects */
+    int object_types;       /* OCEL object types */
+    int attributes;         /* attributes per event and per object */
+    unsigned long long seed;
+} GeneratorConfig;
+
+void init_generator_config(GeneratorConfig *config);
+int parse_generator_option(GeneratorConfig *config, const char *name, const char *value);
+void generate_xes(FILE *fp, const GeneratorConfig *config);
+void generate_pnml(FILE *fp, const GeneratorConfig *config);
+void generate_ocel_json(FILE *fp, const GeneratorConfig *config);
+void generate_ocel_xml(FILE *fp, const GeneratorConfig *config);
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Fixed-size bitsets over dense ids (activities, nodes), stored as arrays of
+ * 64-bit words. Used by the discovery algorithms for relation matrices: row i
+ * of an n x n relation is the bitset at matrix + i * bitset_words(n).
+ */
+
+#ifndef C_BITSET_H
+#define C_BITSET_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint64_t bitset_word;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define bitset_popcount(w) __builtin_popcountll(w)
+#define bitset_ctz(w) __builtin_ctzll(w)
+#define bitset_clz(w) __builtin_clzll(w)
+#else
+static inline int bitset_popcount(bitset_word w) {
+    int count = 0;
+    while (w) {
+        w &= w - 1;
+        count++;
+    }
+    return count;
+}
+
+static inline int bitset_ctz(bitset_word w) {
+    int n = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        n++;
+    }
+    return n;
+}
+
+static inline int bitset_clz(bitset_word w) {
+    int n = 0;
+    while (!(w >> 63)) {
+        w <<= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+static inline int bitset_words(int n) {
+    return (n + 63) / 64;
+}
+
+static inline bitset_word *bitset_alloc(int words) {
+    return (bitset_word *)calloc(words > 0 ? words : 1, sizeof(bitset_word));
+}
+
+static inline void bitset_set(bitset_word *b, int i) {
+    b[i >> 6] |= (bitset_word)1 << (i & 63);
+}
+
+static inline void bitset_clear(bitset_word *b, int i) {
+    b[i >> 6] &= ~((bitset_word)1 << (i & 63));
+}
+
+static inline int bitset_test(const bitset_word *b, int i) {
+    return (int)((b[i >> 6] >> (i & 63)) & 1);
+}
+
+static inline void bitset_zero(bitset_word *b, int words) {
+    memset(b, 0, sizeof(bitset_word) * words);
+}
+
+static inline void bitset_copy(bitset_word *dst, const bitset_word *src, int words) {
+    memcpy(dst, src, sizeof(bitset_word) * words);
+}
+
+static inline int bitset_is_empty(const bitset_word *b, int words) {
+    for (int i = 0; i < words; i++) {
+        if (b[i]) return 0;
+    }
+    return 1;
+}
+
+static inline int bitset_count(const bitset_word *b, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) count += bitset_popcount(b[i]);
+    return count;
+}
+
+/* Number of elements of a & b */
+static inline int bitset_and_count(const bitset_word *a, const bitset_word *b, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) count += bitset_popcount(a[i] & b[i]);
+    return count;
+}
+
+/* 1 if a & b is not empty */
+static inline int bitset_intersects(const bitset_word *a, const bitset_word *b, int words) {
+    for (int i = 0; i < words; i++) {
+        if (a[i] & b[i]) return 1;
+    }
+    return 0;
+}
+
+/* 1 if a is a subset of b */
+static inline int bitset_is_subset(const bitset_word *a, const bitset_word *b, int words) {
+    for (int i = 0; i < words; i++) {
+        if (a[i] & ~b[i]) return 0;
+    }
+    return 1;
+}
+
+static inline void bitset_and(bitset_word *dst, const bitset_word *a, const bitset_word *b, int words) {
+    for (int i = 0; i < words; i++) dst[i] = a[i] & b[i];
+}
+
+static inline void bitset_or(bitset_word *dst, const bitset_word *a, const bitset_word *b, int words) {
+    for (int i = 0; i < words; i++) dst[i] = a[i] | b[i];
+}
+
+static inline void bitset_and_not(bitset_word *dst, const bitset_word *a, const bitset_word *b, int words) {
+    for (int i = 0; i < words; i++) dst[i] = a[i] & ~b[i];
+}
+
+/* Index of the first element >= from, or -1 if there is none */
+static inline int bitset_next(const bitset_word *b, int words, int from) {
+    int w = from >> 6;
+    if (w >= words) return -1;
+    bitset_word word = b[w] & (~(bitset_word)0 << (from & 63));
+    while (1) {
+        if (word) return (w << 6) + bitset_ctz(word);
+        if (++w >= words) return -1;
+        word = b[w];
+    }
+}
+
+/* Index of the last element <= from, or -1 if there is none */
+static inline int bitset_prev(const bitset_word *b, int from) {
+    if (from < 0) return -1;
+    int w = from >> 6;
+    bitset_word word = b[w] & (~(bitset_word)0 >> (63 - (from & 63)));
+    while (1) {
+        if (word) return (w << 6) + 63 - bitset_clz(word);
+        if (--w < 0) return -1;
+        word = b[w];
+    }
+}
+
+/* Number of elements in [from, to) */
+static inline int bitset_range_count(const bitset_word *b, int from, int to) {
+    if (from >= to) return 0;
+    int first = from >> 6, last = (to - 1) >> 6;
+    bitset_word low = ~(bitset_word)0 << (from & 63);
+    bitset_word high = ~(bitset_word)0 >> (63 - ((to - 1) & 63));
+    if (first == last) return bitset_popcount(b[first] & low & high);
+    int count = bitset_popcount(b[first] & low) + bitset_popcount(b[last] & high);
+    for (int i = first + 1; i < last; i++) count += bitset_popcount(b[i]);
+    return count;
+}
+
+#define BITSET_FOREACH(i, b, words) \
+    for (int i = bitset_next((b), (words), 0); i >= 0; i = bitset_next((b), (words), i + 1))
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Directly-Follows Graph (DFG)
+ * Dense counts and bitset relations over activity ids (see c_dfg.h)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_dfg.h"
+
+/* Create an empty DFG over n activities */
+DFG *create_dfg(int n) {
+    DFG *dfg = (DFG *)malloc(sizeof(DFG));
+    dfg->n = n;
+    dfg->words = bitset_words(n);
+    dfg->counts = (long long *)calloc((size_t)n * n + 1, sizeof(long long));
+    dfg->start_counts = (long long *)calloc(n + 1, sizeof(long long));
+    dfg->end_counts = (long long *)calloc(n + 1, sizeof(long long));
+    dfg->succ = bitset_alloc(n * dfg->words);
+    dfg->pred = bitset_alloc(n * dfg->words);
+    dfg->start = bitset_alloc(dfg->words);
+    dfg->end = bitset_alloc(dfg->words);
+    return dfg;
+}
+
+/* Grow dfg to n activities (n >= dfg->n), keeping its counts and relations */
+void resize_dfg(DFG *dfg, int n) {
+    if (n <= dfg->n) return;
+    DFG *grown = create_dfg(n);
+    for (int a = 0; a < dfg->n; a++) {
+        memcpy(grown->counts + (size_t)a * n, dfg->counts + (size_t)a * dfg->n, sizeof(long long) * dfg->n);
+        bitset_copy(DFG_ROW(grown->succ, a, grown->words), DFG_ROW(dfg->succ, a, dfg->words), dfg->words);
+        bitset_copy(DFG_ROW(grown->pred, a, grown->words), DFG_ROW(dfg->pred, a, dfg->words), dfg->words);
+    }
+    memcpy(grown->start_counts, dfg->start_counts, sizeof(long long) * dfg->n);
+    memcpy(grown->end_counts, dfg->end_counts, sizeof(long long) * dfg->n);
+    bitset_copy(grown->start, dfg->start, dfg->words);
+    bitset_copy(grown->end, dfg->end, dfg->words);
+
+    DFG old = *dfg;
+    *dfg = *grown;
+    *grown = old;
+    free_dfg(grown);
+}
+
+/* The counts may be negative (removals); a relation holds while its count is positive */
+void add_dfg_edge(DFG *dfg, int from, int to, long long count) {
+    long long *c = &dfg->counts[(size_t)from * dfg->n + to];
+    *c += count;
+    if (*c > 0) {
+        bitset_set(DFG_ROW(dfg->succ, from, dfg->words), to);
+        bitset_set(DFG_ROW(dfg->pred, to, dfg->words), from);
+    } else {
+        bitset_clear(DFG_ROW(dfg->succ, from, dfg->words), to);
+        bitset_clear(DFG_ROW(dfg->pred, to, dfg->words), from);
+    }
+}
+
+void add_dfg_start(DFG *dfg, int activity, long long count) {
+    dfg->start_counts[activity] += count;
+    if (dfg->start_counts[activity] > 0) bitset_set(dfg->start, activity);
+    else bitset_clear(dfg->start, activity);
+}
+
+void add_dfg_end(DFG *dfg, int activity, long long count) {
+    dfg->end_counts[activity] += count;
+    if (dfg->end_counts[activity] > 0) bitset_set(dfg->end, activity);
+    else bitset_clear(dfg->end, activity);
+}
+
+/* Compute the DFG of an encoded log in one pass over its events */
+DFG *compute_dfg(const EncodedLog *enc) {
+    DFG *dfg = create_dfg(enc->dictionary.count);
+    for (int c = 0; c < enc->case_count; c++) {
+        int from = enc->case_offsets[c];
+        int to = enc->case_offsets[c + 1];
+        if (from == to) continue;
+        add_dfg_start(dfg, enc->events[from], 1);
+        add_dfg_end(dfg, enc->events[to - 1], 1);
+        for (int i = from; i + 1 < to; i++) {
+            add_dfg_edge(dfg, enc->events[i], enc->events[i + 1], 1);
+        }
+    }
+    return dfg;
+}
+
+void free_dfg(DFG *dfg) {
+    free(dfg->counts);
+    free(dfg->start_counts);
+    free(dfg->end_counts);
+    free(dfg->succ);
+    free(dfg->pred);
+    free(dfg->start);
+    free(dfg->end);
+    free(dfg);
+}
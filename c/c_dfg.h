@@ -0,0 +1,38 @@
+/*
+ * Directly-Follows Graph (DFG)
+ *
+ * Dense DFG over the activity ids of an EncodedLog: an n x n matrix of
+ * directly-follows counts, start/end activity counts, and the same relations
+ * as bitset rows (successors, predecessors, start and end activities) for the
+ * set-based algorithms. Library module without a main.
+ */
+
+#ifndef C_DFG_H
+#define C_DFG_H
+
+#include "c_bitset.h"
+#include "c_xes.h"
+
+typedef struct {
+    int n;                    /* number of activities */
+    int words;                /* words per bitset row */
+    long long *counts;        /* counts[a * n + b]: times b directly follows a */
+    long long *start_counts;  /* cases starting with a */
+    long long *end_counts;    /* cases ending with a */
+    bitset_word *succ;        /* row a: activities b with a > b */
+    bitset_word *pred;        /* row b: activities a with a > b */
+    bitset_word *start;       /* start activities */
+    bitset_word *end;         /* end activities */
+} DFG;
+
+#define DFG_ROW(matrix, i, words) ((matrix) + (size_t)(i) * (words))
+
+DFG *create_dfg(int n);
+DFG *compute_dfg(const EncodedLog *enc);
+void resize_dfg(DFG *dfg, int n);
+void add_dfg_edge(DFG *dfg, int from, int to, long long count);
+void add_dfg_start(DFG *dfg, int activity, long long count);
+void add_dfg_end(DFG *dfg, int activity, long long count);
+void free_dfg(DFG *dfg);
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * File formats by extension, as used by the k command line, the batch import
+ * (c_batch_import.c) and load_ocel_file (c_ocel_columns.c): .xes, OCEL
+ * .json/.jsonocel and .xml/.xmlocel, .pnml, .ptml and .kpt (prefix tree),
+ * compared ignoring case. Header only, like c_timestamp.h.
+ */
+
+#ifndef C_FILE_FORMAT_H
+#define C_FILE_FORMAT_H
+
+#include <ctype.h>
+#include <string.h>
+
+typedef enum { FORMAT_UNKNOWN, FORMAT_XES, FORMAT_OCEL_JSON, FORMAT_OCEL_XML, FORMAT_PNML, FORMAT_PTML, FORMAT_PREFIX_TREE } FileFormat;
+
+/* Format of filename by its extension, FORMAT_UNKNOWN if none matches */
+static inline FileFormat file_format(const char *filename) {
+    static const struct {
+        const char *extension;
+        FileFormat format;
+    } formats[] = {
+        { ".xes", FORMAT_XES },
+        { ".json", FORMAT_OCEL_JSON },
+        { ".jsonocel", FORMAT_OCEL_JSON },
+        { ".xml", FORMAT_OCEL_XML },
+        { ".xmlocel", FORMAT_OCEL_XML },
+        { ".pnml", FORMAT_PNML },
+        { ".ptml", FORMAT_PTML },
+        { ".kpt", FORMAT_PREFIX_TREE },
+    };
+    const char *dot = strrchr(filename, '.');
+    if (!dot) return FORMAT_UNKNOWN;
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        const char *a = dot, *b = formats[i].extension;
+        while (*a && *b && tolower((unsigned char)*a) == *b) a++, b++;
+        if (!*a && !*b) return formats[i].format;
+    }
+    return FORMAT_UNKNOWN;
+}
+
+static inline int is_ocel_format(FileFormat format) {
+    return format == FORMAT_OCEL_JSON || format == FORMAT_OCEL_XML;
+}
+
+#endif
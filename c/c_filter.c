@@ -0,0 +1,273 @@
+/*
+ * Log filtering - selections over an EncodedLog (see c_filter.h)
+ * Implemented in ANSI C without external dependencies
+ *
+ * **Main Components:**
+
+- **Selections:**
+  - A case bitset and an event bitset over the log; filters only clear bits, so a chain of
+    filters costs one pass each and no copies. Consumers walk the selected events of each
+    selected case with bitset_next, skipping 64 unselected events per word.
+
+- **Activity masks:**
+  - Activity sets are turned into a byte table (one 0/1 entry per activity id) and the
+    activity-id array of the log is scanned 64 events at a time into a bitset word, without
+    branches, so the compiler can vectorize the loop. Presence and event filters then work on
+    whole words (AND with the selection, population count over the range of a case).
+
+- **Variants:**
+  - filter_variant_frequency hashes the selected activity sequence of each case (FNV-1a over
+    the ids) into an open-addressing table (load factor below 1/2); cases with equal hashes are
+    compared event by event, so there are no false merges.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_filter.h"
+
+LogSelection *select_all(const EncodedLog *log) {
+    LogSelection *sel = (LogSelection *)malloc(sizeof(LogSelection));
+    sel->log = log;
+    sel->case_words = bitset_words(log->case_count);
+    sel->event_words = bitset_words(log->event_count);
+    sel->cases = bitset_alloc(sel->case_words);
+    sel->events = bitset_alloc(sel->event_words);
+    for (int c = 0; c < log->case_count; c++) bitset_set(sel->cases, c);
+    memset(sel->events, 0xFF, sizeof(bitset_word) * sel->event_words);
+    if (log->event_count & 63) sel->events[sel->event_words - 1] = ((bitset_word)1 << (log->event_count & 63)) - 1;
+    return sel;
+}
+
+void free_selection(LogSelection *sel) {
+    free(sel->cases);
+    free(sel->events);
+    free(sel);
+}
+
+int selected_case_count(const LogSelection *sel) {
+    return bitset_count(sel->cases, sel->case_words);
+}
+
+int selected_case_length(const LogSelection *sel, int c) {
+    return bitset_range_count(sel->events, sel->log->case_offsets[c], sel->log->case_offsets[c + 1]);
+}
+
+int selected_event_count(const LogSelection *sel) {
+    int count = 0;
+    BITSET_FOREACH(c, sel->cases, sel->case_words) count += selected_case_length(sel, c);
+    return count;
+}
+
+int selected_cases(const LogSelection *sel, int *out) {
+    int count = 0;
+    BITSET_FOREACH(c, sel->cases, sel->case_words) out[count++] = c;
+    return count;
+}
+
+/* First selected event at or after i, or to if there is none before to */
+static int next_event(const LogSelection *sel, int i, int to) {
+    int next = i < to ? bitset_next(sel->events, sel->event_words, i) : -1;
+    return next < 0 || next > to ? to : next;
+}
+
+#define FOREACH_SELECTED_EVENT(i, sel, c)                                                        \
+    for (int i = next_event((sel), (sel)->log->case_offsets[c], (sel)->log->case_offsets[(c) + 1]); \
+         i < (sel)->log->case_offsets[(c) + 1];                                                    \
+         i = next_event((sel), i + 1, (sel)->log->case_offsets[(c) + 1]))
+
+/* Activity masks */
+
+/* Byte table of an activity set: member[a] is 1 if activity a is in the set */
+static unsigned char *activity_table(const EncodedLog *log, const bitset_word *activities) {
+    int n = log->dictionary.count;
+    unsigned char *member = (unsigned char *)malloc(n > 0 ? n : 1);
+    for (int a = 0; a < n; a++) member[a] = (unsigned char)bitset_test(activities, a);
+    return member;
+}
+
+/* Bitset of the events of the log whose activity is in the set (all events, not only the selected) */
+static bitset_word *activity_mask(const EncodedLog *log, const bitset_word *activities) {
+    unsigned char *member = activity_table(log, activities);
+    int words = bitset_words(log->event_count);
+    bitset_word *mask = bitset_alloc(words);
+    const int *events = log->events;
+    for (int w = 0; w < words; w++) {
+        int base = w * 64;
+        int n = log->event_count - base < 64 ? log->event_count - base : 64;
+        bitset_word bits = 0;
+        for (int j = 0; j < n; j++) bits |= (bitset_word)member[events[base + j]] << j;
+        mask[w] = bits;
+    }
+    free(member);
+    return mask;
+}
+
+/* Case filters */
+
+static void filter_boundary_activities(LogSelection *sel, const bitset_word *activities, int at_end) {
+    const EncodedLog *log = sel->log;
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        int from = log->case_offsets[c], to = log->case_offsets[c + 1];
+        int i = at_end ? bitset_prev(sel->events, to - 1) : next_event(sel, from, to);
+        if (i < from || i >= to || !bitset_test(activities, log->events[i])) bitset_clear(sel->cases, c);
+    }
+}
+
+void filter_start_activities(LogSelection *sel, const bitset_word *activities) {
+    filter_boundary_activities(sel, activities, 0);
+}
+
+void filter_end_activities(LogSelection *sel, const bitset_word *activities) {
+    filter_boundary_activities(sel, activities, 1);
+}
+
+void filter_case_length(LogSelection *sel, int min_length, int max_length) {
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        int length = selected_case_length(sel, c);
+        if (length < min_length || (max_length >= 0 && length > max_length)) bitset_clear(sel->cases, c);
+    }
+}
+
+void filter_activity_presence(LogSelection *sel, const bitset_word *activities, int present) {
+    bitset_word *hits = activity_mask(sel->log, activities);
+    bitset_and(hits, hits, sel->events, sel->event_words);
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        int found = bitset_range_count(hits, sel->log->case_offsets[c], sel->log->case_offsets[c + 1]) > 0;
+        if (found != present) bitset_clear(sel->cases, c);
+    }
+    free(hits);
+}
+
+/* Variants */
+
+static unsigned long long variant_hash(const LogSelection *sel, int c) {
+    unsigned long long h = 14695981039346656037ull;
+    FOREACH_SELECTED_EVENT(i, sel, c) {
+        h ^= (unsigned long long)(unsigned int)sel->log->events[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* 1 if cases a and b have the same sequence of selected activities */
+static int same_variant(const LogSelection *sel, int a, int b) {
+    const int *offsets = sel->log->case_offsets;
+    int i = next_event(sel, offsets[a], offsets[a + 1]);
+    int j = next_event(sel, offsets[b], offsets[b + 1]);
+    while (i < offsets[a + 1] && j < offsets[b + 1]) {
+        if (sel->log->events[i] != sel->log->events[j]) return 0;
+        i = next_event(sel, i + 1, offsets[a + 1]);
+        j = next_event(sel, j + 1, offsets[b + 1]);
+    }
+    return i == offsets[a + 1] && j == offsets[b + 1];
+}
+
+void filter_variant_frequency(LogSelection *sel, int min_count) {
+    int case_count = selected_case_count(sel);
+    int slot_capacity = 16;
+    while (slot_capacity < case_count * 2) slot_capacity *= 2;
+    unsigned int mask = (unsigned int)slot_capacity - 1;
+    int *slots = (int *)malloc(sizeof(int) * slot_capacity);
+    for (int i = 0; i < slot_capacity; i++) slots[i] = -1;
+
+    /* Variants by first case; variant_of[k] is the variant of the k-th selected case */
+    int *representatives = (int *)malloc(sizeof(int) * (case_count > 0 ? case_count : 1));
+    unsigned long long *hashes = (unsigned long long *)malloc(sizeof(unsigned long long) * (case_count > 0 ? case_count : 1));
+    int *counts = (int *)calloc(case_count > 0 ? case_count : 1, sizeof(int));
+    int *variant_of = (int *)malloc(sizeof(int) * (case_count > 0 ? case_count : 1));
+    int variant_count = 0, k = 0;
+
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        unsigned long long h = variant_hash(sel, c);
+        unsigned int slot = (unsigned int)(h ^ (h >> 32)) & mask;
+        int v;
+        while ((v = slots[slot]) >= 0 && !(hashes[v] == h && same_variant(sel, representatives[v], c))) {
+            slot = (slot + 1) & mask;
+        }
+        if (v < 0) {
+            v = variant_count++;
+            slots[slot] = v;
+            representatives[v] = c;
+            hashes[v] = h;
+        }
+        counts[v]++;
+        variant_of[k++] = v;
+    }
+
+    k = 0;
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        if (counts[variant_of[k++]] < min_count) bitset_clear(sel->cases, c);
+    }
+
+    free(slots);
+    free(representatives);
+    free(hashes);
+    free(counts);
+    free(variant_of);
+}
+
+/* Event filter */
+
+void filter_event_activities(LogSelection *sel, const bitset_word *activities) {
+    bitset_word *keep = activity_mask(sel->log, activities);
+    bitset_and(sel->events, sel->events, keep, sel->event_words);
+    free(keep);
+}
+
+/* Consumers */
+
+/* DFG of the view: the selected events of each selected case follow each other directly */
+DFG *compute_selection_dfg(const LogSelection *sel) {
+    const EncodedLog *log = sel->log;
+    DFG *dfg = create_dfg(log->dictionary.count);
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        int previous = -1;
+        FOREACH_SELECTED_EVENT(i, sel, c) {
+            if (previous < 0) add_dfg_start(dfg, log->events[i], 1);
+            else add_dfg_edge(dfg, previous, log->events[i], 1);
+            previous = log->events[i];
+        }
+        if (previous >= 0) add_dfg_end(dfg, previous, 1);
+    }
+    return dfg;
+}
+
+/* Copy of the view as an EncodedLog; the dictionary is copied whole, so the ids are the same */
+EncodedLog *materialize_selection(const LogSelection *sel) {
+    const EncodedLog *log = sel->log;
+    EncodedLog *enc = (EncodedLog *)malloc(sizeof(EncodedLog));
+    init_activity_dictionary(&enc->dictionary);
+    for (int a = 0; a < log->dictionary.count; a++) intern_activity(&enc->dictionary, log->dictionary.names[a]);
+
+    enc->case_count = selected_case_count(sel);
+    enc->event_count = selected_event_count(sel);
+    enc->case_offsets = (int *)malloc(sizeof(int) * (enc->case_count + 1));
+    enc->events = (int *)malloc(sizeof(int) * (enc->event_count > 0 ? enc->event_count : 1));
+
+    int pos = 0, k = 0;
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        enc->case_offsets[k++] = pos;
+        FOREACH_SELECTED_EVENT(i, sel, c) enc->events[pos++] = log->events[i];
+    }
+    enc->case_offsets[k] = pos;
+    return enc;
+}
+
+/* Write the view in the layout of export_xes */
+void export_selection_xes(FILE *fp, const LogSelection *sel) {
+    const EncodedLog *log = sel->log;
+    fprintf(fp, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    fprintf(fp, "<log xes.version=\"1.0\" xes.features=\"\">\n");
+    BITSET_FOREACH(c, sel->cases, sel->case_words) {
+        fprintf(fp, "  <trace>\n");
+        FOREACH_SELECTED_EVENT(i, sel, c) {
+            fprintf(fp, "    <event>\n");
+            fprintf(fp, "      <string key=\"concept:name\" value=\"%s\"/>\n", log->dictionary.names[log->events[i]]);
+            fprintf(fp, "    </event>\n");
+        }
+        fprintf(fp, "  </trace>\n");
+    }
+    fprintf(fp, "</log>\n");
+}
@@ -0,0 +1,62 @@
+/*
+ * Log filtering - selections over an EncodedLog
+ *
+ * A LogSelection is a view of a log: a bitset of the selected cases and a
+ * bitset of the selected events; the log itself is never copied. An event is
+ * in the view if its bit is set and its case is selected. Every filter narrows
+ * the selection in place and looks at the view as left by the filters before
+ * it (e.g. the start activity of a case is its first selected event), so
+ * filters chain without intermediate logs. Library module without a main.
+ *
+ * Activity sets are bitsets over the dictionary ids of the log (see
+ * lookup_activity and c_bitset.h).
+ */
+
+#ifndef C_FILTER_H
+#define C_FILTER_H
+
+#include <stdio.h>
+
+#include "c_bitset.h"
+#include "c_dfg.h"
+#include "c_xes.h"
+
+typedef struct {
+    const EncodedLog *log;
+    int case_words;
+    int event_words;
+    bitset_word *cases;     /* selected cases */
+    bitset_word *events;    /* selected events */
+} LogSelection;
+
+/* Selection of all cases and events of log */
+LogSelection *select_all(const EncodedLog *log);
+void free_selection(LogSelection *sel);
+
+int selected_case_count(const LogSelection *sel);
+int selected_event_count(const LogSelection *sel);
+/* Number of selected events of case c */
+int selected_case_length(const LogSelection *sel, int c);
+/* Selection vector: writes the selected cases in ascending order to out, returns their number */
+int selected_cases(const LogSelection *sel, int *out);
+
+/* Case filters: keep the selected cases ... */
+/* ... whose first (last) selected event has one of the activities */
+void filter_start_activities(LogSelection *sel, const bitset_word *activities);
+void filter_end_activities(LogSelection *sel, const bitset_word *activities);
+/* ... with min_length to max_length selected events (max_length < 0: no upper bound) */
+void filter_case_length(LogSelection *sel, int min_length, int max_length);
+/* ... whose variant (sequence of selected activities) occurs in at least min_count selected cases */
+void filter_variant_frequency(LogSelection *sel, int min_count);
+/* ... that contain (present = 1) or do not contain (present = 0) any of the activities */
+void filter_activity_presence(LogSelection *sel, const bitset_word *activities, int present);
+
+/* Event filter: keep the selected events that have one of the activities */
+void filter_event_activities(LogSelection *sel, const bitset_word *activities);
+
+/* Consumers of a view: the DFG of the selected events, a compacted copy, or an XES file */
+DFG *compute_selection_dfg(const LogSelection *sel);
+EncodedLog *materialize_selection(const LogSelection *sel);
+void export_selection_xes(FILE *fp, const LogSelection *sel);
+
+#endif
@@ -0,0 +1,502 @@
+/*
+ * Inductive Miner Directly-Follows (IMd)
+ * Discovers a process tree from an XES event log (see inductive_miner.txt) and writes it as PTML
+ * Implemented in ANSI C on top of the XES importer (c_xes.c) and the dense DFG (c_dfg.c)
+ *
+ * Build: cc -O2 -fopenmp -DK_LIB -o c_inductive_miner c_inductive_miner.c c_xes.c c_dfg.c c_process_tree.c
+ *        (without -fopenmp the recursion simply runs on one thread)
+ * Usage: c_inductive_miner input.xes output.ptml
+ * Entry point: inductive_miner (declared in k.h)
+ *
+ * **Main Components:**
+
+- **Sub-DFG views:**
+  - The DFG of the whole log is computed once. A recursion step does not project a new DFG:
+    it works on a view made of three bitsets (its activities, start and end activities) and
+    reads the edges restricted to the view from the successor/predecessor bitset rows.
+
+- **Cut detection (in the order of inductive_miner.txt):**
+  - Sequence: transitive closure of the view with Warshall's algorithm on 64-bit words, then
+    union-find merges pairwise reachable and pairwise unreachable activities; the groups are
+    ordered by reachability and the order is verified word-wise.
+  - Exclusive choice: union-find over the edges of the view (connected components).
+  - Parallel: union-find merges every pair not connected in both directions; groups without a
+    start or an end activity are merged into a complete group.
+  - Loop: start and end activities form the 'do' group; the components of the remaining graph
+    that are entered only from end activities and left only towards start activities are the
+    'redo' groups, the others are merged into 'do'.
+  - Base cases: a single activity gives a task, no cut gives the flower model.
+
+- **Parallel recursion:**
+  - The child sub-problems of a cut are independent and run as OpenMP tasks (small ones inline).
+  - The node array of the process tree (c_process_tree.c) is sized upfront, so tasks only
+    reserve node indices with an atomic counter; each task links the children of its own node.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_bitset.h"
+#include "c_dfg.h"
+#include "c_process_tree.h"
+#include "c_xes.h"
+
+/* Sub-problems with fewer activities are mined inline instead of as a separate task */
+#define IM_TASK_THRESHOLD 8
+
+typedef struct {
+    const DFG *dfg;
+    ProcessTree *tree;  /* labels are the activity ids of the DFG */
+} InductiveMiner;
+
+/* Sub-DFG: activities, start and end activities of the sub-problem (one allocation) */
+typedef struct {
+    bitset_word *activities;
+    bitset_word *start;
+    bitset_word *end;
+} DFGView;
+
+/* Groups of a cut, one bitset row per group (in the order of the operator's children) */
+typedef struct {
+    int count;
+    bitset_word *groups;
+} Cut;
+
+/* Function prototypes */
+ProcessTree *inductive_miner(const DFG *dfg, char **activities);
+
+static DFGView *alloc_view(int words) {
+    DFGView *view = (DFGView *)malloc(sizeof(DFGView));
+    view->activities = bitset_alloc(3 * words);
+    view->start = view->activities + words;
+    view->end = view->activities + 2 * words;
+    return view;
+}
+
+static void free_view(DFGView *view) {
+    free(view->activities);
+    free(view);
+}
+
+/* Reserve a node of the (preallocated) tree; tasks may call this concurrently */
+static int new_node(InductiveMiner *im, int op, int label) {
+    ProcessTree *tree = im->tree;
+    int index;
+#pragma omp atomic capture
+    index = tree->node_count++;
+    if (index >= tree->node_capacity) {
+        fprintf(stderr, "Process tree node capacity exceeded\n");
+        exit(1);
+    }
+    TreeNode *node = &tree->nodes[index];
+    node->op = op;
+    node->label = label;
+    node->parent = -1;
+    node->first_child = -1;
+    node->last_child = -1;
+    node->next_sibling = -1;
+    return index;
+}
+
+/* Create count children of node, linked in order; their indices are stored in children */
+static void new_children(InductiveMiner *im, int node, int count, int *children) {
+    for (int i = 0; i < count; i++) {
+        children[i] = new_node(im, PT_TAU, -1);
+        add_tree_child(im->tree, node, children[i]);
+    }
+}
+
+/* Union-find */
+
+static int uf_find(int *parent, int a) {
+    while (parent[a] != a) {
+        parent[a] = parent[parent[a]];
+        a = parent[a];
+    }
+    return a;
+}
+
+static void uf_union(int *parent, int a, int b) {
+    int ra = uf_find(parent, a);
+    int rb = uf_find(parent, b);
+    if (ra != rb) parent[rb] = ra;
+}
+
+static int *uf_create(const DFGView *view, int n, int words) {
+    int *parent = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    BITSET_FOREACH(a, view->activities, words) parent[a] = a;
+    return parent;
+}
+
+/* Turn the union-find classes of the view into the groups of a cut */
+static void collect_groups(const DFGView *view, int *parent, int n, int words, Cut *cut) {
+    int *group_of_root = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int size = bitset_count(view->activities, words);
+    BITSET_FOREACH(a, view->activities, words) group_of_root[a] = -1;
+    cut->count = 0;
+    cut->groups = bitset_alloc(size * words);
+    BITSET_FOREACH(a, view->activities, words) {
+        int root = uf_find(parent, a);
+        if (group_of_root[root] < 0) group_of_root[root] = cut->count++;
+        bitset_set(DFG_ROW(cut->groups, group_of_root[root], words), a);
+    }
+    free(group_of_root);
+}
+
+/* Transitive closure of the view (rows of activities outside the view are left empty) */
+static bitset_word *view_closure(const DFG *dfg, const DFGView *view) {
+    int w = dfg->words;
+    bitset_word *reach = bitset_alloc(dfg->n * w);
+    BITSET_FOREACH(a, view->activities, w) {
+        bitset_and(DFG_ROW(reach, a, w), DFG_ROW(dfg->succ, a, w), view->activities, w);
+    }
+    /* Warshall: if i reaches k, i reaches everything k reaches */
+    BITSET_FOREACH(k, view->activities, w) {
+        const bitset_word *row_k = DFG_ROW(reach, k, w);
+        BITSET_FOREACH(i, view->activities, w) {
+            bitset_word *row_i = DFG_ROW(reach, i, w);
+            if (bitset_test(row_i, k)) bitset_or(row_i, row_i, row_k, w);
+        }
+    }
+    return reach;
+}
+
+static int detect_sequence_cut(const DFG *dfg, const DFGView *view, Cut *cut) {
+    int n = dfg->n, w = dfg->words;
+    bitset_word *reach = view_closure(dfg, view);
+
+    /* Merge pairwise reachable and pairwise unreachable activities */
+    int *parent = uf_create(view, n, w);
+    BITSET_FOREACH(a, view->activities, w) {
+        const bitset_word *row_a = DFG_ROW(reach, a, w);
+        for (int b = bitset_next(view->activities, w, a + 1); b >= 0; b = bitset_next(view->activities, w, b + 1)) {
+            if (bitset_test(row_a, b) == bitset_test(DFG_ROW(reach, b, w), a)) uf_union(parent, a, b);
+        }
+    }
+    collect_groups(view, parent, n, w, cut);
+    free(parent);
+    if (cut->count < 2) {
+        free(cut->groups);
+        free(reach);
+        return 0;
+    }
+
+    /* Sort the groups: group i comes before group j if it reaches it */
+    bitset_word *tmp = bitset_alloc(w);
+    for (int i = 1; i < cut->count; i++) {
+        for (int j = i; j > 0; j--) {
+            bitset_word *prev = DFG_ROW(cut->groups, j - 1, w);
+            bitset_word *cur = DFG_ROW(cut->groups, j, w);
+            int rep = bitset_next(cur, w, 0);
+            int prev_rep = bitset_next(prev, w, 0);
+            if (!bitset_test(DFG_ROW(reach, rep, w), prev_rep)) break;
+            bitset_copy(tmp, prev, w);
+            bitset_copy(prev, cur, w);
+            bitset_copy(cur, tmp, w);
+        }
+    }
+
+    /* Verify: every activity reaches all later groups and no earlier group */
+    bitset_word *before = bitset_alloc(w);
+    bitset_word *after = bitset_alloc(w);
+    int valid = 1;
+    for (int i = 0; i < cut->count && valid; i++) {
+        bitset_word *group = DFG_ROW(cut->groups, i, w);
+        bitset_and_not(after, view->activities, before, w);
+        bitset_and_not(after, after, group, w);
+        BITSET_FOREACH(a, group, w) {
+            const bitset_word *row_a = DFG_ROW(reach, a, w);
+            if (!bitset_is_subset(after, row_a, w) || bitset_intersects(row_a, before, w)) {
+                valid = 0;
+                break;
+            }
+        }
+        bitset_or(before, before, group, w);
+    }
+
+    free(tmp);
+    free(before);
+    free(after);
+    free(reach);
+    if (!valid) free(cut->groups);
+    return valid;
+}
+
+static int detect_xor_cut(const DFG *dfg, const DFGView *view, Cut *cut) {
+    int n = dfg->n, w = dfg->words;
+    int *parent = uf_create(view, n, w);
+    bitset_word *next = bitset_alloc(w);
+    BITSET_FOREACH(a, view->activities, w) {
+        bitset_and(next, DFG_ROW(dfg->succ, a, w), view->activities, w);
+        BITSET_FOREACH(b, next, w) uf_union(parent, a, b);
+    }
+    free(next);
+    collect_groups(view, parent, n, w, cut);
+    free(parent);
+    if (cut->count < 2) {
+        free(cut->groups);
+        return 0;
+    }
+    return 1;
+}
+
+static int detect_parallel_cut(const DFG *dfg, const DFGView *view, Cut *cut) {
+    int n = dfg->n, w = dfg->words;
+
+    /* Activities not connected in both directions must be in the same group */
+    int *parent = uf_create(view, n, w);
+    bitset_word *apart = bitset_alloc(w);
+    BITSET_FOREACH(a, view->activities, w) {
+        const bitset_word *succ = DFG_ROW(dfg->succ, a, w);
+        const bitset_word *pred = DFG_ROW(dfg->pred, a, w);
+        for (int k = 0; k < w; k++) apart[k] = view->activities[k] & ~(succ[k] & pred[k]);
+        for (int b = bitset_next(apart, w, a + 1); b >= 0; b = bitset_next(apart, w, b + 1)) uf_union(parent, a, b);
+    }
+    free(apart);
+    collect_groups(view, parent, n, w, cut);
+    free(parent);
+
+    /* Each group needs a start and an end activity: merge the others into a complete group */
+    int complete = -1, kept = 0;
+    for (int i = 0; i < cut->count; i++) {
+        bitset_word *group = DFG_ROW(cut->groups, i, w);
+        if (bitset_intersects(group, view->start, w) && bitset_intersects(group, view->end, w)) {
+            complete = i;
+            break;
+        }
+    }
+    if (complete >= 0) {
+        bitset_word *target = DFG_ROW(cut->groups, complete, w);
+        for (int i = 0; i < cut->count; i++) {
+            bitset_word *group = DFG_ROW(cut->groups, i, w);
+            if (i != complete && !(bitset_intersects(group, view->start, w) && bitset_intersects(group, view->end, w))) {
+                bitset_or(target, target, group, w);
+            }
+        }
+        /* Compact the groups, keeping the complete ones */
+        for (int i = 0; i < cut->count; i++) {
+            bitset_word *group = DFG_ROW(cut->groups, i, w);
+            if (bitset_intersects(group, view->start, w) && bitset_intersects(group, view->end, w)) {
+                if (kept != i) bitset_copy(DFG_ROW(cut->groups, kept, w), group, w);
+                kept++;
+            }
+        }
+    }
+    cut->count = kept;
+    if (cut->count < 2) {
+        free(cut->groups);
+        return 0;
+    }
+    return 1;
+}
+
+static int detect_loop_cut(const DFG *dfg, const DFGView *view, Cut *cut) {
+    int n = dfg->n, w = dfg->words;
+    bitset_word *do_group = bitset_alloc(w);
+    bitset_word *rest = bitset_alloc(w);
+    bitset_word *edges = bitset_alloc(w);
+    bitset_or(do_group, view->start, view->end, w);
+    bitset_and(do_group, do_group, view->activities, w);
+    bitset_and_not(rest, view->activities, do_group, w);
+    if (bitset_is_empty(do_group, w)) {
+        free(do_group);
+        free(rest);
+        free(edges);
+        return 0;
+    }
+
+    /* Connected components of the graph without start and end activities */
+    DFGView rest_view;
+    rest_view.activities = rest;
+    int *parent = uf_create(&rest_view, n, w);
+    BITSET_FOREACH(a, rest, w) {
+        bitset_and(edges, DFG_ROW(dfg->succ, a, w), rest, w);
+        BITSET_FOREACH(b, edges, w) uf_union(parent, a, b);
+    }
+    Cut components;
+    collect_groups(&rest_view, parent, n, w, &components);
+    free(parent);
+
+    /* Redo components are entered only from end activities and left only towards start activities */
+    cut->groups = bitset_alloc((components.count + 1) * w);
+    cut->count = 1;
+    for (int i = 0; i < components.count; i++) {
+        bitset_word *component = DFG_ROW(components.groups, i, w);
+        int valid = 1, entered = 0, left = 0;
+        BITSET_FOREACH(a, component, w) {
+            bitset_and(edges, DFG_ROW(dfg->pred, a, w), do_group, w);
+            if (!bitset_is_empty(edges, w)) {
+                entered = 1;
+                if (!bitset_is_subset(edges, view->end, w)) valid = 0;
+            }
+            bitset_and(edges, DFG_ROW(dfg->succ, a, w), do_group, w);
+            if (!bitset_is_empty(edges, w)) {
+                left = 1;
+                if (!bitset_is_subset(edges, view->start, w)) valid = 0;
+            }
+            if (!valid) break;
+        }
+        if (valid && entered && left) {
+            bitset_copy(DFG_ROW(cut->groups, cut->count++, w), component, w);
+        } else {
+            bitset_or(do_group, do_group, component, w);
+        }
+    }
+    bitset_copy(cut->groups, do_group, w);
+
+    free(components.groups);
+    free(do_group);
+    free(rest);
+    free(edges);
+    if (cut->count < 2) {
+        free(cut->groups);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Sub-DFG of a group: its start (end) activities are the start (end) activities of the view in
+ * the group plus, except for the parallel cut, the activities with edges from (to) the rest of
+ * the view.
+ */
+static DFGView *project_view(const DFG *dfg, const DFGView *view, const bitset_word *group, int external) {
+    int w = dfg->words;
+    DFGView *child = alloc_view(w);
+    bitset_copy(child->activities, group, w);
+    bitset_and(child->start, view->start, group, w);
+    bitset_and(child->end, view->end, group, w);
+    if (external) {
+        bitset_word *outside = bitset_alloc(w);
+        bitset_and_not(outside, view->activities, group, w);
+        BITSET_FOREACH(a, group, w) {
+            if (bitset_intersects(DFG_ROW(dfg->pred, a, w), outside, w)) bitset_set(child->start, a);
+            if (bitset_intersects(DFG_ROW(dfg->succ, a, w), outside, w)) bitset_set(child->end, a);
+        }
+        free(outside);
+    }
+    return child;
+}
+
+static void mine(InductiveMiner *im, DFGView *view, int node);
+
+/* Mine a sub-problem, as a separate task when it is large enough */
+static void mine_child(InductiveMiner *im, DFGView *child, int node) {
+    int size = bitset_count(child->activities, im->dfg->words);
+#pragma omp task firstprivate(im, child, node) if(size >= IM_TASK_THRESHOLD)
+    mine(im, child, node);
+}
+
+/* Apply the recursion to a view, filling the (already allocated) node; frees the view */
+static void mine(InductiveMiner *im, DFGView *view, int node) {
+    const DFG *dfg = im->dfg;
+    int w = dfg->words;
+    int size = bitset_count(view->activities, w);
+
+    /* Base case: a single activity */
+    if (size == 1) {
+        im->tree->nodes[node].op = PT_TASK;
+        im->tree->nodes[node].label = bitset_next(view->activities, w, 0);
+        free_view(view);
+        return;
+    }
+
+    Cut cut;
+    int op;
+    if (detect_sequence_cut(dfg, view, &cut)) op = PT_SEQUENCE;
+    else if (detect_xor_cut(dfg, view, &cut)) op = PT_XOR;
+    else if (detect_parallel_cut(dfg, view, &cut)) op = PT_PARALLEL;
+    else if (detect_loop_cut(dfg, view, &cut)) op = PT_LOOP;
+    else {
+        /* Base case: no cut, flower model xorLoop(xor(activities), tau) */
+        int children[2];
+        im->tree->nodes[node].op = PT_LOOP;
+        new_children(im, node, 2, children);
+        im->tree->nodes[children[0]].op = PT_XOR;
+        BITSET_FOREACH(a, view->activities, w) {
+            add_tree_child(im->tree, children[0], new_node(im, PT_TASK, a));
+        }
+        free_view(view);
+        return;
+    }
+
+    im->tree->nodes[node].op = op;
+    int *children = (int *)malloc(sizeof(int) * cut.count);
+    DFGView **views = (DFGView **)malloc(sizeof(DFGView *) * cut.count);
+    for (int i = 0; i < cut.count; i++) {
+        views[i] = project_view(dfg, view, DFG_ROW(cut.groups, i, w), op != PT_PARALLEL);
+    }
+
+    if (op == PT_LOOP && cut.count > 2) {
+        /* Several redo groups: loop(do, xor(redo_1, ..., redo_k)) */
+        int loop_children[2];
+        new_children(im, node, 2, loop_children);
+        im->tree->nodes[loop_children[1]].op = PT_XOR;
+        children[0] = loop_children[0];
+        new_children(im, loop_children[1], cut.count - 1, children + 1);
+    } else {
+        new_children(im, node, cut.count, children);
+    }
+    for (int i = 0; i < cut.count; i++) {
+        mine_child(im, views[i], children[i]);
+    }
+
+    free(children);
+    free(views);
+    free(cut.groups);
+    free_view(view);
+}
+
+/* Discover a process tree from a DFG; the labels of the tree are the activity names */
+ProcessTree *inductive_miner(const DFG *dfg, char **activities) {
+    InductiveMiner im;
+    im.dfg = dfg;
+    im.tree = create_process_tree();
+    for (int a = 0; a < dfg->n; a++) add_tree_label(im.tree, activities[a]);
+    /* Every operator has at least two children and the leaves are the activities plus one tau
+       per flower (itself at least two activities), so there are fewer than 3n nodes */
+    reserve_tree_nodes(im.tree, 3 * dfg->n + 1);
+
+    int root = new_node(&im, PT_TAU, -1);
+    im.tree->root = root;
+    if (dfg->n > 0) {
+        DFGView *view = alloc_view(dfg->words);
+        for (int a = 0; a < dfg->n; a++) bitset_set(view->activities, a);
+        bitset_copy(view->start, dfg->start, dfg->words);
+        bitset_copy(view->end, dfg->end, dfg->words);
+#pragma omp parallel
+#pragma omp single
+        mine(&im, view, root);
+    }
+    return im.tree;
+}
+
+#ifndef K_CLI
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s input.xes output.ptml\n", argv[0]);
+        return 1;
+    }
+
+    FILE *fp_in = fopen(argv[1], "r");
+    if (!fp_in) {
+        perror("Failed to open input file");
+        return 1;
+    }
+    Log *log = create_log();
+    parse_xes(fp_in, log);
+    fclose(fp_in);
+
+    EncodedLog *enc = encode_log(log);
+    DFG *dfg = compute_dfg(enc);
+    ProcessTree *tree = inductive_miner(dfg, enc->dictionary.names);
+    int status = export_ptml(tree, argv[2]) == 0 ? 0 : 1;
+
+    free_process_tree(tree);
+    free_dfg(dfg);
+    free_encoded_log(enc);
+    free_log(log);
+    return status;
+}
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Log statistics - one streaming pass over an XES file (see c_log_stats.h)
+ * Implemented in ANSI C without external dependencies
+ *
+ * **Main Components:**
+
+- **Accumulation:**
+  - Each event is interned (one hash lookup) and counted; the pair with the previous event
+    of its trace goes to the DFG, the first and last events of a trace to its start and end
+    counts. A trace is never stored: only its last activity and its length are kept until
+    its end, when the length is added to the histogram.
+  - New activities grow the DFG by doubling (resize_dfg), so its n may exceed the number of
+    activities; the counts beyond are zero.
+
+- **Baselines:**
+  - The flower tree has one task per activity under a choice, in the body of a loop whose
+    redo is a silent step (as flower_miner.txt and rb_flower_miner.rb).
+  - The footprint is read off the successor and predecessor bitsets of the DFG: a -> b if
+    b follows a but not the other way round, a || b if both, a # b if neither.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_log_stats.h"
+
+#define INITIAL_CAPACITY 64
+
+LogStatistics *create_log_statistics(void) {
+    LogStatistics *stats = (LogStatistics *)calloc(1, sizeof(LogStatistics));
+    init_activity_dictionary(&stats->dictionary);
+    stats->dfg = create_dfg(0);
+    stats->max_length = -1;
+    stats->previous = -1;
+    return stats;
+}
+
+void free_log_statistics(LogStatistics *stats) {
+    free_activity_dictionary(&stats->dictionary);
+    free(stats->activity_counts);
+    free_dfg(stats->dfg);
+    free(stats->length_counts);
+    free(stats);
+}
+
+/* Accumulation */
+
+static void stats_begin_trace(void *context) {
+    LogStatistics *stats = (LogStatistics *)context;
+    stats->previous = -1;
+    stats->length = 0;
+}
+
+static void stats_end_trace(void *context) {
+    LogStatistics *stats = (LogStatistics *)context;
+    if (stats->previous >= 0) add_dfg_end(stats->dfg, stats->previous, 1);
+
+    if (stats->length >= stats->length_capacity) {
+        int capacity = stats->length_capacity ? stats->length_capacity : INITIAL_CAPACITY;
+        while (capacity <= stats->length) capacity *= 2;
+        stats->length_counts = (long long *)realloc(stats->length_counts, sizeof(long long) * capacity);
+        memset(stats->length_counts + stats->length_capacity, 0, sizeof(long long) * (capacity - stats->length_capacity));
+        stats->length_capacity = capacity;
+    }
+    stats->length_counts[stats->length]++;
+    if (stats->length > stats->max_length) stats->max_length = stats->length;
+    stats->case_count++;
+    stats->previous = -1;
+    stats->length = 0;
+}
+
+static void stats_event(void *context, const char *activity, long long timestamp) {
+    LogStatistics *stats = (LogStatistics *)context;
+    (void)timestamp;
+    int a = intern_activity(&stats->dictionary, activity);
+    if (a >= stats->dfg->n) {
+        int old = stats->dfg->n;
+        int n = old ? old * 2 : INITIAL_CAPACITY;
+        resize_dfg(stats->dfg, n);
+        stats->activity_counts = (long long *)realloc(stats->activity_counts, sizeof(long long) * n);
+        memset(stats->activity_counts + old, 0, sizeof(long long) * (n - old));
+    }
+
+    stats->activity_counts[a]++;
+    if (stats->previous < 0) add_dfg_start(stats->dfg, a, 1);
+    else add_dfg_edge(stats->dfg, stats->previous, a, 1);
+    stats->previous = a;
+    stats->length++;
+    stats->event_count++;
+}
+
+const XesHandler log_statistics_handler = { stats_begin_trace, stats_end_trace, stats_event };
+
+void read_log_statistics(FILE *fp, LogStatistics *stats) {
+    read_xes(fp, &log_statistics_handler, stats);
+}
+
+/* Baselines */
+
+ProcessTree *flower_tree(const LogStatistics *stats) {
+    int n = stats->dictionary.count;
+    ProcessTree *tree = create_process_tree();
+    reserve_tree_nodes(tree, n + 3);
+    int loop = add_tree_node(tree, PT_LOOP, -1);
+    int choice = add_tree_node(tree, PT_XOR, -1);
+    add_tree_child(tree, loop, choice);
+    add_tree_child(tree, loop, add_tree_node(tree, PT_TAU, -1));
+    for (int a = 0; a < n; a++) {
+        add_tree_child(tree, choice, add_tree_node(tree, PT_TASK, add_tree_label(tree, stats->dictionary.names[a])));
+    }
+    tree->root = loop;
+    return tree;
+}
+
+int export_footprint(const LogStatistics *stats, const char *filename) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        perror("Failed to open output file");
+        return -1;
+    }
+
+    const DFG *dfg = stats->dfg;
+    int n = stats->dictionary.count;
+    for (int b = 0; b < n; b++) fprintf(fp, "\t%s", stats->dictionary.names[b]);
+    fputc('\n', fp);
+    for (int a = 0; a < n; a++) {
+        const bitset_word *succ = DFG_ROW(dfg->succ, a, dfg->words);
+        const bitset_word *pred = DFG_ROW(dfg->pred, a, dfg->words);
+        fputs(stats->dictionary.names[a], fp);
+        for (int b = 0; b < n; b++) {
+            int follows = bitset_test(succ, b), preceded = bitset_test(pred, b);
+            fputs(follows && preceded ? "\t||" : follows ? "\t->" : preceded ? "\t<-" : "\t#", fp);
+        }
+        fputc('\n', fp);
+    }
+
+    int status = ferror(fp) ? -1 : 0;
+    if (fclose(fp) != 0) status = -1;
+    return status;
+}
+
+void print_log_statistics(FILE *fp, const LogStatistics *stats) {
+    const DFG *dfg = stats->dfg;
+    fprintf(fp, "Cases: %lld\n", stats->case_count);
+    fprintf(fp, "Events: %lld\n", stats->event_count);
+    fprintf(fp, "Activities: %d\n", stats->dictionary.count);
+    fprintf(fp, "Activity\tEvents\tStart\tEnd\n");
+    for (int a = 0; a < stats->dictionary.count; a++) {
+        fprintf(fp, "%s\t%lld\t%lld\t%lld\n", stats->dictionary.names[a], stats->activity_counts[a],
+                dfg->start_counts[a], dfg->end_counts[a]);
+    }
+    fprintf(fp, "Length\tCases\n");
+    for (int l = 0; l <= stats->max_length; l++) {
+        if (stats->length_counts[l]) fprintf(fp, "%d\t%lld\n", l, stats->length_counts[l]);
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * Log statistics - one streaming pass over an XES file
+ *
+ * The statistics are accumulated by the callbacks of read_xes while the file
+ * is read, without storing the traces: the memory used grows with the number
+ * of activities and the longest trace, not with the log. They are the input
+ * of the baseline models: the flower process tree (every activity, any
+ * number of times, in any order) and the footprint (the relations ->, <-, ||
+ * and # between the activities). Library module without a main.
+ */
+
+#ifndef C_LOG_STATS_H
+#define C_LOG_STATS_H
+
+#include <stdio.h>
+
+#include "c_dfg.h"
+#include "c_process_tree.h"
+#include "c_xes.h"
+
+typedef struct {
+    ActivityDictionary dictionary;
+    long long *activity_counts;     /* events per activity */
+    DFG *dfg;                       /* directly-follows, start and end counts (dfg->n >= activities) */
+    long long *length_counts;       /* cases per number of events, 0 .. max_length */
+    int max_length;
+    int length_capacity;
+    long long case_count;
+    long long event_count;
+
+    /* Trace being read */
+    int previous;                   /* last activity, -1 at the start of a trace */
+    int length;
+} LogStatistics;
+
+LogStatistics *create_log_statistics(void);
+void free_log_statistics(LogStatistics *stats);
+
+/* Handler of read_xes that accumulates into the LogStatistics given as context */
+extern const XesHandler log_statistics_handler;
+/* Read fp into stats (may be called for several files) */
+void read_log_statistics(FILE *fp, LogStatistics *stats);
+
+/* Flower model: xorLoop(xor(activities), tau), activities in order of first occurrence */
+ProcessTree *flower_tree(const LogStatistics *stats);
+/* Footprint as a tab-separated matrix (row a, column b: ->, <-, || or #): 0 on success */
+int export_footprint(const LogStatistics *stats, const char *filename);
+/* Counts, start/end activities and the length histogram as text */
+void print_log_statistics(FILE *fp, const LogStatistics *stats);
+
+#endif
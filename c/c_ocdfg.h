@@ -0,0 +1,45 @@
+/*
+ * Object-centric directly-follows graph (OC-DFG) of an OCEL log
+ *
+ * For every object type, a DFG over the event types: the events related to
+ * an object (E2O relationships), in the order of their timestamps, form its
+ * sequence, and each pair of consecutive events adds one to the edge between
+ * their types; the first and last events of the sequence count as start and
+ * end. Library module without a main.
+ *
+ * The object -> events index the OC-DFG is computed from is kept in an
+ * OcelObjectIndex, which can be reused for other per-object passes.
+ */
+
+#ifndef C_OCDFG_H
+#define C_OCDFG_H
+
+#include "c_dfg.h"
+#include "c_ocel.h"
+
+typedef struct {
+    const OcelLog *log;
+    int *object_offsets;        /* object_count + 1 entries */
+    int *object_events;         /* events of object o: object_events[object_offsets[o] .. object_offsets[o + 1]),
+                                   by time (ties: by position in the log), each event once */
+    long long unresolved;       /* E2O relationships to object ids not in the log */
+} OcelObjectIndex;
+
+typedef struct {
+    int object_type_count;
+    int event_type_count;
+    DFG **dfgs;                 /* per object type, over the event types */
+    int *object_counts;         /* objects per type */
+} OcDfg;
+
+OcelObjectIndex *build_ocel_object_index(const OcelLog *log);
+void free_ocel_object_index(OcelObjectIndex *index);
+
+/* OC-DFG of the log, from its object index; the objects are divided among OpenMP threads */
+OcDfg *compute_ocdfg(const OcelObjectIndex *index);
+void free_ocdfg(OcDfg *ocdfg);
+
+/* Start, end and edge counts of each object type as text */
+void print_ocdfg(FILE *fp, const OcDfg *ocdfg, const OcelLog *log);
+
+#endif
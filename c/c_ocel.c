@@ -0,0 +1,323 @@
+/*
+ * OCEL 2.0 object-centric event log - shared in-memory model (see c_ocel.h)
+ * Implemented in ANSI C without external dependencies
+ *
+ * **Main Components:**
+
+- **Growable arrays:**
+  - Types, events, objects and the attribute/relationship pools double their capacity when
+    full (GROW), so appending is amortized O(1).
+
+- **Strings:**
+  - All strings are copied into the arenas of the log, so adding a record costs no malloc call
+    once the arrays have grown, and clearing the records or freeing the log releases the
+    strings in a few free calls instead of one per string.
+
+- **Type index:**
+  - Event and object types are found by name through an open-addressing hash table (FNV-1a,
+    linear probing, load factor below 1/2), so records can refer to them by index.
+
+- **Streaming:**
+  - end_ocel_record passes a completed record to the record handler and clears the records,
+    whose arrays keep their capacity, so a streamed import allocates for one record only.
+  - OcelWriter writes a log record by record through the OcelFormat of the JSON or XML module,
+    keeping track of the open section; export_ocel_json/xml write a whole log through it too.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_ocel.h"
+#include "c_timestamp.h"
+#include "c_stats.h"
+
+#define INITIAL_CAPACITY 16
+
+/* Make room for one more element in array (count and capacity are int lvalues) */
+#define GROW(array, count, capacity)                                                    \
+    do {                                                                                \
+        if ((count) >= (capacity)) {                                                    \
+            (capacity) = (capacity) ? (capacity) * 2 : INITIAL_CAPACITY;                \
+            (array) = realloc((array), sizeof(*(array)) * (size_t)(capacity));          \
+        }                                                                               \
+    } while (0)
+
+static char *copy_string(Arena *arena, const char *s) {
+    return arena_strdup(arena, s ? s : "");
+}
+
+OcelLog *create_ocel(void) {
+    OcelLog *log = (OcelLog *)calloc(1, sizeof(OcelLog));
+    return log;
+}
+
+static void free_types(OcelType *types, int count) {
+    for (int i = 0; i < count; i++) free(types[i].attributes);
+    free(types);
+}
+
+void clear_ocel_records(OcelLog *log) {
+    arena_reset(&log->record_strings);
+    log->event_count = 0;
+    log->object_count = 0;
+    log->event_attribute_count = 0;
+    log->object_attribute_count = 0;
+    log->event_relationship_count = 0;
+    log->object_relationship_count = 0;
+}
+
+void free_ocel(OcelLog *log) {
+    free_types(log->event_types, log->event_type_count);
+    free_types(log->object_types, log->object_type_count);
+    free(log->event_type_index.slots);
+    free(log->object_type_index.slots);
+    arena_release(&log->type_strings);
+    arena_release(&log->record_strings);
+    free(log->events);
+    free(log->objects);
+    free(log->event_attributes);
+    free(log->object_attributes);
+    free(log->event_relationships);
+    free(log->object_relationships);
+    free(log);
+}
+
+/* Type index */
+
+static unsigned int hash_name(const char *s) {
+    unsigned int h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int find_type(const OcelType *types, const OcelTypeIndex *index, const char *name) {
+    if (index->slot_capacity == 0) return -1;
+    unsigned int mask = (unsigned int)index->slot_capacity - 1;
+    unsigned int slot = hash_name(name) & mask;
+    while (index->slots[slot] >= 0) {
+        if (strcmp(types[index->slots[slot]].name, name) == 0) return index->slots[slot];
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+static void insert_type(const OcelType *types, OcelTypeIndex *index, int id) {
+    unsigned int mask = (unsigned int)index->slot_capacity - 1;
+    unsigned int slot = hash_name(types[id].name) & mask;
+    while (index->slots[slot] >= 0) slot = (slot + 1) & mask;
+    index->slots[slot] = id;
+}
+
+/* Add the last of count types to the index, growing it to keep the load factor below 1/2 */
+static void index_type(const OcelType *types, int count, OcelTypeIndex *index) {
+    if (count * 2 > index->slot_capacity) {
+        free(index->slots);
+        index->slot_capacity = index->slot_capacity ? index->slot_capacity * 2 : INITIAL_CAPACITY * 2;
+        index->slots = (int *)malloc(sizeof(int) * index->slot_capacity);
+        for (int i = 0; i < index->slot_capacity; i++) index->slots[i] = -1;
+        for (int i = 0; i < count - 1; i++) insert_type(types, index, i);
+    }
+    insert_type(types, index, count - 1);
+}
+
+static int add_type(OcelLog *log, OcelType **types, int *count, int *capacity, OcelTypeIndex *index, const char *name) {
+    int id = find_type(*types, index, name ? name : "");
+    if (id >= 0) return id;
+    GROW(*types, *count, *capacity);
+    id = (*count)++;
+    OcelType *type = &(*types)[id];
+    type->name = copy_string(&log->type_strings, name);
+    type->attributes = NULL;
+    type->attribute_count = 0;
+    type->attribute_capacity = 0;
+    index_type(*types, *count, index);
+    return id;
+}
+
+int add_ocel_event_type(OcelLog *log, const char *name) {
+    return add_type(log, &log->event_types, &log->event_type_count, &log->event_type_capacity, &log->event_type_index, name);
+}
+
+int add_ocel_object_type(OcelLog *log, const char *name) {
+    return add_type(log, &log->object_types, &log->object_type_count, &log->object_type_capacity, &log->object_type_index, name);
+}
+
+int find_ocel_event_type(const OcelLog *log, const char *name) {
+    return find_type(log->event_types, &log->event_type_index, name);
+}
+
+int find_ocel_object_type(const OcelLog *log, const char *name) {
+    return find_type(log->object_types, &log->object_type_index, name);
+}
+
+void add_ocel_type_attribute(OcelLog *log, OcelType *type, const char *name, const char *value_type) {
+    GROW(type->attributes, type->attribute_count, type->attribute_capacity);
+    OcelAttributeDef *a = &type->attributes[type->attribute_count++];
+    a->name = copy_string(&log->type_strings, name);
+    a->type = copy_string(&log->type_strings, value_type);
+}
+
+/* Records */
+
+int add_ocel_event(OcelLog *log, const char *id, const char *type, const char *time) {
+    int type_id = add_ocel_event_type(log, type);
+    GROW(log->events, log->event_count, log->event_capacity);
+    OcelEvent *e = &log->events[log->event_count];
+    e->id = copy_string(&log->record_strings, id);
+    e->type = type_id;
+    e->time = copy_string(&log->record_strings, time);
+    e->timestamp = parse_timestamp_string(e->time);
+    e->first_attribute = log->event_attribute_count;
+    e->attribute_count = 0;
+    e->first_relationship = log->event_relationship_count;
+    e->relationship_count = 0;
+    return log->event_count++;
+}
+
+void add_ocel_event_attribute(OcelLog *log, const char *name, const char *value) {
+    GROW(log->event_attributes, log->event_attribute_count, log->event_attribute_capacity);
+    OcelAttribute *a = &log->event_attributes[log->event_attribute_count++];
+    a->name = copy_string(&log->record_strings, name);
+    a->value = copy_string(&log->record_strings, value);
+    a->time = NULL;
+    a->timestamp = TIMESTAMP_NONE;
+    log->events[log->event_count - 1].attribute_count++;
+}
+
+void add_ocel_event_relationship(OcelLog *log, const char *object_id, const char *qualifier) {
+    GROW(log->event_relationships, log->event_relationship_count, log->event_relationship_capacity);
+    OcelRelationship *r = &log->event_relationships[log->event_relationship_count++];
+    r->object_id = copy_string(&log->record_strings, object_id);
+    r->qualifier = copy_string(&log->record_strings, qualifier);
+    log->events[log->event_count - 1].relationship_count++;
+}
+
+int add_ocel_object(OcelLog *log, const char *id, const char *type) {
+    int type_id = add_ocel_object_type(log, type);
+    GROW(log->objects, log->object_count, log->object_capacity);
+    OcelObject *o = &log->objects[log->object_count];
+    o->id = copy_string(&log->record_strings, id);
+    o->type = type_id;
+    o->first_attribute = log->object_attribute_count;
+    o->attribute_count = 0;
+    o->first_relationship = log->object_relationship_count;
+    o->relationship_count = 0;
+    return log->object_count++;
+}
+
+void add_ocel_object_attribute(OcelLog *log, const char *name, const char *value, const char *time) {
+    GROW(log->object_attributes, log->object_attribute_count, log->object_attribute_capacity);
+    OcelAttribute *a = &log->object_attributes[log->object_attribute_count++];
+    a->name = copy_string(&log->record_strings, name);
+    a->value = copy_string(&log->record_strings, value);
+    a->time = copy_string(&log->record_strings, time);
+    a->timestamp = parse_timestamp_string(a->time);
+    log->objects[log->object_count - 1].attribute_count++;
+}
+
+void add_ocel_object_relationship(OcelLog *log, const char *object_id, const char *qualifier) {
+    GROW(log->object_relationships, log->object_relationship_count, log->object_relationship_capacity);
+    OcelRelationship *r = &log->object_relationships[log->object_relationship_count++];
+    r->object_id = copy_string(&log->record_strings, object_id);
+    r->qualifier = copy_string(&log->record_strings, qualifier);
+    log->objects[log->object_count - 1].relationship_count++;
+}
+
+void end_ocel_record(OcelLog *log, OcelSection section) {
+    if (!log->record_handler) return;
+    int index = section == OCEL_EVENTS ? log->event_count - 1 : log->object_count - 1;
+    log->record_handler(log, section, index, log->record_context);
+    clear_ocel_records(log);
+}
+
+/* Writer */
+
+int open_ocel_writer(OcelWriter *writer, const OcelFormat *format, const char *filename) {
+    memset(writer, 0, sizeof(*writer));
+    writer->format = format;
+    writer->file = fopen(filename, "w");
+    if (!writer->file) {
+        fprintf(stderr, "Failed to open file %s for writing\n", filename);
+        return -1;
+    }
+    format->begin_log(writer->file);
+    return 0;
+}
+
+static void close_section(OcelWriter *writer) {
+    if (!writer->section_open) return;
+    writer->format->end_section(writer->file, writer->section, writer->section_records);
+    writer->section_open = 0;
+}
+
+static void open_section(OcelWriter *writer, OcelSection section) {
+    int index = 0;
+    close_section(writer);
+    for (int s = OCEL_OBJECT_TYPES; s <= OCEL_EVENTS; s++) index += (writer->sections_written >> s) & 1;
+    writer->format->begin_section(writer->file, section, index);
+    writer->sections_written |= 1 << section;
+    writer->section = section;
+    writer->section_open = 1;
+    writer->section_records = 0;
+}
+
+/* Write both type sections once, before the first record */
+static void write_type_sections(OcelWriter *writer, const OcelLog *log) {
+    if (writer->sections_written & (1 << OCEL_OBJECT_TYPES)) return;
+    open_section(writer, OCEL_OBJECT_TYPES);
+    for (int i = 0; i < log->object_type_count; i++) {
+        writer->format->write_record(writer->file, log, OCEL_OBJECT_TYPES, i, writer->section_records++);
+    }
+    open_section(writer, OCEL_EVENT_TYPES);
+    for (int i = 0; i < log->event_type_count; i++) {
+        writer->format->write_record(writer->file, log, OCEL_EVENT_TYPES, i, writer->section_records++);
+    }
+    close_section(writer);
+    writer->object_types_written = log->object_type_count;
+    writer->event_types_written = log->event_type_count;
+}
+
+void write_ocel_record(OcelWriter *writer, const OcelLog *log, OcelSection section, int i) {
+    write_type_sections(writer, log);
+    if (!writer->section_open || writer->section != section) open_section(writer, section);
+    writer->format->write_record(writer->file, log, section, i, writer->section_records++);
+    writer->records++;
+}
+
+void write_ocel_records(OcelWriter *writer, const OcelLog *log) {
+    for (int i = 0; i < log->object_count; i++) write_ocel_record(writer, log, OCEL_OBJECTS, i);
+    for (int i = 0; i < log->event_count; i++) write_ocel_record(writer, log, OCEL_EVENTS, i);
+}
+
+int close_ocel_writer(OcelWriter *writer, const OcelLog *log, const char *filename) {
+    write_type_sections(writer, log);
+    close_section(writer);
+    for (int s = OCEL_OBJECTS; s <= OCEL_EVENTS; s++) {
+        if (writer->sections_written & (1 << s)) continue;
+        open_section(writer, (OcelSection)s);
+        close_section(writer);
+    }
+    writer->format->end_log(writer->file);
+
+    int late_types = log->object_type_count - writer->object_types_written +
+                     log->event_type_count - writer->event_types_written;
+    if (late_types > 0) {
+        fprintf(stderr, "Warning: %d types declared after the first record were not written to %s\n",
+                late_types, filename);
+    }
+
+    writer->bytes = ftell(writer->file);
+    int status = ferror(writer->file) ? -1 : 0;
+    if (fclose(writer->file) != 0) status = -1;
+    writer->file = NULL;
+    if (status != 0) fprintf(stderr, "Failed to write file %s\n", filename);
+    return status;
+}
+
+void stream_ocel_record(OcelLog *log, OcelSection section, int index, void *writer) {
+    write_ocel_record((OcelWriter *)writer, log, section, index);
+}
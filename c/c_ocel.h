@@ -0,0 +1,204 @@
+/*
+ * OCEL 2.0 object-centric event log - shared in-memory model
+ *
+ * One model for the JSON (c_ocel20_json.c) and XML (c_ocel20_xml.c) importers
+ * and exporters, implemented in c_ocel.c. All state lives in the OcelLog, so
+ * several logs can be processed independently. Strings are owned by the log,
+ * in two arenas (c_arena.h): one for the types and one for the records, which
+ * is emptied with the records; there are no size limits besides memory.
+ *
+ * The attributes and relationships of events and of objects are stored in
+ * separate pools; the ones of a record are contiguous (first_* / *_count),
+ * since they are always added to the last record (add_ocel_event_* and
+ * add_ocel_object_*). The times of events and object attributes are kept as
+ * given and also parsed once, when the record is added, into 64-bit
+ * milliseconds since the epoch (timestamp), for sorting and time queries.
+ *
+ * Streaming: with a record handler set, the importers hand over every event and
+ * object as soon as it is complete (end_ocel_record), after which it is removed
+ * from the log. Together with an OcelWriter as the handler, a conversion keeps
+ * only the types and the current record in memory.
+ */
+
+#ifndef C_OCEL_H
+#define C_OCEL_H
+
+#include <stdio.h>
+
+#include "c_arena.h"
+
+typedef struct {
+    char *name;
+    char *type;         /* string, integer, float, boolean, time */
+} OcelAttributeDef;
+
+/* Event type or object type */
+typedef struct {
+    char *name;
+    OcelAttributeDef *attributes;
+    int attribute_count;
+    int attribute_capacity;
+} OcelType;
+
+/* Attribute value of an event or an object */
+typedef struct {
+    char *name;
+    char *value;
+    char *time;         /* objects: time of the value; events: NULL */
+    long long timestamp;    /* time parsed at load (c_timestamp.h); events: TIMESTAMP_NONE */
+} OcelAttribute;
+
+/* Qualified relationship to an object (E2O for events, O2O for objects) */
+typedef struct {
+    char *object_id;
+    char *qualifier;
+} OcelRelationship;
+
+typedef struct {
+    char *id;
+    int type;           /* index into OcelLog.event_types */
+    char *time;
+    long long timestamp;    /* time parsed at load (c_timestamp.h) */
+    int first_attribute;
+    int attribute_count;
+    int first_relationship;
+    int relationship_count;
+} OcelEvent;
+
+typedef struct {
+    char *id;
+    int type;           /* index into OcelLog.object_types */
+    int first_attribute;
+    int attribute_count;
+    int first_relationship;
+    int relationship_count;
+} OcelObject;
+
+/* Types by name: open-addressing hash table of type indices, -1 if empty */
+typedef struct {
+    int *slots;
+    int slot_capacity;  /* power of two */
+} OcelTypeIndex;
+
+/* Sections of a log, in the order of the standard */
+typedef enum { OCEL_OBJECT_TYPES, OCEL_EVENT_TYPES, OCEL_OBJECTS, OCEL_EVENTS } OcelSection;
+
+typedef struct OcelLog OcelLog;
+
+/* Called with OCEL_OBJECTS or OCEL_EVENTS and the index of the record just completed */
+typedef void (*OcelRecordHandler)(OcelLog *log, OcelSection section, int index, void *context);
+
+struct OcelLog {
+    OcelType *event_types;
+    int event_type_count;
+    int event_type_capacity;
+    OcelTypeIndex event_type_index;
+
+    OcelType *object_types;
+    int object_type_count;
+    int object_type_capacity;
+    OcelTypeIndex object_type_index;
+
+    OcelEvent *events;
+    int event_count;
+    int event_capacity;
+    OcelAttribute *event_attributes;
+    int event_attribute_count;
+    int event_attribute_capacity;
+    OcelRelationship *event_relationships;
+    int event_relationship_count;
+    int event_relationship_capacity;
+
+    OcelObject *objects;
+    int object_count;
+    int object_capacity;
+    OcelAttribute *object_attributes;
+    int object_attribute_count;
+    int object_attribute_capacity;
+    OcelRelationship *object_relationships;
+    int object_relationship_count;
+    int object_relationship_capacity;
+
+    OcelRecordHandler record_handler;   /* NULL: keep all records */
+    void *record_context;
+
+    Arena type_strings;         /* names of the types and their attributes */
+    Arena record_strings;       /* strings of the events, objects, attributes and relationships */
+};
+
+OcelLog *create_ocel(void);
+void free_ocel(OcelLog *log);
+
+/* Types are identified by name: adding an existing name returns its index */
+int add_ocel_event_type(OcelLog *log, const char *name);
+int add_ocel_object_type(OcelLog *log, const char *name);
+int find_ocel_event_type(const OcelLog *log, const char *name);
+int find_ocel_object_type(const OcelLog *log, const char *name);
+void add_ocel_type_attribute(OcelLog *log, OcelType *type, const char *name, const char *value_type);
+
+/* Records; the type is added if it was not declared. NULL strings are stored as "" */
+int add_ocel_event(OcelLog *log, const char *id, const char *type, const char *time);
+void add_ocel_event_attribute(OcelLog *log, const char *name, const char *value);
+void add_ocel_event_relationship(OcelLog *log, const char *object_id, const char *qualifier);
+int add_ocel_object(OcelLog *log, const char *id, const char *type);
+void add_ocel_object_attribute(OcelLog *log, const char *name, const char *value, const char *time);
+void add_ocel_object_relationship(OcelLog *log, const char *object_id, const char *qualifier);
+
+/* Called by the importers when the last event or object is complete */
+void end_ocel_record(OcelLog *log, OcelSection section);
+/* Remove all events and objects, keeping the types (and the capacities) */
+void clear_ocel_records(OcelLog *log);
+
+/*
+ * Serialization of a format: the writer calls begin/end_log once, begin/end_section
+ * around each section (index: number of sections written before it) and
+ * write_record for each type, object or event (index: records written before it
+ * in the section; i: its position in the log)
+ */
+typedef struct {
+    void (*begin_log)(FILE *file);
+    void (*end_log)(FILE *file);
+    void (*begin_section)(FILE *file, OcelSection section, int index);
+    void (*end_section)(FILE *file, OcelSection section, int records);
+    void (*write_record)(FILE *file, const OcelLog *log, OcelSection section, int i, int index);
+} OcelFormat;
+
+/*
+ * Writer of a log record by record. The types are written before the first
+ * object or event (or at the end), the sections of the records in the order
+ * the records come in; sections that never get a record are written empty.
+ */
+typedef struct {
+    FILE *file;
+    const OcelFormat *format;
+    OcelSection section;        /* open section */
+    int section_open;
+    int section_records;
+    int sections_written;       /* bit per OcelSection */
+    int object_types_written;   /* types written with the type sections */
+    int event_types_written;
+    long long records;          /* objects and events written */
+    long long bytes;            /* size of the file, set by close_ocel_writer */
+} OcelWriter;
+
+int open_ocel_writer(OcelWriter *writer, const OcelFormat *format, const char *filename);
+/* Write object or event i of log (section OCEL_OBJECTS or OCEL_EVENTS) */
+void write_ocel_record(OcelWriter *writer, const OcelLog *log, OcelSection section, int i);
+/* Write all objects and events of log */
+void write_ocel_records(OcelWriter *writer, const OcelLog *log);
+/* Finish the file: 0 on success, -1 on error (reported on stderr) */
+int close_ocel_writer(OcelWriter *writer, const OcelLog *log, const char *filename);
+/* Record handler writing each record to the OcelWriter given as context */
+void stream_ocel_record(OcelLog *log, OcelSection section, int index, void *writer);
+
+/* c_ocel20_json.c / c_ocel20_xml.c */
+extern const OcelFormat ocel_json_format;
+extern const OcelFormat ocel_xml_format;
+
+/* c_ocel20_json.c / c_ocel20_xml.c: 0 on success, -1 on error (reported on stderr) */
+int import_ocel_json(OcelLog *log, const char *filename);
+int export_ocel_json(const OcelLog *log, const char *filename);
+int import_ocel_xml(OcelLog *log, const char *filename);
+int export_ocel_xml(const OcelLog *log, const char *filename);
+
+#endif
@@ -2,9 +2,35 @@
  * OCEL 2.0 JSON Importer/Exporter
  *
  * This program implements importers and exporters for the Object-Centric Event Log (OCEL) 2.0
- * JSON standard in process mining.
+ * JSON standard in process mining, on the shared OCEL model of c_ocel.h.
  *
  * It is written in ANSI C without any dependencies.
+ *
+ * Build: cc -O2 -o c_ocel20_json c_ocel20_json.c c_ocel.c
+ * Compile with -DK_LIB to link it into another program without its main.
+ *
+ * **Main Components:**
+
+- **Parser:**
+  - The file is read in chunks into a sliding buffer. Before a type, event or object is parsed,
+    load_value makes sure the whole record is in the buffer (growing it if needed), so only the
+    current record has to fit in memory. Strings are unescaped in place and NUL-terminated
+    inside the buffer, so no fixed-size copies are made; the model copies what it keeps.
+    Unquoted values (numbers, booleans, null) are moved one byte to the left to make room for
+    their terminator.
+  - All parser state is in a JsonParser, so several files can be read concurrently.
+  - Keys may come in any order: the fields of a type, event or object are collected first and
+    the record is added to the model at its closing brace, then passed on with end_ocel_record
+    (see streaming in c_ocel.h). Unknown keys are skipped.
+  - Errors are reported on stderr with their byte offset and import_ocel_json returns -1.
+
+- **Exporter:**
+  - ocel_json_format writes the four top-level arrays in the layout of the standard, escaping
+    strings, one record at a time through an OcelWriter; export_ocel_json writes a whole log.
+
+- **Instrumentation:**
+  - Built with -DK_STATS and c_stats.c, the phases parse and export report their time, bytes,
+    records (events and objects) and allocations at exit (see c_stats.h).
  */
 
 #include <stdio.h>
@@ -12,1030 +38,611 @@
 #include <string.h>
 #include <ctype.h>
 
-/* Define maximum sizes */
-#define MAX_ATTRIBUTES       100
-#define MAX_RELATIONSHIPS    100
-#define MAX_EVENTS           1000
-#define MAX_EVENT_TYPES      100
-#define MAX_OBJECTS          1000
-#define MAX_OBJECT_TYPES     100
-#define BUFFER_SIZE          65536
-
-/* Data structures */
-
-typedef struct {
-    char name[256];
-    char type[64];   /* For EventType and ObjectType attributes */
-} TypeAttribute;
-
-typedef struct {
-    char name[256];
-    char value[256];
-    char time[64];   /* ISO format */
-} Attribute;
-
-typedef struct {
-    char objectId[256];
-    char qualifier[256];
-} Relationship;
-
-typedef struct {
-    char id[256];
-    char type[256];
-    char time[64];
-    Attribute attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-    Relationship relationships[MAX_RELATIONSHIPS];
-    int relationship_count;
-} Event;
+#include "c_ocel.h"
+#include "c_stats.h"
 
-typedef struct {
-    char name[256];
-    TypeAttribute attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-} EventType;
+#define JSON_CHUNK_SIZE 65536
 
+/* Field collected while reading an attribute list or a relationship list */
 typedef struct {
-    char id[256];
-    char type[256];
-    Attribute attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-    Relationship relationships[MAX_RELATIONSHIPS];
-    int relationship_count;
-} Object;
+    char kind;          /* 'a': attribute (name, value, time), 't': type attribute (name, type),
+                           'r': relationship (objectId, qualifier) */
+    char *first;
+    char *second;
+    char *third;
+} JsonField;
 
 typedef struct {
-    char name[256];
-    TypeAttribute attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-} ObjectType;
-
-/* Global arrays */
-Event events[MAX_EVENTS];
-int event_count = 0;
-
-EventType eventTypes[MAX_EVENT_TYPES];
-int eventType_count = 0;
-
-Object objects[MAX_OBJECTS];
-int object_count = 0;
-
-ObjectType objectTypes[MAX_OBJECT_TYPES];
-int objectType_count = 0;
+    FILE *file;
+    char *start;            /* buffer */
+    char *ptr;
+    char *end;              /* end of the data in the buffer (NUL) */
+    size_t capacity;
+    long long offset;       /* file offset of start */
+    int eof;
+    int error;
+    long long records;      /* events and objects read */
+    JsonField *fields;
+    int field_count;
+    int field_capacity;
+} JsonParser;
 
 /* Function prototypes */
-void read_ocel(const char* filename);
-void write_ocel(const char* filename);
-
-/* Simple JSON parsing functions */
-char* read_file(const char* filename);
-char* skip_whitespace(char* ptr);
-char* parse_string(char* ptr, char* buffer);
-char* parse_array(char* ptr, char** endptr);
-char* parse_object(char* ptr, char** endptr);
-char* parse_value(char* ptr, char* buffer);
+int import_ocel_json(OcelLog *log, const char *filename);
+int export_ocel_json(const OcelLog *log, const char *filename);
 
-/* Parsing functions for specific structures */
-char* parse_event_types(char* ptr);
-char* parse_object_types(char* ptr);
-char* parse_events(char* ptr);
-char* parse_objects(char* ptr);
-
-/* Main function */
+/* Main function (left out with -DK_LIB, e.g. when compiled into c_bench.c) */
+#ifndef K_LIB
 int main(int argc, char* argv[]) {
     if (argc < 3) {
         printf("Usage: %s <input.json> <output.json>\n", argv[0]);
         return 1;
     }
 
-    read_ocel(argv[1]);
-    write_ocel(argv[2]);
+    OcelLog *log = create_ocel();
+    int status = import_ocel_json(log, argv[1]) == 0 && export_ocel_json(log, argv[2]) == 0 ? 0 : 1;
+    free_ocel(log);
 
-    return 0;
+    return status;
 }
+#endif
 
-/* Function implementations */
+/* Tokenizer */
 
-void read_ocel(const char* filename) {
-    char* json = read_file(filename);
-    if (!json) {
-        fprintf(stderr, "Failed to read file %s\n", filename);
-        exit(1);
+static void fail(JsonParser *p, const char *message) {
+    if (!p->error) {
+        fprintf(stderr, "OCEL JSON: %s at offset %lld\n", message, p->offset + (long long)(p->ptr - p->start));
+        p->error = 1;
     }
+}
 
-    char* ptr = json;
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '{') {
-        fprintf(stderr, "Expected '{' at the beginning of JSON\n");
-        free(json);
-        exit(1);
+/* Move the unparsed data to the front of the buffer and read more; 0 at the end of the file */
+static int refill(JsonParser *p) {
+    if (p->eof) return 0;
+    size_t kept = (size_t)(p->end - p->ptr);
+    if (p->ptr > p->start) {
+        memmove(p->start, p->ptr, kept);
+        p->offset += p->ptr - p->start;
     }
-    ptr++;
-
-    while (*ptr) {
-        ptr = skip_whitespace(ptr);
-        if (*ptr == '}') {
-            break;
-        }
-        char key[256];
-        ptr = parse_string(ptr, key);
-        ptr = skip_whitespace(ptr);
-        if (*ptr != ':') {
-            fprintf(stderr, "Expected ':' after key %s\n", key);
-            free(json);
-            exit(1);
-        }
-        ptr++;
-
-        ptr = skip_whitespace(ptr);
-        if (strcmp(key, "eventTypes") == 0) {
-            ptr = parse_event_types(ptr);
-        } else if (strcmp(key, "objectTypes") == 0) {
-            ptr = parse_object_types(ptr);
-        } else if (strcmp(key, "events") == 0) {
-            ptr = parse_events(ptr);
-        } else if (strcmp(key, "objects") == 0) {
-            ptr = parse_objects(ptr);
-        } else {
-            fprintf(stderr, "Unknown key: %s\n", key);
-            free(json);
-            exit(1);
-        }
-
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ',') {
-            ptr++;
-            continue;
-        } else if (*ptr == '}') {
-            break;
-        } else {
-            fprintf(stderr, "Expected ',' or '}' in JSON\n");
-            free(json);
-            exit(1);
-        }
+    if (p->capacity - kept < JSON_CHUNK_SIZE) {
+        p->capacity = p->capacity * 2 > kept + JSON_CHUNK_SIZE ? p->capacity * 2 : kept + JSON_CHUNK_SIZE;
+        p->start = (char *)realloc(p->start, p->capacity + 1);
     }
-
-    free(json);
+    p->ptr = p->start;
+    p->end = p->start + kept;
+    size_t n = fread(p->end, 1, p->capacity - kept, p->file);
+    p->end += n;
+    *p->end = '\0';
+    if (n == 0) p->eof = 1;
+    return n > 0;
 }
 
-void write_ocel(const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
-        fprintf(stderr, "Failed to open file %s for writing\n", filename);
-        exit(1);
+/* Skip whitespace, refilling at the end of the buffer (never inside a loaded value) */
+static void skip_whitespace(JsonParser *p) {
+    for (;;) {
+        while (isspace((unsigned char)*p->ptr)) p->ptr++;
+        if (p->ptr < p->end || !refill(p)) return;
     }
+}
 
-    fprintf(file, "{\n");
-
-    /* Write objectTypes */
-    fprintf(file, "  \"objectTypes\": [\n");
-    for (int i = 0; i < objectType_count; i++) {
-        fprintf(file, "    {\n");
-        fprintf(file, "      \"name\": \"%s\",\n", objectTypes[i].name);
-        fprintf(file, "      \"attributes\": [\n");
-        for (int j = 0; j < objectTypes[i].attribute_count; j++) {
-            fprintf(file, "        {\n");
-            fprintf(file, "          \"name\": \"%s\",\n", objectTypes[i].attributes[j].name);
-            fprintf(file, "          \"type\": \"%s\"\n", objectTypes[i].attributes[j].type);
-            fprintf(file, "        }");
-            if (j < objectTypes[i].attribute_count - 1) {
-                fprintf(file, ",");
+/*
+ * Make sure the whole value at ptr (after whitespace) is in the buffer, refilling as needed:
+ * the pointers into the buffer taken while parsing it stay valid until the next load_value
+ */
+static int load_value(JsonParser *p) {
+    skip_whitespace(p);
+    size_t i = 0;
+    int depth = 0, in_string = 0;
+    for (;;) {
+        for (; p->ptr + i < p->end; i++) {
+            char c = p->ptr[i];
+            if (in_string) {
+                if (c == '\\') {
+                    i++;
+                } else if (c == '"') {
+                    in_string = 0;
+                    if (depth == 0) return 1;
+                }
+            } else if (c == '"') {
+                in_string = 1;
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth <= 0) return 1;
+            } else if (depth == 0 && (c == ',' || isspace((unsigned char)c))) {
+                return 1;
             }
-            fprintf(file, "\n");
-        }
-        fprintf(file, "      ]\n");
-        fprintf(file, "    }");
-        if (i < objectType_count - 1) {
-            fprintf(file, ",");
         }
-        fprintf(file, "\n");
+        if (!refill(p)) break;
     }
-    fprintf(file, "  ],\n");
+    if (depth == 0 && !in_string && i > 0) return 1;
+    fail(p, "unexpected end of input");
+    return 0;
+}
 
-    /* Write eventTypes */
-    fprintf(file, "  \"eventTypes\": [\n");
-    for (int i = 0; i < eventType_count; i++) {
-        fprintf(file, "    {\n");
-        fprintf(file, "      \"name\": \"%s\",\n", eventTypes[i].name);
-        fprintf(file, "      \"attributes\": [\n");
-        for (int j = 0; j < eventTypes[i].attribute_count; j++) {
-            fprintf(file, "        {\n");
-            fprintf(file, "          \"name\": \"%s\",\n", eventTypes[i].attributes[j].name);
-            fprintf(file, "          \"type\": \"%s\"\n", eventTypes[i].attributes[j].type);
-            fprintf(file, "        }");
-            if (j < eventTypes[i].attribute_count - 1) {
-                fprintf(file, ",");
-            }
-            fprintf(file, "\n");
-        }
-        fprintf(file, "      ]\n");
-        fprintf(file, "    }");
-        if (i < eventType_count - 1) {
-            fprintf(file, ",");
-        }
-        fprintf(file, "\n");
+static int expect(JsonParser *p, char c) {
+    skip_whitespace(p);
+    if (*p->ptr != c) {
+        char message[32];
+        snprintf(message, sizeof(message), "expected '%c'", c);
+        fail(p, message);
+        return 0;
     }
-    fprintf(file, "  ],\n");
+    p->ptr++;
+    return 1;
+}
 
-    /* Write objects */
-    fprintf(file, "  \"objects\": [\n");
-    for (int i = 0; i < object_count; i++) {
-        fprintf(file, "    {\n");
-        fprintf(file, "      \"id\": \"%s\",\n", objects[i].id);
-        fprintf(file, "      \"type\": \"%s\"", objects[i].type);
-        if (objects[i].attribute_count > 0) {
-            fprintf(file, ",\n      \"attributes\": [\n");
-            for (int j = 0; j < objects[i].attribute_count; j++) {
-                fprintf(file, "        {\n");
-                fprintf(file, "          \"name\": \"%s\",\n", objects[i].attributes[j].name);
-                fprintf(file, "          \"time\": \"%s\",\n", objects[i].attributes[j].time);
-                fprintf(file, "          \"value\": \"%s\"\n", objects[i].attributes[j].value);
-                fprintf(file, "        }");
-                if (j < objects[i].attribute_count - 1) {
-                    fprintf(file, ",");
-                }
-                fprintf(file, "\n");
-            }
-            fprintf(file, "      ]");
-        }
-        if (objects[i].relationship_count > 0) {
-            if (objects[i].attribute_count > 0) {
-                fprintf(file, ",");
-            }
-            fprintf(file, "\n      \"relationships\": [\n");
-            for (int j = 0; j < objects[i].relationship_count; j++) {
-                fprintf(file, "        {\n");
-                fprintf(file, "          \"objectId\": \"%s\",\n", objects[i].relationships[j].objectId);
-                fprintf(file, "          \"qualifier\": \"%s\"\n", objects[i].relationships[j].qualifier);
-                fprintf(file, "        }");
-                if (j < objects[i].relationship_count - 1) {
-                    fprintf(file, ",");
-                }
-                fprintf(file, "\n");
-            }
-            fprintf(file, "      ]");
-        }
-        fprintf(file, "\n    }");
-        if (i < object_count - 1) {
-            fprintf(file, ",");
-        }
-        fprintf(file, "\n");
+/* Encode the code point cp as UTF-8 at out, returning the number of bytes */
+static int encode_utf8(char *out, unsigned int cp) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
     }
-    fprintf(file, "  ],\n");
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
 
-    /* Write events */
-    fprintf(file, "  \"events\": [\n");
-    for (int i = 0; i < event_count; i++) {
-        fprintf(file, "    {\n");
-        fprintf(file, "      \"id\": \"%s\",\n", events[i].id);
-        fprintf(file, "      \"type\": \"%s\",\n", events[i].type);
-        fprintf(file, "      \"time\": \"%s\"", events[i].time);
-        if (events[i].attribute_count > 0) {
-            fprintf(file, ",\n      \"attributes\": [\n");
-            for (int j = 0; j < events[i].attribute_count; j++) {
-                fprintf(file, "        {\n");
-                fprintf(file, "          \"name\": \"%s\",\n", events[i].attributes[j].name);
-                fprintf(file, "          \"value\": \"%s\"\n", events[i].attributes[j].value);
-                fprintf(file, "        }");
-                if (j < events[i].attribute_count - 1) {
-                    fprintf(file, ",");
-                }
-                fprintf(file, "\n");
-            }
-            fprintf(file, "      ]");
+static int parse_hex4(const char *s, unsigned int *cp) {
+    *cp = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = s[i];
+        *cp <<= 4;
+        if (c >= '0' && c <= '9') *cp |= (unsigned int)(c - '0');
+        else if (c >= 'a' && c <= 'f') *cp |= (unsigned int)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') *cp |= (unsigned int)(c - 'A' + 10);
+        else return 0;
+    }
+    return 1;
+}
+
+/* Parse a string, unescaping it in place; returns it NUL-terminated inside the buffer */
+static char *parse_string(JsonParser *p) {
+    if (!expect(p, '"')) return NULL;
+    char *out = p->ptr;
+    char *result = out;
+    char *in = p->ptr;
+    while (*in && *in != '"') {
+        if (*in != '\\') {
+            *out++ = *in++;
+            continue;
         }
-        if (events[i].relationship_count > 0) {
-            if (events[i].attribute_count > 0) {
-                fprintf(file, ",");
+        in++;
+        switch (*in) {
+        case '"': case '\\': case '/': *out++ = *in; break;
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u': {
+            unsigned int cp;
+            if (!parse_hex4(in + 1, &cp)) {
+                p->ptr = in;
+                fail(p, "invalid \\u escape");
+                return NULL;
             }
-            fprintf(file, "\n      \"relationships\": [\n");
-            for (int j = 0; j < events[i].relationship_count; j++) {
-                fprintf(file, "        {\n");
-                fprintf(file, "          \"objectId\": \"%s\",\n", events[i].relationships[j].objectId);
-                fprintf(file, "          \"qualifier\": \"%s\"\n", events[i].relationships[j].qualifier);
-                fprintf(file, "        }");
-                if (j < events[i].relationship_count - 1) {
-                    fprintf(file, ",");
+            in += 4;
+            /* Surrogate pair */
+            if (cp >= 0xD800 && cp < 0xDC00 && in[1] == '\\' && in[2] == 'u') {
+                unsigned int low;
+                if (parse_hex4(in + 3, &low) && low >= 0xDC00 && low < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    in += 6;
                 }
-                fprintf(file, "\n");
             }
-            fprintf(file, "      ]");
+            /* The escape takes at least 6 bytes, the encoding at most 4 */
+            out += encode_utf8(out, cp);
+            break;
         }
-        fprintf(file, "\n    }");
-        if (i < event_count - 1) {
-            fprintf(file, ",");
+        default:
+            p->ptr = in;
+            fail(p, "unknown escape sequence");
+            return NULL;
         }
-        fprintf(file, "\n");
+        in++;
     }
-    fprintf(file, "  ]\n");
-
-    fprintf(file, "}\n");
-
-    fclose(file);
+    if (*in != '"') {
+        p->ptr = in;
+        fail(p, "unterminated string");
+        return NULL;
+    }
+    *out = '\0';
+    p->ptr = in + 1;
+    return result;
 }
 
-char* read_file(const char* filename) {
-    FILE* file = fopen(filename, "rb");
-    char* buffer;
-    long length;
-
-    if (!file) return NULL;
-
-    fseek(file, 0, SEEK_END);
-    length = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    buffer = (char*)malloc(length + 1);
-    if (!buffer) {
-        fclose(file);
+/* Parse a string or an unquoted value (number, true, false, null) */
+static char *parse_value(JsonParser *p) {
+    skip_whitespace(p);
+    if (*p->ptr == '"') return parse_string(p);
+    char *start = p->ptr;
+    while (*p->ptr && *p->ptr != ',' && *p->ptr != '}' && *p->ptr != ']' && !isspace((unsigned char)*p->ptr)) {
+        p->ptr++;
+    }
+    size_t len = (size_t)(p->ptr - start);
+    if (len == 0 || *start == '{' || *start == '[') {
+        fail(p, "expected a string or a scalar value");
         return NULL;
     }
+    /* The byte before the value (':', ',', '[' or whitespace) has been consumed: shift the
+       value onto it to terminate it without touching the delimiter that follows */
+    memmove(start - 1, start, len);
+    start[len - 1] = '\0';
+    return start - 1;
+}
 
-    if (fread(buffer, 1, length, file) != (size_t)length) {
-        fclose(file);
-        free(buffer);
-        return NULL;
+/* Skip any value (for unknown keys) */
+static void skip_value(JsonParser *p) {
+    skip_whitespace(p);
+    if (*p->ptr == '"') {
+        parse_string(p);
+        return;
+    }
+    if (*p->ptr != '{' && *p->ptr != '[') {
+        parse_value(p);
+        return;
     }
+    int depth = 0;
+    do {
+        if (*p->ptr == '"') {
+            if (!parse_string(p)) return;
+            continue;
+        }
+        if (*p->ptr == '{' || *p->ptr == '[') depth++;
+        else if (*p->ptr == '}' || *p->ptr == ']') depth--;
+        else if (!*p->ptr) {
+            fail(p, "unexpected end of input");
+            return;
+        }
+        p->ptr++;
+    } while (depth > 0);
+}
 
-    buffer[length] = '\0';  /* Null-terminate the string */
-    fclose(file);
-    return buffer;
+/*
+ * Iterate over the members of an array or object opened with expect(p, '[' or '{'):
+ * returns 1 while there is another member (after consuming the separating comma), 0 at the
+ * closing bracket (consumed) or on error. count must start at 0.
+ */
+static int next_member(JsonParser *p, char close, int *count) {
+    skip_whitespace(p);
+    if (*p->ptr == close) {
+        p->ptr++;
+        return 0;
+    }
+    if (*count > 0 && !expect(p, ',')) return 0;
+    if (p->error) return 0;
+    (*count)++;
+    return 1;
+}
+
+/* Parse "key": and return the key */
+static char *parse_key(JsonParser *p) {
+    char *key = parse_string(p);
+    if (!key || !expect(p, ':')) return NULL;
+    return key;
 }
 
-char* skip_whitespace(char* ptr) {
-    while (*ptr && isspace((unsigned char)*ptr)) {
-        ptr++;
+static void add_field(JsonParser *p, char kind, char *first, char *second, char *third) {
+    if (p->field_count >= p->field_capacity) {
+        p->field_capacity = p->field_capacity ? p->field_capacity * 2 : 16;
+        p->fields = (JsonField *)realloc(p->fields, sizeof(JsonField) * p->field_capacity);
     }
-    return ptr;
+    JsonField *f = &p->fields[p->field_count++];
+    f->kind = kind;
+    f->first = first;
+    f->second = second;
+    f->third = third;
 }
 
-char* parse_string(char* ptr, char* buffer) {
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '\"') {
-        fprintf(stderr, "Expected '\"' at beginning of string\n");
-        exit(1);
+/*
+ * Parse an array of flat objects into fields of the given kind; the keys of the three
+ * components are given (NULL if unused)
+ */
+static void parse_field_list(JsonParser *p, char kind, const char *key1, const char *key2, const char *key3) {
+    int count = 0;
+    if (!expect(p, '[')) return;
+    while (next_member(p, ']', &count)) {
+        char *values[3] = { NULL, NULL, NULL };
+        int members = 0;
+        if (!expect(p, '{')) return;
+        while (next_member(p, '}', &members)) {
+            char *key = parse_key(p);
+            if (!key) return;
+            if (strcmp(key, key1) == 0) values[0] = parse_value(p);
+            else if (key2 && strcmp(key, key2) == 0) values[1] = parse_value(p);
+            else if (key3 && strcmp(key, key3) == 0) values[2] = parse_value(p);
+            else skip_value(p);
+        }
+        if (p->error) return;
+        add_field(p, kind, values[0], values[1], values[2]);
     }
-    ptr++;
-    int i = 0;
-    while (*ptr && *ptr != '\"') {
-        if (*ptr == '\\') {
-            ptr++;
-            if (*ptr == '\"' || *ptr == '\\' || *ptr == '/') {
-                buffer[i++] = *ptr++;
-            } else if (*ptr == 'b') {
-                buffer[i++] = '\b';
-                ptr++;
-            } else if (*ptr == 'f') {
-                buffer[i++] = '\f';
-                ptr++;
-            } else if (*ptr == 'n') {
-                buffer[i++] = '\n';
-                ptr++;
-            } else if (*ptr == 'r') {
-                buffer[i++] = '\r';
-                ptr++;
-            } else if (*ptr == 't') {
-                buffer[i++] = '\t';
-                ptr++;
-            } else {
-                fprintf(stderr, "Unknown escape sequence\n");
-                exit(1);
-            }
-        } else {
-            buffer[i++] = *ptr++;
+}
+
+/* Parse the array of eventTypes (event_types = 1) or objectTypes */
+static void parse_types(JsonParser *p, OcelLog *log, int event_types) {
+    int count = 0;
+    if (!expect(p, '[')) return;
+    while (next_member(p, ']', &count)) {
+        char *name = NULL;
+        int members = 0;
+        p->field_count = 0;
+        if (!load_value(p) || !expect(p, '{')) return;
+        while (next_member(p, '}', &members)) {
+            char *key = parse_key(p);
+            if (!key) return;
+            if (strcmp(key, "name") == 0) name = parse_value(p);
+            else if (strcmp(key, "attributes") == 0) parse_field_list(p, 't', "name", "type", NULL);
+            else skip_value(p);
+        }
+        if (p->error) return;
+        int id = event_types ? add_ocel_event_type(log, name) : add_ocel_object_type(log, name);
+        OcelType *type = event_types ? &log->event_types[id] : &log->object_types[id];
+        for (int i = 0; i < p->field_count; i++) {
+            add_ocel_type_attribute(log, type, p->fields[i].first, p->fields[i].second);
         }
     }
-    buffer[i] = '\0';
-    if (*ptr != '\"') {
-        fprintf(stderr, "Expected '\"' at end of string\n");
-        exit(1);
+}
+
+/* Parse the array of events */
+static void parse_events(JsonParser *p, OcelLog *log) {
+    int count = 0;
+    if (!expect(p, '[')) return;
+    while (next_member(p, ']', &count)) {
+        char *id = NULL, *type = NULL, *time = NULL;
+        int members = 0;
+        p->field_count = 0;
+        if (!load_value(p) || !expect(p, '{')) return;
+        while (next_member(p, '}', &members)) {
+            char *key = parse_key(p);
+            if (!key) return;
+            if (strcmp(key, "id") == 0) id = parse_value(p);
+            else if (strcmp(key, "type") == 0) type = parse_value(p);
+            else if (strcmp(key, "time") == 0) time = parse_value(p);
+            else if (strcmp(key, "attributes") == 0) parse_field_list(p, 'a', "name", "value", NULL);
+            else if (strcmp(key, "relationships") == 0) parse_field_list(p, 'r', "objectId", "qualifier", NULL);
+            else skip_value(p);
+        }
+        if (p->error) return;
+        add_ocel_event(log, id, type, time);
+        for (int i = 0; i < p->field_count; i++) {
+            const JsonField *f = &p->fields[i];
+            if (f->kind == 'a') add_ocel_event_attribute(log, f->first, f->second);
+            else add_ocel_event_relationship(log, f->first, f->second);
+        }
+        p->records++;
+        end_ocel_record(log, OCEL_EVENTS);
     }
-    ptr++;
-    return ptr;
 }
 
-char* parse_value(char* ptr, char* buffer) {
-    ptr = skip_whitespace(ptr);
-    if (*ptr == '\"') {
-        return parse_string(ptr, buffer);
-    } else {
-        int i = 0;
-        while (*ptr && *ptr != ',' && *ptr != '}' && *ptr != ']' && !isspace((unsigned char)*ptr)) {
-            buffer[i++] = *ptr++;
-        }
-        buffer[i] = '\0';
-        return ptr;
+/* Parse the array of objects */
+static void parse_objects(JsonParser *p, OcelLog *log) {
+    int count = 0;
+    if (!expect(p, '[')) return;
+    while (next_member(p, ']', &count)) {
+        char *id = NULL, *type = NULL;
+        int members = 0;
+        p->field_count = 0;
+        if (!load_value(p) || !expect(p, '{')) return;
+        while (next_member(p, '}', &members)) {
+            char *key = parse_key(p);
+            if (!key) return;
+            if (strcmp(key, "id") == 0) id = parse_value(p);
+            else if (strcmp(key, "type") == 0) type = parse_value(p);
+            else if (strcmp(key, "attributes") == 0) parse_field_list(p, 'a', "name", "value", "time");
+            else if (strcmp(key, "relationships") == 0) parse_field_list(p, 'r', "objectId", "qualifier", NULL);
+            else skip_value(p);
+        }
+        if (p->error) return;
+        add_ocel_object(log, id, type);
+        for (int i = 0; i < p->field_count; i++) {
+            const JsonField *f = &p->fields[i];
+            if (f->kind == 'a') add_ocel_object_attribute(log, f->first, f->second, f->third);
+            else add_ocel_object_relationship(log, f->first, f->second);
+        }
+        p->records++;
+        end_ocel_record(log, OCEL_OBJECTS);
     }
 }
 
-char* parse_array(char* ptr, char** endptr) {
-    int depth = 1;
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '[') {
-        fprintf(stderr, "Expected '[' at beginning of array\n");
-        exit(1);
+/* Read an OCEL 2.0 JSON file into log: 0 on success, -1 on error */
+int import_ocel_json(OcelLog *log, const char *filename) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to read file %s\n", filename);
+        return -1;
     }
-    ptr++;
-    while (*ptr) {
-        if (*ptr == '[') {
-            depth++;
-        } else if (*ptr == ']') {
-            depth--;
-            if (depth == 0) {
-                ptr++;
-                break;
-            }
+
+    K_STATS_BEGIN("parse");
+    JsonParser p;
+    memset(&p, 0, sizeof(p));
+    p.file = file;
+    refill(&p);
+
+    int count = 0;
+    if (expect(&p, '{')) {
+        while (next_member(&p, '}', &count)) {
+            /* The key does not outlive the refill that expect(':') may do */
+            if (!load_value(&p)) break;
+            char *key = parse_string(&p);
+            if (!key) break;
+            int section = strcmp(key, "objectTypes") == 0 ? OCEL_OBJECT_TYPES :
+                          strcmp(key, "eventTypes") == 0 ? OCEL_EVENT_TYPES :
+                          strcmp(key, "objects") == 0 ? OCEL_OBJECTS :
+                          strcmp(key, "events") == 0 ? OCEL_EVENTS : -1;
+            if (!expect(&p, ':')) break;
+            if (section == OCEL_EVENT_TYPES) parse_types(&p, log, 1);
+            else if (section == OCEL_OBJECT_TYPES) parse_types(&p, log, 0);
+            else if (section == OCEL_EVENTS) parse_events(&p, log);
+            else if (section == OCEL_OBJECTS) parse_objects(&p, log);
+            else if (load_value(&p)) skip_value(&p);
         }
-        ptr++;
     }
-    *endptr = ptr;
-    return ptr;
+    K_STATS_COUNT(p.offset + (p.end - p.start), p.records);
+    K_STATS_END();
+
+    free(p.fields);
+    free(p.start);
+    fclose(file);
+    return p.error ? -1 : 0;
 }
 
-char* parse_object(char* ptr, char** endptr) {
-    int depth = 1;
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '{') {
-        fprintf(stderr, "Expected '{' at beginning of object\n");
-        exit(1);
+/* Exporter */
+
+static void write_string(FILE *file, const char *s) {
+    const char *run = s;
+    fputc('"', file);
+    for (;; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c != '"' && c != '\\' && c >= 0x20) continue;
+        fwrite(run, 1, (size_t)(s - run), file);
+        if (!c) break;
+        switch (c) {
+        case '"': fputs("\\\"", file); break;
+        case '\\': fputs("\\\\", file); break;
+        case '\n': fputs("\\n", file); break;
+        case '\r': fputs("\\r", file); break;
+        case '\t': fputs("\\t", file); break;
+        default: fprintf(file, "\\u%04x", c); break;
+        }
+        run = s + 1;
     }
-    ptr++;
-    while (*ptr) {
-        if (*ptr == '{') {
-            depth++;
-        } else if (*ptr == '}') {
-            depth--;
-            if (depth == 0) {
-                ptr++;
-                break;
-            }
-        }
-        ptr++;
+    fputc('"', file);
+}
+
+/* Write indent "key": "value" followed by separator */
+static void write_field(FILE *file, const char *indent, const char *key, const char *value, const char *separator) {
+    fprintf(file, "%s\"%s\": ", indent, key);
+    write_string(file, value ? value : "");
+    fputs(separator, file);
+}
+
+static void write_type(FILE *file, const OcelType *type) {
+    fprintf(file, "    {\n");
+    write_field(file, "      ", "name", type->name, ",\n");
+    fprintf(file, "      \"attributes\": [\n");
+    for (int j = 0; j < type->attribute_count; j++) {
+        fprintf(file, "        {\n");
+        write_field(file, "          ", "name", type->attributes[j].name, ",\n");
+        write_field(file, "          ", "type", type->attributes[j].type, "\n");
+        fprintf(file, "        }%s\n", j < type->attribute_count - 1 ? "," : "");
     }
-    *endptr = ptr;
-    return ptr;
+    fprintf(file, "      ]\n");
+    fprintf(file, "    }");
 }
 
-/* Parsing eventTypes */
-char* parse_event_types(char* ptr) {
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '[') {
-        fprintf(stderr, "Expected '[' after \"eventTypes\"\n");
-        exit(1);
+static void write_relationships(FILE *file, const OcelRelationship *relationships, int count) {
+    fprintf(file, "      \"relationships\": [\n");
+    for (int j = 0; j < count; j++) {
+        fprintf(file, "        {\n");
+        write_field(file, "          ", "objectId", relationships[j].object_id, ",\n");
+        write_field(file, "          ", "qualifier", relationships[j].qualifier, "\n");
+        fprintf(file, "        }%s\n", j < count - 1 ? "," : "");
     }
-    ptr++;
-    while (*ptr) {
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ']') {
-            ptr++;
-            break;
-        }
-        if (*ptr != '{') {
-            fprintf(stderr, "Expected '{' at beginning of eventType object\n");
-            exit(1);
-        }
-        ptr++;
-        EventType et;
-        et.attribute_count = 0;
-        while (*ptr) {
-            ptr = skip_whitespace(ptr);
-            if (*ptr == '}') {
-                ptr++;
-                break;
-            }
-            char key[256];
-            ptr = parse_string(ptr, key);
-            ptr = skip_whitespace(ptr);
-            if (*ptr != ':') {
-                fprintf(stderr, "Expected ':' after key %s in eventType\n", key);
-                exit(1);
-            }
-            ptr++;
-            ptr = skip_whitespace(ptr);
-            if (strcmp(key, "name") == 0) {
-                char value[256];
-                ptr = parse_string(ptr, value);
-                strcpy(et.name, value);
-            } else if (strcmp(key, "attributes") == 0) {
-                if (*ptr != '[') {
-                    fprintf(stderr, "Expected '[' after \"attributes\" in eventType\n");
-                    exit(1);
-                }
-                ptr++;
-                while (*ptr) {
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ']') {
-                        ptr++;
-                        break;
-                    }
-                    if (*ptr != '{') {
-                        fprintf(stderr, "Expected '{' at beginning of attribute object in eventType\n");
-                        exit(1);
-                    }
-                    ptr++;
-                    TypeAttribute ta;
-                    while (*ptr) {
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == '}') {
-                            ptr++;
-                            break;
-                        }
-                        char akey[256];
-                        ptr = parse_string(ptr, akey);
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr != ':') {
-                            fprintf(stderr, "Expected ':' after key %s in attribute of eventType\n", akey);
-                            exit(1);
-                        }
-                        ptr++;
-                        ptr = skip_whitespace(ptr);
-                        char avalue[256];
-                        ptr = parse_string(ptr, avalue);
-                        if (strcmp(akey, "name") == 0) {
-                            strcpy(ta.name, avalue);
-                        } else if (strcmp(akey, "type") == 0) {
-                            strcpy(ta.type, avalue);
-                        }
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == ',') {
-                            ptr++;
-                            continue;
-                        }
-                    }
-                    et.attributes[et.attribute_count++] = ta;
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ',') {
-                        ptr++;
-                        continue;
-                    }
-                }
-            }
-            ptr = skip_whitespace(ptr);
-            if (*ptr == ',') {
-                ptr++;
-                continue;
-            }
-        }
-        eventTypes[eventType_count++] = et;
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ',') {
-            ptr++;
-            continue;
+    fprintf(file, "      ]");
+}
+
+static void write_object(FILE *file, const OcelLog *log, const OcelObject *o) {
+    fprintf(file, "    {\n");
+    write_field(file, "      ", "id", o->id, ",\n");
+    write_field(file, "      ", "type", log->object_types[o->type].name, "");
+    if (o->attribute_count > 0) {
+        fprintf(file, ",\n      \"attributes\": [\n");
+        for (int j = 0; j < o->attribute_count; j++) {
+            const OcelAttribute *a = &log->object_attributes[o->first_attribute + j];
+            fprintf(file, "        {\n");
+            write_field(file, "          ", "name", a->name, ",\n");
+            write_field(file, "          ", "time", a->time, ",\n");
+            write_field(file, "          ", "value", a->value, "\n");
+            fprintf(file, "        }%s\n", j < o->attribute_count - 1 ? "," : "");
         }
+        fprintf(file, "      ]");
+    }
+    if (o->relationship_count > 0) {
+        fprintf(file, ",\n");
+        write_relationships(file, log->object_relationships + o->first_relationship, o->relationship_count);
     }
-    return ptr;
+    fprintf(file, "\n    }");
 }
 
-/* Parsing objectTypes */
-char* parse_object_types(char* ptr) {
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '[') {
-        fprintf(stderr, "Expected '[' after \"objectTypes\"\n");
-        exit(1);
-    }
-    ptr++;
-    while (*ptr) {
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ']') {
-            ptr++;
-            break;
-        }
-        if (*ptr != '{') {
-            fprintf(stderr, "Expected '{' at beginning of objectType object\n");
-            exit(1);
-        }
-        ptr++;
-        ObjectType ot;
-        ot.attribute_count = 0;
-        while (*ptr) {
-            ptr = skip_whitespace(ptr);
-            if (*ptr == '}') {
-                ptr++;
-                break;
-            }
-            char key[256];
-            ptr = parse_string(ptr, key);
-            ptr = skip_whitespace(ptr);
-            if (*ptr != ':') {
-                fprintf(stderr, "Expected ':' after key %s in objectType\n", key);
-                exit(1);
-            }
-            ptr++;
-            ptr = skip_whitespace(ptr);
-            if (strcmp(key, "name") == 0) {
-                char value[256];
-                ptr = parse_string(ptr, value);
-                strcpy(ot.name, value);
-            } else if (strcmp(key, "attributes") == 0) {
-                if (*ptr != '[') {
-                    fprintf(stderr, "Expected '[' after \"attributes\" in objectType\n");
-                    exit(1);
-                }
-                ptr++;
-                while (*ptr) {
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ']') {
-                        ptr++;
-                        break;
-                    }
-                    if (*ptr != '{') {
-                        fprintf(stderr, "Expected '{' at beginning of attribute object in objectType\n");
-                        exit(1);
-                    }
-                    ptr++;
-                    TypeAttribute ta;
-                    while (*ptr) {
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == '}') {
-                            ptr++;
-                            break;
-                        }
-                        char akey[256];
-                        ptr = parse_string(ptr, akey);
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr != ':') {
-                            fprintf(stderr, "Expected ':' after key %s in attribute of objectType\n", akey);
-                            exit(1);
-                        }
-                        ptr++;
-                        ptr = skip_whitespace(ptr);
-                        char avalue[256];
-                        ptr = parse_string(ptr, avalue);
-                        if (strcmp(akey, "name") == 0) {
-                            strcpy(ta.name, avalue);
-                        } else if (strcmp(akey, "type") == 0) {
-                            strcpy(ta.type, avalue);
-                        }
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == ',') {
-                            ptr++;
-                            continue;
-                        }
-                    }
-                    ot.attributes[ot.attribute_count++] = ta;
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ',') {
-                        ptr++;
-                        continue;
-                    }
-                }
-            }
-            ptr = skip_whitespace(ptr);
-            if (*ptr == ',') {
-                ptr++;
-                continue;
-            }
-        }
-        objectTypes[objectType_count++] = ot;
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ',') {
-            ptr++;
-            continue;
+static void write_event(FILE *file, const OcelLog *log, const OcelEvent *e) {
+    fprintf(file, "    {\n");
+    write_field(file, "      ", "id", e->id, ",\n");
+    write_field(file, "      ", "type", log->event_types[e->type].name, ",\n");
+    write_field(file, "      ", "time", e->time, "");
+    if (e->attribute_count > 0) {
+        fprintf(file, ",\n      \"attributes\": [\n");
+        for (int j = 0; j < e->attribute_count; j++) {
+            const OcelAttribute *a = &log->event_attributes[e->first_attribute + j];
+            fprintf(file, "        {\n");
+            write_field(file, "          ", "name", a->name, ",\n");
+            write_field(file, "          ", "value", a->value, "\n");
+            fprintf(file, "        }%s\n", j < e->attribute_count - 1 ? "," : "");
         }
+        fprintf(file, "      ]");
+    }
+    if (e->relationship_count > 0) {
+        fprintf(file, ",\n");
+        write_relationships(file, log->event_relationships + e->first_relationship, e->relationship_count);
     }
-    return ptr;
+    fprintf(file, "\n    }");
 }
 
-/* Parsing events */
-char* parse_events(char* ptr) {
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '[') {
-        fprintf(stderr, "Expected '[' after \"events\"\n");
-        exit(1);
-    }
-    ptr++;
-    while (*ptr) {
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ']') {
-            ptr++;
-            break;
-        }
-        if (*ptr != '{') {
-            fprintf(stderr, "Expected '{' at beginning of event object\n");
-            exit(1);
-        }
-        ptr++;
-        Event e;
-        e.attribute_count = 0;
-        e.relationship_count = 0;
-        while (*ptr) {
-            ptr = skip_whitespace(ptr);
-            if (*ptr == '}') {
-                ptr++;
-                break;
-            }
-            char key[256];
-            ptr = parse_string(ptr, key);
-            ptr = skip_whitespace(ptr);
-            if (*ptr != ':') {
-                fprintf(stderr, "Expected ':' after key %s in event\n", key);
-                exit(1);
-            }
-            ptr++;
-            ptr = skip_whitespace(ptr);
-            if (strcmp(key, "id") == 0) {
-                char value[256];
-                ptr = parse_string(ptr, value);
-                strcpy(e.id, value);
-            } else if (strcmp(key, "type") == 0) {
-                char value[256];
-                ptr = parse_string(ptr, value);
-                strcpy(e.type, value);
-            } else if (strcmp(key, "time") == 0) {
-                char value[64];
-                ptr = parse_string(ptr, value);
-                strcpy(e.time, value);
-            } else if (strcmp(key, "attributes") == 0) {
-                if (*ptr != '[') {
-                    fprintf(stderr, "Expected '[' after \"attributes\" in event\n");
-                    exit(1);
-                }
-                ptr++;
-                while (*ptr) {
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ']') {
-                        ptr++;
-                        break;
-                    }
-                    if (*ptr != '{') {
-                        fprintf(stderr, "Expected '{' at beginning of attribute object in event\n");
-                        exit(1);
-                    }
-                    ptr++;
-                    Attribute a;
-                    while (*ptr) {
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == '}') {
-                            ptr++;
-                            break;
-                        }
-                        char akey[256];
-                        ptr = parse_string(ptr, akey);
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr != ':') {
-                            fprintf(stderr, "Expected ':' after key %s in attribute of event\n", akey);
-                            exit(1);
-                        }
-                        ptr++;
-                        ptr = skip_whitespace(ptr);
-                        char avalue[256];
-                        ptr = parse_string(ptr, avalue);
-                        if (strcmp(akey, "name") == 0) {
-                            strcpy(a.name, avalue);
-                        } else if (strcmp(akey, "value") == 0) {
-                            strcpy(a.value, avalue);
-                        }
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == ',') {
-                            ptr++;
-                            continue;
-                        }
-                    }
-                    e.attributes[e.attribute_count++] = a;
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ',') {
-                        ptr++;
-                        continue;
-                    }
-                }
-            } else if (strcmp(key, "relationships") == 0) {
-                if (*ptr != '[') {
-                    fprintf(stderr, "Expected '[' after \"relationships\" in event\n");
-                    exit(1);
-                }
-                ptr++;
-                while (*ptr) {
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ']') {
-                        ptr++;
-                        break;
-                    }
-                    if (*ptr != '{') {
-                        fprintf(stderr, "Expected '{' at beginning of relationship object in event\n");
-                        exit(1);
-                    }
-                    ptr++;
-                    Relationship r;
-                    while (*ptr) {
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == '}') {
-                            ptr++;
-                            break;
-                        }
-                        char rkey[256];
-                        ptr = parse_string(ptr, rkey);
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr != ':') {
-                            fprintf(stderr, "Expected ':' after key %s in relationship of event\n", rkey);
-                            exit(1);
-                        }
-                        ptr++;
-                        ptr = skip_whitespace(ptr);
-                        char rvalue[256];
-                        ptr = parse_string(ptr, rvalue);
-                        if (strcmp(rkey, "objectId") == 0) {
-                            strcpy(r.objectId, rvalue);
-                        } else if (strcmp(rkey, "qualifier") == 0) {
-                            strcpy(r.qualifier, rvalue);
-                        }
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == ',') {
-                            ptr++;
-                            continue;
-                        }
-                    }
-                    e.relationships[e.relationship_count++] = r;
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ',') {
-                        ptr++;
-                        continue;
-                    }
-                }
-            }
+static void json_begin_log(FILE *file) {
+    fprintf(file, "{\n");
+}
 
-            ptr = skip_whitespace(ptr);
-            if (*ptr == ',') {
-                ptr++;
-                continue;
-            }
-        }
-        events[event_count++] = e;
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ',') {
-            ptr++;
-            continue;
-        }
-    }
-    return ptr;
+static void json_end_log(FILE *file) {
+    fprintf(file, "\n}\n");
+}
+
+static void json_begin_section(FILE *file, OcelSection section, int index) {
+    static const char *keys[] = { "objectTypes", "eventTypes", "objects", "events" };
+    fprintf(file, "%s  \"%s\": [\n", index > 0 ? ",\n" : "", keys[section]);
 }
 
-/* Parsing objects */
-char* parse_objects(char* ptr) {
-    ptr = skip_whitespace(ptr);
-    if (*ptr != '[') {
-        fprintf(stderr, "Expected '[' after \"objects\"\n");
-        exit(1);
+static void json_end_section(FILE *file, OcelSection section, int records) {
+    (void)section;
+    fprintf(file, "%s  ]", records > 0 ? "\n" : "");
+}
+
+/* The records are separated by ",\n" and the last one is followed by "\n" (json_end_section) */
+static void json_write_record(FILE *file, const OcelLog *log, OcelSection section, int i, int index) {
+    if (index > 0) fprintf(file, ",\n");
+    switch (section) {
+    case OCEL_OBJECT_TYPES: write_type(file, &log->object_types[i]); break;
+    case OCEL_EVENT_TYPES: write_type(file, &log->event_types[i]); break;
+    case OCEL_OBJECTS: write_object(file, log, &log->objects[i]); break;
+    case OCEL_EVENTS: write_event(file, log, &log->events[i]); break;
     }
-    ptr++;
-    while (*ptr) {
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ']') {
-            ptr++;
-            break;
-        }
-        if (*ptr != '{') {
-            fprintf(stderr, "Expected '{' at beginning of object\n");
-            exit(1);
-        }
-        ptr++;
-        Object o;
-        o.attribute_count = 0;
-        o.relationship_count = 0;
-        while (*ptr) {
-            ptr = skip_whitespace(ptr);
-            if (*ptr == '}') {
-                ptr++;
-                break;
-            }
-            char key[256];
-            ptr = parse_string(ptr, key);
-            ptr = skip_whitespace(ptr);
-            if (*ptr != ':') {
-                fprintf(stderr, "Expected ':' after key %s in object\n", key);
-                exit(1);
-            }
-            ptr++;
-            ptr = skip_whitespace(ptr);
-            if (strcmp(key, "id") == 0) {
-                char value[256];
-                ptr = parse_string(ptr, value);
-                strcpy(o.id, value);
-            } else if (strcmp(key, "type") == 0) {
-                char value[256];
-                ptr = parse_string(ptr, value);
-                strcpy(o.type, value);
-            } else if (strcmp(key, "attributes") == 0) {
-                if (*ptr != '[') {
-                    fprintf(stderr, "Expected '[' after \"attributes\" in object\n");
-                    exit(1);
-                }
-                ptr++;
-                while (*ptr) {
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ']') {
-                        ptr++;
-                        break;
-                    }
-                    if (*ptr != '{') {
-                        fprintf(stderr, "Expected '{' at beginning of attribute object in object\n");
-                        exit(1);
-                    }
-                    ptr++;
-                    Attribute a;
-                    while (*ptr) {
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == '}') {
-                            ptr++;
-                            break;
-                        }
-                        char akey[256];
-                        ptr = parse_string(ptr, akey);
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr != ':') {
-                            fprintf(stderr, "Expected ':' after key %s in attribute of object\n", akey);
-                            exit(1);
-                        }
-                        ptr++;
-                        ptr = skip_whitespace(ptr);
-                        char avalue[256];
-                        ptr = parse_string(ptr, avalue);
-                        if (strcmp(akey, "name") == 0) {
-                            strcpy(a.name, avalue);
-                        } else if (strcmp(akey, "time") == 0) {
-                            strcpy(a.time, avalue);
-                        } else if (strcmp(akey, "value") == 0) {
-                            strcpy(a.value, avalue);
-                        }
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == ',') {
-                            ptr++;
-                            continue;
-                        }
-                    }
-                    o.attributes[o.attribute_count++] = a;
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ',') {
-                        ptr++;
-                        continue;
-                    }
-                }
-            } else if (strcmp(key, "relationships") == 0) {
-                if (*ptr != '[') {
-                    fprintf(stderr, "Expected '[' after \"relationships\" in object\n");
-                    exit(1);
-                }
-                ptr++;
-                while (*ptr) {
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ']') {
-                        ptr++;
-                        break;
-                    }
-                    if (*ptr != '{') {
-                        fprintf(stderr, "Expected '{' at beginning of relationship object in object\n");
-                        exit(1);
-                    }
-                    ptr++;
-                    Relationship r;
-                    while (*ptr) {
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == '}') {
-                            ptr++;
-                            break;
-                        }
-                        char rkey[256];
-                        ptr = parse_string(ptr, rkey);
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr != ':') {
-                            fprintf(stderr, "Expected ':' after key %s in relationship of object\n", rkey);
-                            exit(1);
-                        }
-                        ptr++;
-                        ptr = skip_whitespace(ptr);
-                        char rvalue[256];
-                        ptr = parse_string(ptr, rvalue);
-                        if (strcmp(rkey, "objectId") == 0) {
-                            strcpy(r.objectId, rvalue);
-                        } else if (strcmp(rkey, "qualifier") == 0) {
-                            strcpy(r.qualifier, rvalue);
-                        }
-                        ptr = skip_whitespace(ptr);
-                        if (*ptr == ',') {
-                            ptr++;
-                            continue;
-                        }
-                    }
-                    o.relationships[o.relationship_count++] = r;
-                    ptr = skip_whitespace(ptr);
-                    if (*ptr == ',') {
-                        ptr++;
-                        continue;
-                    }
-                }
-            }
+}
 
-            ptr = skip_whitespace(ptr);
-            if (*ptr == ',') {
-                ptr++;
-                continue;
-            }
-        }
-        objects[object_count++] = o;
-        ptr = skip_whitespace(ptr);
-        if (*ptr == ',') {
-            ptr++;
-            continue;
-        }
+const OcelFormat ocel_json_format = {
+    json_begin_log, json_end_log, json_begin_section, json_end_section, json_write_record
+};
+
+/* Write log as OCEL 2.0 JSON: 0 on success, -1 on error */
+int export_ocel_json(const OcelLog *log, const char *filename) {
+    OcelWriter writer;
+    K_STATS_BEGIN("export");
+    if (open_ocel_writer(&writer, &ocel_json_format, filename) != 0) {
+        K_STATS_END();
+        return -1;
     }
-    return ptr;
-}
\ No newline at end of file
+    write_ocel_records(&writer, log);
+    int status = close_ocel_writer(&writer, log, filename);
+    K_STATS_COUNT(writer.bytes, writer.records);
+    K_STATS_END();
+    return status;
+}
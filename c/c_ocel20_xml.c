@@ -1,457 +1,471 @@
+/*
+ * OCEL 2.0 XML Importer/Exporter
+ *
+ * This program implements importers and exporters for the Object-Centric Event Log (OCEL) 2.0
+ * XML standard in process mining, on the shared OCEL model of c_ocel.h.
+ *
+ * It is written in ANSI C without any dependencies.
+ *
+ * Build: cc -O2 -o c_ocel20_xml c_ocel20_xml.c c_ocel.c
+ * Compile with -DK_LIB to link it into another program without its main.
+ *
+ * **Main Components:**
+
+- **Tag scanner:**
+  - The file is read in chunks into a sliding buffer; every call to next_tag returns the next
+    start/end tag with its attributes and the character data before it (entities decoded in
+    place). Only the current element has to fit in the buffer, which grows if needed, so the
+    memory used by the scanner does not depend on the size of the file.
+  - Comments, processing instructions and declarations are skipped.
+
+- **Import:**
+  - A small state machine (section, record, list) maps the tags to the model: types and
+    records are added at their start tag, attributes and relationships to the last record, and
+    the record is passed on with end_ocel_record at its end tag (see streaming in c_ocel.h).
+  - All state is in the XmlReader, so several files can be read concurrently.
+
+- **Exporter:**
+  - ocel_xml_format writes object-types, event-types, objects and events, escaping attribute
+    values and text, one record at a time through an OcelWriter; export_ocel_xml writes a
+    whole log.
+
+- **Instrumentation:**
+  - Built with -DK_STATS and c_stats.c, the phases parse and export report their time, bytes,
+    records (events and objects) and allocations at exit (see c_stats.h), as in c_ocel20_json.c.
+ */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_LINE_LENGTH 4096
-#define MAX_NAME_LENGTH 256
-#define MAX_ATTRIBUTES 100
-#define MAX_OBJECTS 1000
-#define MAX_EVENTS 1000
-#define MAX_RELATIONSHIPS 1000
-
-typedef struct {
-    char name[MAX_NAME_LENGTH];
-    char type[MAX_NAME_LENGTH];
-} AttributeDef;
+#include "c_ocel.h"
+#include "c_xml.h"
+#include "c_stats.h"
 
-typedef struct {
-    char name[MAX_NAME_LENGTH];
-    AttributeDef attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-} ObjectType;
+#define XML_CHUNK_SIZE 65536
+#define XML_MAX_ATTRIBUTES 16
 
+/* Tag returned by next_tag; the strings point into the buffer and live until the next call */
 typedef struct {
-    char name[MAX_NAME_LENGTH];
-    AttributeDef attributes[MAX_ATTRIBUTES];
+    char *name;
+    int closing;            /* </name> */
+    int self_closing;       /* <name ... /> */
+    XmlAttribute attributes[XML_MAX_ATTRIBUTES];
     int attribute_count;
-} EventType;
-
-typedef struct {
-    char name[MAX_NAME_LENGTH];
-    char type[MAX_NAME_LENGTH];
-    char value[MAX_NAME_LENGTH];
-    char time[MAX_NAME_LENGTH];
-} ObjectAttribute;
+    char *text;             /* character data before the tag */
+} XmlTag;
 
 typedef struct {
-    char object_id[MAX_NAME_LENGTH];
-    char qualifier[MAX_NAME_LENGTH];
-} Relationship;
-
-typedef struct {
-    char id[MAX_NAME_LENGTH];
-    char type[MAX_NAME_LENGTH];
-    ObjectAttribute attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-    Relationship relationships[MAX_RELATIONSHIPS];
-    int relationship_count;
-} Object;
-
-typedef struct {
-    char id[MAX_NAME_LENGTH];
-    char type[MAX_NAME_LENGTH];
-    char time[MAX_NAME_LENGTH];
-    ObjectAttribute attributes[MAX_ATTRIBUTES];
-    int attribute_count;
-    Relationship relationships[MAX_RELATIONSHIPS];
-    int relationship_count;
-} Event;
-
-/* Global arrays to store parsed data */
-ObjectType object_types[MAX_OBJECTS];
-int object_type_count = 0;
-
-EventType event_types[MAX_EVENTS];
-int event_type_count = 0;
-
-Object objects[MAX_OBJECTS];
-int object_count = 0;
-
-Event events[MAX_EVENTS];
-int event_count = 0;
+    FILE *file;
+    char *buffer;
+    size_t length;          /* bytes in the buffer */
+    size_t capacity;
+    size_t pos;             /* start of the unscanned data */
+    int eof;
+    int error;
+    long long records;      /* events and objects read */
+} XmlReader;
 
 /* Function prototypes */
-void parse_file(const char *filename);
-void write_file(const char *filename);
-void parse_log(FILE *file);
-void parse_object_types(FILE *file);
-void parse_event_types(FILE *file);
-void parse_objects(FILE *file);
-void parse_events(FILE *file);
-void parse_attributes(FILE *file, AttributeDef *attributes, int *attribute_count);
-void parse_object_attributes(FILE *file, Object *obj);
-void parse_event_attributes(FILE *file, Event *event);
-void parse_relationships(FILE *file, Relationship *relationships, int *relationship_count, const char *end_tag);
-
-/* Main function */
+int import_ocel_xml(OcelLog *log, const char *filename);
+int export_ocel_xml(const OcelLog *log, const char *filename);
+
+/* Main function (left out with -DK_LIB, e.g. when compiled into c_bench.c) */
+#ifndef K_LIB
 int main(int argc, char *argv[]) {
     if (argc != 3) {
         printf("Usage: %s input_file.xml output_file.xml\n", argv[0]);
         return 1;
     }
 
-    parse_file(argv[1]);
-    write_file(argv[2]);
+    OcelLog *log = create_ocel();
+    int status = import_ocel_xml(log, argv[1]) == 0 && export_ocel_xml(log, argv[2]) == 0 ? 0 : 1;
+    free_ocel(log);
 
-    return 0;
+    return status;
 }
+#endif
 
-/* Function implementations */
+/* Tag scanner */
 
-void parse_file(const char *filename) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        printf("Error opening input file.\n");
-        exit(1);
+/* Move the unscanned data to the front of the buffer and read more; 0 at the end of the file */
+static int refill(XmlReader *r) {
+    if (r->eof) return 0;
+    if (r->pos > 0) {
+        memmove(r->buffer, r->buffer + r->pos, r->length - r->pos);
+        r->length -= r->pos;
+        r->pos = 0;
     }
-
-    parse_log(file);
-
-    fclose(file);
-}
-
-void write_file(const char *filename) {
-    FILE *file = fopen(filename, "w");
-    if (!file) {
-        printf("Error opening output file.\n");
-        exit(1);
+    if (r->capacity - r->length < XML_CHUNK_SIZE) {
+        r->capacity = r->capacity * 2 > r->length + XML_CHUNK_SIZE ? r->capacity * 2 : r->length + XML_CHUNK_SIZE;
+        r->buffer = (char *)realloc(r->buffer, r->capacity + 1);
     }
+    size_t n = fread(r->buffer + r->length, 1, r->capacity - r->length, r->file);
+    r->length += n;
+    r->buffer[r->length] = '\0';
+    if (n == 0) r->eof = 1;
+    return n > 0;
+}
 
-    fprintf(file, "<?xml version='1.0' encoding='UTF-8'?>\n");
-    fprintf(file, "<log>\n");
-
-    /* Write object-types */
-    fprintf(file, "  <object-types>\n");
-    for (int i = 0; i < object_type_count; i++) {
-        fprintf(file, "    <object-type name=\"%s\">\n", object_types[i].name);
-        fprintf(file, "      <attributes>\n");
-        for (int j = 0; j < object_types[i].attribute_count; j++) {
-            fprintf(file, "        <attribute name=\"%s\" type=\"%s\"/>\n",
-                    object_types[i].attributes[j].name,
-                    object_types[i].attributes[j].type);
-        }
-        fprintf(file, "      </attributes>\n");
-        fprintf(file, "    </object-type>\n");
-    }
-    fprintf(file, "  </object-types>\n");
-
-    /* Write event-types */
-    fprintf(file, "  <event-types>\n");
-    for (int i = 0; i < event_type_count; i++) {
-        fprintf(file, "    <event-type name=\"%s\">\n", event_types[i].name);
-        fprintf(file, "      <attributes>\n");
-        for (int j = 0; j < event_types[i].attribute_count; j++) {
-            fprintf(file, "        <attribute name=\"%s\" type=\"%s\"/>\n",
-                    event_types[i].attributes[j].name,
-                    event_types[i].attributes[j].type);
+/* Find the string s in the unscanned data from offset from, refilling as needed; -1 if absent */
+static long find_data(XmlReader *r, size_t from, const char *s) {
+    size_t len = strlen(s);
+    for (;;) {
+        for (size_t i = r->pos + from; i + len <= r->length; i++) {
+            if (r->buffer[i] == s[0] && memcmp(r->buffer + i, s, len) == 0) return (long)(i - r->pos);
         }
-        fprintf(file, "      </attributes>\n");
-        fprintf(file, "    </event-type>\n");
+        size_t scanned = r->length - r->pos;
+        from = scanned >= len ? scanned - len + 1 : 0;
+        if (!refill(r)) return -1;
     }
-    fprintf(file, "  </event-types>\n");
-
-    /* Write objects */
-    fprintf(file, "  <objects>\n");
-    for (int i = 0; i < object_count; i++) {
-        fprintf(file, "    <object id=\"%s\" type=\"%s\">\n", objects[i].id, objects[i].type);
-        fprintf(file, "      <attributes>\n");
-        for (int j = 0; j < objects[i].attribute_count; j++) {
-            fprintf(file, "        <attribute name=\"%s\" time=\"%s\">%s</attribute>\n",
-                    objects[i].attributes[j].name,
-                    objects[i].attributes[j].time,
-                    objects[i].attributes[j].value);
+}
+
+/* Split the inside of a start tag (NUL-terminated) into name and attributes */
+static void parse_tag(XmlReader *r, char *p, XmlTag *tag) {
+    tag->name = p;
+    while (*p && !xml_is_space(*p) && *p != '/') p++;
+    char *name_end = p;
+    while (*p) {
+        while (xml_is_space(*p)) p++;
+        if (*p == '/') {
+            tag->self_closing = 1;
+            p++;
+            continue;
         }
-        fprintf(file, "      </attributes>\n");
-        if (objects[i].relationship_count > 0) {
-            fprintf(file, "      <objects>\n");
-            for (int j = 0; j < objects[i].relationship_count; j++) {
-                fprintf(file, "        <relationship object-id=\"%s\" qualifier=\"%s\"/>\n",
-                        objects[i].relationships[j].object_id,
-                        objects[i].relationships[j].qualifier);
-            }
-            fprintf(file, "      </objects>\n");
+        if (!*p) break;
+        char *name = p;
+        while (*p && *p != '=' && !xml_is_space(*p)) p++;
+        char *attribute_name_end = p;
+        while (xml_is_space(*p)) p++;
+        if (*p != '=') {
+            r->error = 1;
+            fprintf(stderr, "OCEL XML: malformed attribute in <%s>\n", tag->name);
+            break;
         }
-        fprintf(file, "    </object>\n");
-    }
-    fprintf(file, "  </objects>\n");
-
-    /* Write events */
-    fprintf(file, "  <events>\n");
-    for (int i = 0; i < event_count; i++) {
-        fprintf(file, "    <event id=\"%s\" type=\"%s\" time=\"%s\">\n",
-                events[i].id, events[i].type, events[i].time);
-        fprintf(file, "      <attributes>\n");
-        for (int j = 0; j < events[i].attribute_count; j++) {
-            fprintf(file, "        <attribute name=\"%s\">%s</attribute>\n",
-                    events[i].attributes[j].name,
-                    events[i].attributes[j].value);
+        p++;
+        while (xml_is_space(*p)) p++;
+        char quote = *p;
+        if (quote != '"' && quote != '\'') {
+            r->error = 1;
+            fprintf(stderr, "OCEL XML: unquoted attribute value in <%s>\n", tag->name);
+            break;
         }
-        fprintf(file, "      </attributes>\n");
-        if (events[i].relationship_count > 0) {
-            fprintf(file, "      <objects>\n");
-            for (int j = 0; j < events[i].relationship_count; j++) {
-                fprintf(file, "        <relationship object-id=\"%s\" qualifier=\"%s\"/>\n",
-                        events[i].relationships[j].object_id,
-                        events[i].relationships[j].qualifier);
-            }
-            fprintf(file, "      </objects>\n");
+        char *value = ++p;
+        while (*p && *p != quote) p++;
+        size_t value_len = (size_t)(p - value);
+        if (*p) *p++ = '\0';
+        *attribute_name_end = '\0';
+        if (tag->attribute_count < XML_MAX_ATTRIBUTES) {
+            XmlAttribute *attribute = &tag->attributes[tag->attribute_count++];
+            attribute->name = name;
+            attribute->name_len = (size_t)(attribute_name_end - name);
+            attribute->value = value;
+            attribute->value_len = xml_decode_entities(value, value_len + 1, value, value_len);
         }
-        fprintf(file, "    </event>\n");
     }
-    fprintf(file, "  </events>\n");
-
-    fprintf(file, "</log>\n");
-
-    fclose(file);
+    *name_end = '\0';
 }
 
-void parse_log(FILE *file) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "<object-types>")) {
-            parse_object_types(file);
-        } else if (strstr(line, "<event-types>")) {
-            parse_event_types(file);
-        } else if (strstr(line, "<objects>")) {
-            parse_objects(file);
-        } else if (strstr(line, "<events>")) {
-            parse_events(file);
+/* Scan the next start or end tag; 0 at the end of the document or on error */
+static int next_tag(XmlReader *r, XmlTag *tag) {
+    for (;;) {
+        long lt = find_data(r, 0, "<");
+        if (lt < 0) return 0;
+        /* The tag ends at the first '>' (comments and CDATA sections end with their own marker) */
+        const char *marker = ">";
+        long end;
+        if (r->length - r->pos < (size_t)lt + 9) refill(r);
+        char *start = r->buffer + r->pos + lt;
+        if (strncmp(start, "<!--", 4) == 0) marker = "-->";
+        else if (strncmp(start, "<![CDATA[", 9) == 0) marker = "]]>";
+        end = find_data(r, (size_t)lt + 1, marker);
+        if (end < 0) {
+            r->error = 1;
+            fprintf(stderr, "OCEL XML: unterminated tag\n");
+            return 0;
         }
-    }
-}
-
-void parse_object_types(FILE *file) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</object-types>")) {
-            break;
-        } else if (strstr(line, "<object-type")) {
-            ObjectType ot;
-            memset(&ot, 0, sizeof(ObjectType));
-            char *ptr = strstr(line, "name=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", ot.name);
-            }
-
-            /* Read attributes */
-            while (fgets(line, sizeof(line), file)) {
-                if (strstr(line, "</object-type>")) {
-                    break;
-                } else if (strstr(line, "<attributes>")) {
-                    parse_attributes(file, ot.attributes, &ot.attribute_count);
-                }
-            }
-            object_types[object_type_count++] = ot;
+        char *text = r->buffer + r->pos;
+        start = text + lt;
+        char *close = text + end;
+        size_t next = (size_t)end + strlen(marker);
+        if (start[1] == '!' || start[1] == '?') {
+            /* Comment, declaration or processing instruction: drop it with the text before */
+            r->pos += next;
+            continue;
         }
+        *start = '\0';
+        *close = '\0';
+        memset(tag, 0, sizeof(*tag));
+        tag->text = text;
+        xml_decode_entities(text, (size_t)lt + 1, text, (size_t)lt);
+        if (start[1] == '/') {
+            tag->closing = 1;
+            tag->name = start + 2;
+            while (*tag->name && xml_is_space(*tag->name)) tag->name++;
+            char *p = tag->name;
+            while (*p && !xml_is_space(*p)) p++;
+            *p = '\0';
+        } else {
+            parse_tag(r, start + 1, tag);
+        }
+        r->pos += next;
+        return !r->error;
     }
 }
 
-void parse_event_types(FILE *file) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</event-types>")) {
-            break;
-        } else if (strstr(line, "<event-type")) {
-            EventType et;
-            memset(&et, 0, sizeof(EventType));
-            char *ptr = strstr(line, "name=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", et.name);
-            }
-
-            /* Read attributes */
-            while (fgets(line, sizeof(line), file)) {
-                if (strstr(line, "</event-type>")) {
-                    break;
-                } else if (strstr(line, "<attributes>")) {
-                    parse_attributes(file, et.attributes, &et.attribute_count);
-                }
-            }
-            event_types[event_type_count++] = et;
-        }
+static const char *get_attribute(const XmlTag *tag, const char *name) {
+    for (int i = 0; i < tag->attribute_count; i++) {
+        if (strcmp(tag->attributes[i].name, name) == 0) return tag->attributes[i].value;
     }
+    return NULL;
 }
 
-void parse_attributes(FILE *file, AttributeDef *attributes, int *attribute_count) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</attributes>")) {
-            break;
-        } else if (strstr(line, "<attribute")) {
-            AttributeDef attr;
-            memset(&attr, 0, sizeof(AttributeDef));
-
-            char *ptr = strstr(line, "name=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", attr.name);
-            }
+/* Import */
 
-            ptr = strstr(line, "type=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", attr.type);
-            }
+typedef enum { SECTION_NONE, SECTION_OBJECT_TYPES, SECTION_EVENT_TYPES, SECTION_OBJECTS, SECTION_EVENTS } Section;
+typedef enum { RECORD_NONE, RECORD_OBJECT_TYPE, RECORD_EVENT_TYPE, RECORD_OBJECT, RECORD_EVENT } Record;
 
-            attributes[(*attribute_count)++] = attr;
-        }
+/*
+ * Name and time of the <attribute> being read (the tag does not outlive next_tag), copied into
+ * one buffer that is reused for every attribute: the name, NUL, the time, NUL
+ */
+typedef struct {
+    char *buffer;
+    size_t capacity;
+    size_t time;            /* offset of the time in the buffer */
+    int open;
+} PendingAttribute;
+
+static void set_pending_attribute(PendingAttribute *pending, const char *name, const char *time) {
+    if (!name) name = "";
+    if (!time) time = "";
+    size_t name_size = strlen(name) + 1, time_size = strlen(time) + 1;
+    if (name_size + time_size > pending->capacity) {
+        pending->capacity = 2 * (name_size + time_size);
+        pending->buffer = (char *)realloc(pending->buffer, pending->capacity);
     }
+    memcpy(pending->buffer, name, name_size);
+    memcpy(pending->buffer + name_size, time, time_size);
+    pending->time = name_size;
+    pending->open = 1;
 }
 
-void parse_objects(FILE *file) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</objects>") && !strstr(line, "<objects>")) {
-            break;
-        } else if (strstr(line, "<object")) {
-            Object obj;
-            memset(&obj, 0, sizeof(Object));
+/* Read an OCEL 2.0 XML file into log: 0 on success, -1 on error */
+int import_ocel_xml(OcelLog *log, const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error opening input file %s\n", filename);
+        return -1;
+    }
 
-            char *ptr = strstr(line, "id=\"");
-            if (ptr) {
-                sscanf(ptr + 4, "%[^\"]", obj.id);
+    K_STATS_BEGIN("parse");
+    XmlReader reader;
+    memset(&reader, 0, sizeof(reader));
+    reader.file = file;
+    Section section = SECTION_NONE;
+    Record record = RECORD_NONE;
+    int type = -1;
+    PendingAttribute pending = { NULL, 0, 0, 0 };
+    XmlTag tag;
+
+    while (next_tag(&reader, &tag)) {
+        const char *name = tag.name;
+        if (tag.closing) {
+            if (strcmp(name, "attribute") == 0 && pending.open) {
+                if (record == RECORD_OBJECT) add_ocel_object_attribute(log, pending.buffer, tag.text, pending.buffer + pending.time);
+                else if (record == RECORD_EVENT) add_ocel_event_attribute(log, pending.buffer, tag.text);
+                pending.open = 0;
+            } else if ((strcmp(name, "object") == 0 && record == RECORD_OBJECT) ||
+                       (strcmp(name, "event") == 0 && record == RECORD_EVENT)) {
+                end_ocel_record(log, record == RECORD_OBJECT ? OCEL_OBJECTS : OCEL_EVENTS);
+                reader.records++;
+                record = RECORD_NONE;
+            } else if (strcmp(name, "object-type") == 0 || strcmp(name, "event-type") == 0 ||
+                       strcmp(name, "object") == 0 || strcmp(name, "event") == 0) {
+                record = RECORD_NONE;
+            } else if (record == RECORD_NONE && (strcmp(name, "object-types") == 0 || strcmp(name, "event-types") == 0 ||
+                                                 strcmp(name, "objects") == 0 || strcmp(name, "events") == 0)) {
+                section = SECTION_NONE;
             }
+            continue;
+        }
 
-            ptr = strstr(line, "type=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", obj.type);
+        if (record == RECORD_NONE) {
+            if (strcmp(name, "object-types") == 0) section = SECTION_OBJECT_TYPES;
+            else if (strcmp(name, "event-types") == 0) section = SECTION_EVENT_TYPES;
+            else if (strcmp(name, "objects") == 0) section = SECTION_OBJECTS;
+            else if (strcmp(name, "events") == 0) section = SECTION_EVENTS;
+            else if (strcmp(name, "object-type") == 0 && section == SECTION_OBJECT_TYPES) {
+                type = add_ocel_object_type(log, get_attribute(&tag, "name"));
+                record = RECORD_OBJECT_TYPE;
+            } else if (strcmp(name, "event-type") == 0 && section == SECTION_EVENT_TYPES) {
+                type = add_ocel_event_type(log, get_attribute(&tag, "name"));
+                record = RECORD_EVENT_TYPE;
+            } else if (strcmp(name, "object") == 0 && section == SECTION_OBJECTS) {
+                add_ocel_object(log, get_attribute(&tag, "id"), get_attribute(&tag, "type"));
+                record = RECORD_OBJECT;
+            } else if (strcmp(name, "event") == 0 && section == SECTION_EVENTS) {
+                add_ocel_event(log, get_attribute(&tag, "id"), get_attribute(&tag, "type"), get_attribute(&tag, "time"));
+                record = RECORD_EVENT;
             }
-
-            /* Read object contents */
-            while (fgets(line, sizeof(line), file)) {
-                if (strstr(line, "</object>")) {
-                    break;
-                } else if (strstr(line, "<attributes>")) {
-                    parse_object_attributes(file, &obj);
-                } else if (strstr(line, "<objects>")) {
-                    parse_relationships(file, obj.relationships, &obj.relationship_count, "</objects>");
+            if (tag.self_closing && record != RECORD_NONE) {
+                if (record == RECORD_OBJECT || record == RECORD_EVENT) {
+                    end_ocel_record(log, record == RECORD_OBJECT ? OCEL_OBJECTS : OCEL_EVENTS);
+                    reader.records++;
                 }
+                record = RECORD_NONE;
             }
-            objects[object_count++] = obj;
+            continue;
         }
-    }
-}
 
-void parse_object_attributes(FILE *file, Object *obj) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</attributes>")) {
-            break;
-        } else if (strstr(line, "<attribute")) {
-            ObjectAttribute attr;
-            memset(&attr, 0, sizeof(ObjectAttribute));
-
-            char *ptr = strstr(line, "name=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", attr.name);
+        if (strcmp(name, "attribute") == 0) {
+            if (record == RECORD_OBJECT_TYPE || record == RECORD_EVENT_TYPE) {
+                OcelType *t = record == RECORD_OBJECT_TYPE ? &log->object_types[type] : &log->event_types[type];
+                add_ocel_type_attribute(log, t, get_attribute(&tag, "name"), get_attribute(&tag, "type"));
+            } else if (tag.self_closing) {
+                if (record == RECORD_OBJECT) add_ocel_object_attribute(log, get_attribute(&tag, "name"), "", get_attribute(&tag, "time"));
+                else add_ocel_event_attribute(log, get_attribute(&tag, "name"), "");
+            } else {
+                set_pending_attribute(&pending, get_attribute(&tag, "name"), get_attribute(&tag, "time"));
             }
-
-            ptr = strstr(line, "time=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", attr.time);
+        } else if (strcmp(name, "relationship") == 0 || strcmp(name, "relobj") == 0) {
+            if (record == RECORD_OBJECT) {
+                add_ocel_object_relationship(log, get_attribute(&tag, "object-id"), get_attribute(&tag, "qualifier"));
+            } else if (record == RECORD_EVENT) {
+                add_ocel_event_relationship(log, get_attribute(&tag, "object-id"), get_attribute(&tag, "qualifier"));
             }
-
-            ptr = strstr(line, ">");
-            if (ptr) {
-                ptr++;
-                char *end = strstr(ptr, "</attribute>");
-                if (end) {
-                    *end = '\0';
-                }
-                strcpy(attr.value, ptr);
-            }
-
-            obj->attributes[obj->attribute_count++] = attr;
         }
     }
-}
+    K_STATS_COUNT(ftell(file), reader.records);
+    K_STATS_END();
 
-void parse_relationships(FILE *file, Relationship *relationships, int *relationship_count, const char *end_tag) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, end_tag)) {
-            break;
-        } else if (strstr(line, "<relationship")) {
-            Relationship rel;
-            memset(&rel, 0, sizeof(Relationship));
-
-            char *ptr = strstr(line, "object-id=\"");
-            if (ptr) {
-                sscanf(ptr + 11, "%[^\"]", rel.object_id);
-            }
+    free(pending.buffer);
+    free(reader.buffer);
+    fclose(file);
+    return reader.error ? -1 : 0;
+}
 
-            ptr = strstr(line, "qualifier=\"");
-            if (ptr) {
-                sscanf(ptr + 11, "%[^\"]", rel.qualifier);
-            }
+/* Exporter */
+
+static void write_type(FILE *file, const OcelType *type, const char *tag) {
+    fprintf(file, "    <%s name=\"", tag);
+    xml_fwrite_escaped(file, type->name);
+    fprintf(file, "\">\n");
+    fprintf(file, "      <attributes>\n");
+    for (int j = 0; j < type->attribute_count; j++) {
+        fprintf(file, "        <attribute name=\"");
+        xml_fwrite_escaped(file, type->attributes[j].name);
+        fprintf(file, "\" type=\"");
+        xml_fwrite_escaped(file, type->attributes[j].type);
+        fprintf(file, "\"/>\n");
+    }
+    fprintf(file, "      </attributes>\n");
+    fprintf(file, "    </%s>\n", tag);
+}
 
-            relationships[(*relationship_count)++] = rel;
-        }
+static void write_relationships(FILE *file, const OcelRelationship *relationships, int count) {
+    if (count == 0) return;
+    fprintf(file, "      <objects>\n");
+    for (int j = 0; j < count; j++) {
+        fprintf(file, "        <relationship object-id=\"");
+        xml_fwrite_escaped(file, relationships[j].object_id);
+        fprintf(file, "\" qualifier=\"");
+        xml_fwrite_escaped(file, relationships[j].qualifier);
+        fprintf(file, "\"/>\n");
     }
+    fprintf(file, "      </objects>\n");
 }
 
-void parse_events(FILE *file) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</events>")) {
-            break;
-        } else if (strstr(line, "<event")) {
-            Event event;
-            memset(&event, 0, sizeof(Event));
+static void write_object(FILE *file, const OcelLog *log, const OcelObject *o) {
+    fprintf(file, "    <object id=\"");
+    xml_fwrite_escaped(file, o->id);
+    fprintf(file, "\" type=\"");
+    xml_fwrite_escaped(file, log->object_types[o->type].name);
+    fprintf(file, "\">\n");
+    fprintf(file, "      <attributes>\n");
+    for (int j = 0; j < o->attribute_count; j++) {
+        const OcelAttribute *a = &log->object_attributes[o->first_attribute + j];
+        fprintf(file, "        <attribute name=\"");
+        xml_fwrite_escaped(file, a->name);
+        fprintf(file, "\" time=\"");
+        xml_fwrite_escaped(file, a->time);
+        fprintf(file, "\">");
+        xml_fwrite_escaped(file, a->value);
+        fprintf(file, "</attribute>\n");
+    }
+    fprintf(file, "      </attributes>\n");
+    write_relationships(file, log->object_relationships + o->first_relationship, o->relationship_count);
+    fprintf(file, "    </object>\n");
+}
 
-            char *ptr = strstr(line, "id=\"");
-            if (ptr) {
-                sscanf(ptr + 4, "%[^\"]", event.id);
-            }
+static void write_event(FILE *file, const OcelLog *log, const OcelEvent *e) {
+    fprintf(file, "    <event id=\"");
+    xml_fwrite_escaped(file, e->id);
+    fprintf(file, "\" type=\"");
+    xml_fwrite_escaped(file, log->event_types[e->type].name);
+    fprintf(file, "\" time=\"");
+    xml_fwrite_escaped(file, e->time);
+    fprintf(file, "\">\n");
+    fprintf(file, "      <attributes>\n");
+    for (int j = 0; j < e->attribute_count; j++) {
+        const OcelAttribute *a = &log->event_attributes[e->first_attribute + j];
+        fprintf(file, "        <attribute name=\"");
+        xml_fwrite_escaped(file, a->name);
+        fprintf(file, "\">");
+        xml_fwrite_escaped(file, a->value);
+        fprintf(file, "</attribute>\n");
+    }
+    fprintf(file, "      </attributes>\n");
+    write_relationships(file, log->event_relationships + e->first_relationship, e->relationship_count);
+    fprintf(file, "    </event>\n");
+}
 
-            ptr = strstr(line, "type=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", event.type);
-            }
+static const char *section_tags[] = { "object-types", "event-types", "objects", "events" };
 
-            ptr = strstr(line, "time=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", event.time);
-            }
+static void xml_begin_log(FILE *file) {
+    fprintf(file, "<?xml version='1.0' encoding='UTF-8'?>\n");
+    fprintf(file, "<log>\n");
+}
 
-            /* Read event contents */
-            while (fgets(line, sizeof(line), file)) {
-                if (strstr(line, "</event>")) {
-                    break;
-                } else if (strstr(line, "<attributes>")) {
-                    parse_event_attributes(file, &event);
-                } else if (strstr(line, "<objects>")) {
-                    parse_relationships(file, event.relationships, &event.relationship_count, "</objects>");
-                }
-            }
-            events[event_count++] = event;
-        }
-    }
+static void xml_end_log(FILE *file) {
+    fprintf(file, "</log>\n");
 }
 
-void parse_event_attributes(FILE *file, Event *event) {
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "</attributes>")) {
-            break;
-        } else if (strstr(line, "<attribute")) {
-            ObjectAttribute attr;
-            memset(&attr, 0, sizeof(ObjectAttribute));
+static void xml_begin_section(FILE *file, OcelSection section, int index) {
+    (void)index;
+    fprintf(file, "  <%s>\n", section_tags[section]);
+}
 
-            char *ptr = strstr(line, "name=\"");
-            if (ptr) {
-                sscanf(ptr + 6, "%[^\"]", attr.name);
-            }
+static void xml_end_section(FILE *file, OcelSection section, int records) {
+    (void)records;
+    fprintf(file, "  </%s>\n", section_tags[section]);
+}
 
-            ptr = strstr(line, ">");
-            if (ptr) {
-                ptr++;
-                char *end = strstr(ptr, "</attribute>");
-                if (end) {
-                    *end = '\0';
-                }
-                strcpy(attr.value, ptr);
-            }
+static void xml_write_record(FILE *file, const OcelLog *log, OcelSection section, int i, int index) {
+    (void)index;
+    switch (section) {
+    case OCEL_OBJECT_TYPES: write_type(file, &log->object_types[i], "object-type"); break;
+    case OCEL_EVENT_TYPES: write_type(file, &log->event_types[i], "event-type"); break;
+    case OCEL_OBJECTS: write_object(file, log, &log->objects[i]); break;
+    case OCEL_EVENTS: write_event(file, log, &log->events[i]); break;
+    }
+}
 
-            event->attributes[event->attribute_count++] = attr;
-        }
+const OcelFormat ocel_xml_format = {
+    xml_begin_log, xml_end_log, xml_begin_section, xml_end_section, xml_write_record
+};
+
+/* Write log as OCEL 2.0 XML: 0 on success, -1 on error */
+int export_ocel_xml(const OcelLog *log, const char *filename) {
+    OcelWriter writer;
+    K_STATS_BEGIN("export");
+    if (open_ocel_writer(&writer, &ocel_xml_format, filename) != 0) {
+        K_STATS_END();
+        return -1;
     }
-}
\ No newline at end of file
+    write_ocel_records(&writer, log);
+    int status = close_ocel_writer(&writer, log, filename);
+    K_STATS_COUNT(writer.bytes, writer.records);
+    K_STATS_END();
+    return status;
+}
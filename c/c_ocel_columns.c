@@ -0,0 +1,98 @@
+/*
+ * Columnar view of an OCEL log, for other languages (see c_ocel_columns.h)
+ * Implemented in ANSI C; parallel with OpenMP (-fopenmp), sequential without
+ *
+ * **Main Components:**
+
+- **Columns:**
+  - Timestamps and type codes are copied out of the event and object structs in one pass
+    (the timestamps were parsed at load, see c_ocel.h).
+
+- **E2O in both directions:**
+  - The object -> events CSR is the one of OcelObjectIndex (c_ocdfg.h), whose arrays are
+    shared, not copied. The event -> objects CSR is its transpose: counted per event,
+    prefix-summed and filled by walking the objects in order, so the objects of every event
+    come out ascending without sorting.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_ocel_columns.h"
+#include "c_file_format.h"
+
+OcelLog *load_ocel_file(const char *filename) {
+    FileFormat format = file_format(filename);
+    if (!is_ocel_format(format)) {
+        fprintf(stderr, "Unsupported log format: %s\n", filename);
+        return NULL;
+    }
+    OcelLog *log = create_ocel();
+    if ((format == FORMAT_OCEL_JSON ? import_ocel_json(log, filename) : import_ocel_xml(log, filename)) != 0) {
+        free_ocel(log);
+        return NULL;
+    }
+    return log;
+}
+
+OcelColumns *ocel_columns(const OcelLog *log) {
+    int events = log->event_count, objects = log->object_count;
+    OcelColumns *columns = (OcelColumns *)malloc(sizeof(OcelColumns));
+    columns->log = log;
+    columns->event_count = events;
+    columns->object_count = objects;
+    columns->event_type_count = log->event_type_count;
+    columns->object_type_count = log->object_type_count;
+
+    columns->event_timestamps = (long long *)malloc(sizeof(long long) * (events > 0 ? events : 1));
+    columns->event_types = (int *)malloc(sizeof(int) * (events > 0 ? events : 1));
+    columns->object_types = (int *)malloc(sizeof(int) * (objects > 0 ? objects : 1));
+#pragma omp parallel for
+    for (int e = 0; e < events; e++) {
+        columns->event_timestamps[e] = log->events[e].timestamp;
+        columns->event_types[e] = log->events[e].type;
+    }
+    for (int o = 0; o < objects; o++) columns->object_types[o] = log->objects[o].type;
+
+    OcelObjectIndex *index = build_ocel_object_index(log);
+    columns->index = index;
+    columns->object_event_offsets = index->object_offsets;
+    columns->object_events = index->object_events;
+
+    /* Transpose object -> events into event -> objects */
+    int total = index->object_offsets[objects];
+    int *offsets = (int *)calloc(events + 1, sizeof(int));
+    int *related = (int *)malloc(sizeof(int) * (total > 0 ? total : 1));
+    for (int i = 0; i < total; i++) offsets[index->object_events[i] + 1]++;
+    for (int e = 0; e < events; e++) offsets[e + 1] += offsets[e];
+    int *cursor = (int *)malloc(sizeof(int) * (events > 0 ? events : 1));
+    if (events > 0) memcpy(cursor, offsets, sizeof(int) * events);
+    for (int o = 0; o < objects; o++) {
+        for (int i = index->object_offsets[o]; i < index->object_offsets[o + 1]; i++) {
+            related[cursor[index->object_events[i]]++] = o;
+        }
+    }
+    free(cursor);
+    columns->event_object_offsets = offsets;
+    columns->event_objects = related;
+    return columns;
+}
+
+void free_ocel_columns(OcelColumns *columns) {
+    free(columns->event_timestamps);
+    free(columns->event_types);
+    free(columns->object_types);
+    free(columns->event_object_offsets);
+    free(columns->event_objects);
+    free_ocel_object_index(columns->index);
+    free(columns);
+}
+
+const char *ocel_event_type_name(const OcelLog *log, int type) {
+    return type >= 0 && type < log->event_type_count ? log->event_types[type].name : NULL;
+}
+
+const char *ocel_object_type_name(const OcelLog *log, int type) {
+    return type >= 0 && type < log->object_type_count ? log->object_types[type].name : NULL;
+}
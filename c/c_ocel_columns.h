@@ -0,0 +1,52 @@
+/*
+ * Columnar view of an OCEL log, for other languages
+ *
+ * The OcelLog keeps one struct per event and object; OcelColumns gathers
+ * the fields numerical code needs into flat arrays of plain integers, built
+ * once from the log (in C) and then shared as they are: Fortran maps them to
+ * array pointers through ISO_C_BINDING (fortran/f2003_ocel_c.f90) without
+ * copying. Indices and offsets are 0-based; the arrays stay valid until
+ * free_ocel_columns, and the log must outlive the columns.
+ *
+ * The E2O relationships are given in both directions, as CSR: the objects of
+ * event e are event_objects[event_object_offsets[e] .. event_object_offsets[e + 1])
+ * (ascending), the events of object o are object_events[object_event_offsets[o]
+ * .. object_event_offsets[o + 1]) (by time, see c_ocdfg.h). Every event-object
+ * pair appears once; relationships to unknown object ids are left out.
+ * Library module without a main.
+ */
+
+#ifndef C_OCEL_COLUMNS_H
+#define C_OCEL_COLUMNS_H
+
+#include "c_ocel.h"
+#include "c_ocdfg.h"
+
+typedef struct {
+    const OcelLog *log;
+    OcelObjectIndex *index;         /* owns the object -> events arrays */
+    int event_count;
+    int object_count;
+    int event_type_count;
+    int object_type_count;
+    long long *event_timestamps;    /* ms since the epoch, TIMESTAMP_NONE if none (c_timestamp.h) */
+    int *event_types;               /* index into log->event_types */
+    int *object_types;              /* index into log->object_types */
+    int *event_object_offsets;      /* event_count + 1 entries */
+    int *event_objects;
+    int *object_event_offsets;      /* object_count + 1 entries */
+    int *object_events;
+} OcelColumns;
+
+/* Import an OCEL log by the file extension (.json/.jsonocel, .xml/.xmlocel: c_file_format.h);
+   NULL on error or for another extension */
+OcelLog *load_ocel_file(const char *filename);
+
+OcelColumns *ocel_columns(const OcelLog *log);
+void free_ocel_columns(OcelColumns *columns);
+
+/* Names of the types (valid while the log is) */
+const char *ocel_event_type_name(const OcelLog *log, int type);
+const char *ocel_object_type_name(const OcelLog *log, int type);
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Time queries on an OCEL log (see c_ocel_time.h)
+ * Implemented in ANSI C; the sorts are parallel with OpenMP (-fopenmp), sequential without
+ *
+ * **Main Components:**
+
+- **Event order:**
+  - The events are radix-sorted by timestamp (c_radix_sort.h); the timestamps are then
+    copied in that order, so a window search touches one contiguous array.
+
+- **Attribute order:**
+  - The distinct attribute names are collected in an open-addressing table (FNV-1a, load
+    factor below 1/2) and ranked by strcmp. Two stable radix sorts, by timestamp and then
+    by (object, name rank), order the attributes by object, name and time; since the
+    attributes of an object are contiguous in the pool, the sorted attributes of object o
+    end up at its range.
+
+- **Queries:**
+  - A window is two lower-bound searches in the sorted timestamps. The value at a time is
+    an upper-bound search for (name, time) in the range of the object, then a check that the
+    attribute before it has the name.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_ocel_time.h"
+#include "c_radix_sort.h"
+
+static unsigned int hash_name(const char *s) {
+    unsigned int h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/* Rank (in strcmp order) of the name of every object attribute */
+static int *rank_attribute_names(const OcelLog *log) {
+    int n = log->object_attribute_count;
+    int *name_of = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    unsigned int capacity = 16;
+    int *slots = (int *)malloc(sizeof(int) * capacity);
+    for (unsigned int i = 0; i < capacity; i++) slots[i] = -1;
+    const char **names = NULL;
+    int name_count = 0;
+
+    for (int a = 0; a < n; a++) {
+        if ((unsigned int)name_count * 2 >= capacity) {
+            capacity *= 2;
+            slots = (int *)realloc(slots, sizeof(int) * capacity);
+            for (unsigned int i = 0; i < capacity; i++) slots[i] = -1;
+            for (int i = 0; i < name_count; i++) {
+                unsigned int slot = hash_name(names[i]) & (capacity - 1);
+                while (slots[slot] >= 0) slot = (slot + 1) & (capacity - 1);
+                slots[slot] = i;
+            }
+        }
+        const char *name = log->object_attributes[a].name;
+        unsigned int slot = hash_name(name) & (capacity - 1);
+        while (slots[slot] >= 0 && strcmp(names[slots[slot]], name) != 0) slot = (slot + 1) & (capacity - 1);
+        if (slots[slot] < 0) {
+            if ((name_count & (name_count - 1)) == 0) {
+                names = (const char **)realloc(names, sizeof(char *) * (name_count ? name_count * 2 : 1));
+            }
+            names[name_count] = name;
+            slots[slot] = name_count++;
+        }
+        name_of[a] = slots[slot];
+    }
+
+    /* Name id -> rank */
+    const char **sorted = (const char **)malloc(sizeof(char *) * (name_count > 0 ? name_count : 1));
+    if (name_count) memcpy(sorted, names, sizeof(char *) * name_count);
+    qsort(sorted, name_count, sizeof(char *), compare_names);
+    int *rank = (int *)malloc(sizeof(int) * (name_count > 0 ? name_count : 1));
+    for (int r = 0; r < name_count; r++) {
+        unsigned int slot = hash_name(sorted[r]) & (capacity - 1);
+        while (strcmp(names[slots[slot]], sorted[r]) != 0) slot = (slot + 1) & (capacity - 1);
+        rank[slots[slot]] = r;
+    }
+    for (int a = 0; a < n; a++) name_of[a] = rank[name_of[a]];
+
+    free(rank);
+    free(sorted);
+    free(names);
+    free(slots);
+    return name_of;
+}
+
+OcelTimeIndex *build_ocel_time_index(const OcelLog *log) {
+    int events = log->event_count, attributes = log->object_attribute_count;
+    OcelTimeIndex *index = (OcelTimeIndex *)malloc(sizeof(OcelTimeIndex));
+    index->log = log;
+
+    /* Events by time */
+    int size = events > attributes ? events : attributes;
+    unsigned long long *keys = (unsigned long long *)calloc(size > 0 ? size : 1, sizeof(unsigned long long));
+    index->event_order = (int *)malloc(sizeof(int) * (events > 0 ? events : 1));
+    index->event_times = (long long *)malloc(sizeof(long long) * (events > 0 ? events : 1));
+    for (int e = 0; e < events; e++) {
+        keys[e] = radix_signed_key(log->events[e].timestamp);
+        index->event_order[e] = e;
+    }
+    radix_sort_order(index->event_order, events, keys);
+    for (int i = 0; i < events; i++) index->event_times[i] = log->events[index->event_order[i]].timestamp;
+
+    /* Object attributes by (object, name, time) */
+    int *order = (int *)malloc(sizeof(int) * (attributes > 0 ? attributes : 1));
+    for (int a = 0; a < attributes; a++) {
+        keys[a] = radix_signed_key(log->object_attributes[a].timestamp);
+        order[a] = a;
+    }
+    radix_sort_order(order, attributes, keys);
+    int *rank = rank_attribute_names(log);
+    for (int a = 0; a < attributes; a++) keys[a] = (unsigned long long)rank[a];
+    for (int o = 0; o < log->object_count; o++) {
+        const OcelObject *object = &log->objects[o];
+        for (int a = object->first_attribute; a < object->first_attribute + object->attribute_count; a++) {
+            keys[a] |= (unsigned long long)o << 32;
+        }
+    }
+    radix_sort_order(order, attributes, keys);
+
+    /* The attributes of the objects are contiguous and in object order, so the sorted
+       order puts the ones of object o at its range */
+    index->attribute_order = order;
+
+    free(rank);
+    free(keys);
+    return index;
+}
+
+void free_ocel_time_index(OcelTimeIndex *index) {
+    free(index->event_order);
+    free(index->event_times);
+    free(index->attribute_order);
+    free(index);
+}
+
+/* First position in the sorted event times with a time >= time */
+static int lower_bound_time(const OcelTimeIndex *index, long long time) {
+    int low = 0, high = index->log->event_count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (index->event_times[mid] < time) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+const int *ocel_events_between(const OcelTimeIndex *index, long long from, long long to, int *count) {
+    int first = lower_bound_time(index, from);
+    int last = to > from ? lower_bound_time(index, to) : first;
+    *count = last - first;
+    return index->event_order + first;
+}
+
+const char *ocel_object_value_at(const OcelTimeIndex *index, int object, const char *name, long long time) {
+    const OcelLog *log = index->log;
+    if (object < 0 || object >= log->object_count) return NULL;
+    const int *order = index->attribute_order + log->objects[object].first_attribute;
+    int low = 0, high = log->objects[object].attribute_count;
+
+    /* First attribute after (name, time) */
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        const OcelAttribute *a = &log->object_attributes[order[mid]];
+        int c = strcmp(a->name, name);
+        if (c < 0 || (c == 0 && a->timestamp <= time)) low = mid + 1;
+        else high = mid;
+    }
+    if (low == 0) return NULL;
+    const OcelAttribute *a = &log->object_attributes[order[low - 1]];
+    return strcmp(a->name, name) == 0 ? a->value : NULL;
+}
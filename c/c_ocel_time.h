@@ -0,0 +1,34 @@
+/*
+ * Time queries on an OCEL log
+ *
+ * An OcelTimeIndex orders the events of a log by timestamp and the attribute
+ * values of every object by (name, timestamp), both by radix sort of the
+ * timestamps parsed at load (c_ocel.h). Queries are binary searches:
+ * the events of a time window, and the value an object attribute had at a
+ * given time. Library module without a main.
+ */
+
+#ifndef C_OCEL_TIME_H
+#define C_OCEL_TIME_H
+
+#include "c_ocel.h"
+
+typedef struct {
+    const OcelLog *log;
+    int *event_order;           /* events by timestamp (ties: by position); events without a time first */
+    long long *event_times;     /* timestamps in event_order */
+    int *attribute_order;       /* object attributes; those of object o at first_attribute .. + attribute_count,
+                                   by name (strcmp), then timestamp, then position */
+} OcelTimeIndex;
+
+OcelTimeIndex *build_ocel_time_index(const OcelLog *log);
+void free_ocel_time_index(OcelTimeIndex *index);
+
+/* Events with from <= timestamp < to, in time order: a range of event_order, *count long */
+const int *ocel_events_between(const OcelTimeIndex *index, long long from, long long to, int *count);
+
+/* Value of attribute name of object at time: the last one set at or before time
+   (values without a time hold from the start); NULL if none */
+const char *ocel_object_value_at(const OcelTimeIndex *index, int object, const char *name, long long time);
+
+#endif
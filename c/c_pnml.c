@@ -2,163 +2,362 @@
 #include <stdlib.h>
 #include <string.h>
 
-/*
-signature of Petri net methods:
-
-PetriNet* createPetriNet();
-void addPlace(PetriNet* net, char* id, int initialMarking);
-void addTransition(PetriNet* net, char* id, char* name, int visible);
-void addArc(PetriNet* net, char* id, char* source, char* target);
-void addFinalMarking(PetriNet* net, char* place_id, int finalMarking);
-
-void exportPNML(PetriNet* net, const char* filename);
-void freePetriNet(PetriNet* net);
-*/
-
-// Structure for a Place
-typedef struct Place {
-    char id[50];
-    int initialMarking;
-    struct Place *next;
-} Place;
-
-// Structure for a Final Marking
-typedef struct FinalMarking {
-    char place_id[50];
-    int finalMarking;
-    struct FinalMarking *next;
-} FinalMarking;
-
-// Structure for a Transition
-typedef struct Transition {
-    char id[50];
-    char name[100]; // Transition label (name)
-    int visible; // 1 if visible, 0 if invisible
-    struct Transition *next;
-} Transition;
-
-// Structure for an Arc
-typedef struct Arc {
-    char id[50];
-    char source[50];
-    char target[50];
-    struct Arc *next;
-} Arc;
-
-// Structure for a Petri Net
-typedef struct PetriNet {
-    Place *places;
-    Transition *transitions;
-    Arc *arcs;
-    FinalMarking *finalMarkings;
-} PetriNet;
+#include "c_pnml.h"
+#include "c_xml.h"
+
+// Copies a string into a fixed-size field, truncating if needed
+static void copyField(char *dest, size_t size, const char *src) {
+    size_t len = strlen(src);
+    if (len >= size) len = size - 1;
+    memcpy(dest, src, len);
+    dest[len] = '\0';
+}
 
 // Function to create a new PetriNet
 PetriNet* createPetriNet() {
-    PetriNet* net = (PetriNet*) malloc(sizeof(PetriNet));
-    net->places = NULL;
-    net->transitions = NULL;
-    net->arcs = NULL;
-    net->finalMarkings = NULL;
+    PetriNet* net = (PetriNet*) calloc(1, sizeof(PetriNet));
     return net;
 }
 
-// Function to add a place
-void addPlace(PetriNet* net, char* id, int initialMarking) {
-    Place* place = (Place*) malloc(sizeof(Place));
-    strcpy(place->id, id);
+// Function to add a place with an explicit name
+void addNamedPlace(PetriNet* net, char* id, char* name, int initialMarking) {
+    Place* place = (Place*) arena_alloc(&net->arena, sizeof(Place));
+    copyField(place->id, sizeof(place->id), id);
+    copyField(place->name, sizeof(place->name), name);
     place->initialMarking = initialMarking;
-    place->next = net->places;
-    net->places = place;
+    place->next = NULL;
+    if (net->lastPlace) net->lastPlace->next = place; else net->places = place;
+    net->lastPlace = place;
+}
+
+// Function to add a place (named after its id)
+void addPlace(PetriNet* net, char* id, int initialMarking) {
+    addNamedPlace(net, id, id, initialMarking);
 }
 
 // Function to add a transition
 void addTransition(PetriNet* net, char* id, char* name, int visible) {
-    Transition* transition = (Transition*) malloc(sizeof(Transition));
-    strcpy(transition->id, id);
-    strcpy(transition->name, name);
+    Transition* transition = (Transition*) arena_alloc(&net->arena, sizeof(Transition));
+    copyField(transition->id, sizeof(transition->id), id);
+    copyField(transition->name, sizeof(transition->name), name);
     transition->visible = visible;
-    transition->next = net->transitions;
-    net->transitions = transition;
+    transition->localNodeID[0] = '\0';
+    transition->next = NULL;
+    if (net->lastTransition) net->lastTransition->next = transition; else net->transitions = transition;
+    net->lastTransition = transition;
 }
 
 // Function to add an arc
 void addArc(PetriNet* net, char* id, char* source, char* target) {
-    Arc* arc = (Arc*) malloc(sizeof(Arc));
-    strcpy(arc->id, id);
-    strcpy(arc->source, source);
-    strcpy(arc->target, target);
-    arc->next = net->arcs;
-    net->arcs = arc;
+    Arc* arc = (Arc*) arena_alloc(&net->arena, sizeof(Arc));
+    copyField(arc->id, sizeof(arc->id), id);
+    copyField(arc->source, sizeof(arc->source), source);
+    copyField(arc->target, sizeof(arc->target), target);
+    arc->weight = 1;
+    arc->next = NULL;
+    if (net->lastArc) net->lastArc->next = arc; else net->arcs = arc;
+    net->lastArc = arc;
 }
 
 // Function to add a final marking
 void addFinalMarking(PetriNet* net, char* place_id, int finalMarking) {
-    FinalMarking* marking = (FinalMarking*) malloc(sizeof(FinalMarking));
-    strcpy(marking->place_id, place_id);
+    FinalMarking* marking = (FinalMarking*) arena_alloc(&net->arena, sizeof(FinalMarking));
+    copyField(marking->place_id, sizeof(marking->place_id), place_id);
     marking->finalMarking = finalMarking;
-    marking->next = net->finalMarkings;
-    net->finalMarkings = marking;
+    marking->next = NULL;
+    if (net->lastFinalMarking) net->lastFinalMarking->next = marking; else net->finalMarkings = marking;
+    net->lastFinalMarking = marking;
 }
 
-// Helper function to extract the transition name
-void extractText(char *line, char *output) {
-    char *start = strstr(line, "<text>");
-    char *end = strstr(line, "</text>");
-    if (start != NULL && end != NULL) {
-        start += 6; // Move past <text> tag
-        strncpy(output, start, end - start);
-        output[end - start] = '\0';
+/*
+ * PNML reader
+ *
+ * The whole file is loaded in memory and scanned tag by tag. Attributes are
+ * looked up by name, so their order (and the line layout of the file) does not
+ * matter. Elements of all pages are collected into the same net; reference
+ * places/transitions of multi-page nets are resolved to the nodes they point to.
+ */
+
+#define PNML_MAX_ATTRIBUTES 16
+#define PNML_MAX_DEPTH 64
+
+typedef enum {
+    EL_OTHER,
+    EL_NET,
+    EL_PAGE,
+    EL_PLACE,
+    EL_TRANSITION,
+    EL_ARC,
+    EL_NAME,
+    EL_TEXT,
+    EL_INITIAL_MARKING,
+    EL_INSCRIPTION,
+    EL_TOOLSPECIFIC,
+    EL_FINAL_MARKINGS,
+    EL_MARKING,
+    EL_MARKING_PLACE, // <place idref=".."> inside a final <marking>
+    EL_REFERENCE
+} ElementKind;
+
+typedef struct {
+    char id[50];
+    char ref[50];
+} NodeAlias;
+
+// State of the reader while scanning the document
+typedef struct {
+    ElementKind stack[PNML_MAX_DEPTH];
+    int depth;
+    char *text; // Character data of the current <text> element
+    size_t textLen;
+    size_t textCapacity;
+    // Element under construction
+    char id[50];
+    char name[100];
+    char localNodeID[50];
+    char source[50];
+    char target[50];
+    int marking;
+    int visible;
+    int weight;
+    NodeAlias *aliases;
+    int aliasCount;
+    int aliasCapacity;
+} PnmlReader;
+
+static void appendText(PnmlReader *r, const char *s, size_t len) {
+    if (r->textLen + len + 1 > r->textCapacity) {
+        while (r->textLen + len + 1 > r->textCapacity) r->textCapacity = r->textCapacity ? r->textCapacity * 2 : 256;
+        r->text = (char*) realloc(r->text, r->textCapacity);
     }
+    memcpy(r->text + r->textLen, s, len);
+    r->textLen += len;
+    r->text[r->textLen] = '\0';
 }
 
-// Function to import from PNML
-void importPNML(PetriNet* net, const char* filename) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        printf("Error opening file: %s\n", filename);
-        return;
+static ElementKind classifyElement(PnmlReader *r, const char *name, size_t len) {
+    ElementKind parent = r->depth > 0 ? r->stack[r->depth - 1] : EL_OTHER;
+    const char *colon = memchr(name, ':', len);
+    if (colon) { // Drop namespace prefixes
+        len -= (size_t) (colon + 1 - name);
+        name = colon + 1;
     }
+#define TAG_IS(s) (len == sizeof(s) - 1 && strncmp(name, s, len) == 0)
+    if (TAG_IS("net")) return EL_NET;
+    if (TAG_IS("page")) return EL_PAGE;
+    if (TAG_IS("place")) return parent == EL_MARKING ? EL_MARKING_PLACE : EL_PLACE;
+    if (TAG_IS("transition")) return EL_TRANSITION;
+    if (TAG_IS("arc")) return EL_ARC;
+    if (TAG_IS("name")) return EL_NAME;
+    if (TAG_IS("text")) return EL_TEXT;
+    if (TAG_IS("initialMarking")) return EL_INITIAL_MARKING;
+    if (TAG_IS("inscription")) return EL_INSCRIPTION;
+    if (TAG_IS("toolspecific")) return EL_TOOLSPECIFIC;
+    if (TAG_IS("finalmarkings")) return EL_FINAL_MARKINGS;
+    if (TAG_IS("marking")) return EL_MARKING;
+    if (TAG_IS("referencePlace") || TAG_IS("referenceTransition")) return EL_REFERENCE;
+#undef TAG_IS
+    return EL_OTHER;
+}
 
-    char line[256], id[50], name[100], source[50], target[50];
-    int initialMarking = 0, finalMarking = 0, visible = 1;
+// Called for every start tag
+static void startElement(PnmlReader *r, PetriNet *net, ElementKind kind, XmlAttribute *attrs, int count) {
+    ElementKind parent = r->depth > 0 ? r->stack[r->depth - 1] : EL_OTHER;
+    switch (kind) {
+    case EL_NET:
+        xml_get_attribute(attrs, count, "id", net->id, sizeof(net->id));
+        break;
+    case EL_PLACE:
+        r->id[0] = '\0';
+        xml_get_attribute(attrs, count, "id", r->id, sizeof(r->id));
+        copyField(r->name, sizeof(r->name), r->id);
+        r->marking = 0;
+        break;
+    case EL_TRANSITION:
+        r->id[0] = '\0';
+        xml_get_attribute(attrs, count, "id", r->id, sizeof(r->id));
+        r->name[0] = '\0';
+        r->localNodeID[0] = '\0';
+        r->visible = 1;
+        break;
+    case EL_ARC:
+        r->id[0] = r->source[0] = r->target[0] = '\0';
+        xml_get_attribute(attrs, count, "id", r->id, sizeof(r->id));
+        xml_get_attribute(attrs, count, "source", r->source, sizeof(r->source));
+        xml_get_attribute(attrs, count, "target", r->target, sizeof(r->target));
+        r->weight = 1;
+        break;
+    case EL_TOOLSPECIFIC:
+        if (parent == EL_TRANSITION) {
+            char activity[50];
+            if (xml_get_attribute(attrs, count, "activity", activity, sizeof(activity)) && strcmp(activity, "$invisible$") == 0) {
+                r->visible = 0;
+                xml_get_attribute(attrs, count, "localNodeID", r->localNodeID, sizeof(r->localNodeID));
+            }
+        }
+        break;
+    case EL_MARKING_PLACE:
+        r->id[0] = '\0';
+        xml_get_attribute(attrs, count, "idref", r->id, sizeof(r->id));
+        r->marking = 0;
+        break;
+    case EL_REFERENCE:
+        if (r->aliasCount >= r->aliasCapacity) {
+            r->aliasCapacity = r->aliasCapacity ? r->aliasCapacity * 2 : 16;
+            r->aliases = (NodeAlias*) realloc(r->aliases, sizeof(NodeAlias) * r->aliasCapacity);
+        }
+        r->aliases[r->aliasCount].id[0] = r->aliases[r->aliasCount].ref[0] = '\0';
+        xml_get_attribute(attrs, count, "id", r->aliases[r->aliasCount].id, sizeof(r->aliases[0].id));
+        xml_get_attribute(attrs, count, "ref", r->aliases[r->aliasCount].ref, sizeof(r->aliases[0].ref));
+        r->aliasCount++;
+        break;
+    case EL_TEXT:
+        r->textLen = 0;
+        if (r->text) r->text[0] = '\0';
+        break;
+    default:
+        break;
+    }
+}
 
-    while (fgets(line, sizeof(line), file)) {
-        if (strstr(line, "<place")) {
-            sscanf(line, " <place id=\"%49[^\"]", id);
-            fgets(line, sizeof(line), file); // Read the next line
-            initialMarking = 0;
-            if (strstr(line, "<initialMarking>")) {
-                sscanf(line, " <initialMarking><text>%d</text></initialMarking>", &initialMarking);
+// Called for every end tag (and for self-closing tags); the element is still on the stack
+static void endElement(PnmlReader *r, PetriNet *net) {
+    ElementKind kind = r->stack[r->depth - 1];
+    ElementKind parent = r->depth > 1 ? r->stack[r->depth - 2] : EL_OTHER;
+    ElementKind grandparent = r->depth > 2 ? r->stack[r->depth - 3] : EL_OTHER;
+    switch (kind) {
+    case EL_TEXT: {
+        char value[100];
+        xml_decode_entities(value, sizeof(value), r->text ? r->text : "", r->textLen);
+        if (parent == EL_NAME) {
+            if (grandparent == EL_PLACE || grandparent == EL_TRANSITION) {
+                copyField(r->name, sizeof(r->name), value);
+            } else if (grandparent == EL_NET) {
+                copyField(net->name, sizeof(net->name), value);
             }
-            addPlace(net, id, initialMarking);
-        } else if (strstr(line, "<transition")) {
-            sscanf(line, " <transition id=\"%49[^\"]", id);
-            fgets(line, sizeof(line), file); // Read the name or next line
-            name[0] = '\0'; // Initialize name
-            if (strstr(line, "<name>")) {
-                fgets(line, sizeof(line), file); // Read the actual <text> line
-                extractText(line, name);
+        } else if (parent == EL_INITIAL_MARKING && grandparent == EL_PLACE) {
+            r->marking = atoi(value);
+        } else if (parent == EL_INSCRIPTION && grandparent == EL_ARC) {
+            r->weight = atoi(value);
+        } else if (parent == EL_MARKING_PLACE) {
+            r->marking = atoi(value);
+        }
+        break;
+    }
+    case EL_PLACE:
+        addNamedPlace(net, r->id, r->name, r->marking);
+        break;
+    case EL_TRANSITION:
+        addTransition(net, r->id, r->name, r->visible);
+        copyField(net->lastTransition->localNodeID, sizeof(net->lastTransition->localNodeID), r->localNodeID);
+        break;
+    case EL_ARC:
+        addArc(net, r->id, r->source, r->target);
+        net->lastArc->weight = r->weight;
+        break;
+    case EL_MARKING_PLACE:
+        addFinalMarking(net, r->id, r->marking);
+        break;
+    default:
+        break;
+    }
+}
+
+static int compareAliases(const void *a, const void *b) {
+    return strcmp(((const NodeAlias*) a)->id, ((const NodeAlias*) b)->id);
+}
+
+// Rewrites arc endpoints that point to reference nodes (multi-page nets)
+static void resolveAliases(PnmlReader *r, PetriNet *net) {
+    if (r->aliasCount == 0) return;
+    qsort(r->aliases, r->aliasCount, sizeof(NodeAlias), compareAliases);
+    for (Arc *a = net->arcs; a; a = a->next) {
+        char *ends[2] = { a->source, a->target };
+        for (int e = 0; e < 2; e++) {
+            // Follow chains of references, bounded to avoid cycles
+            for (int hops = 0; hops < r->aliasCount; hops++) {
+                NodeAlias key;
+                copyField(key.id, sizeof(key.id), ends[e]);
+                NodeAlias *alias = (NodeAlias*) bsearch(&key, r->aliases, r->aliasCount, sizeof(NodeAlias), compareAliases);
+                if (!alias) break;
+                copyField(ends[e], 50, alias->ref);
+            }
+        }
+    }
+}
+
+// Function to import from PNML: 0 if imported, -1 if the file can not be read
+int importPNML(PetriNet* net, const char* filename) {
+    char *buffer = xml_read_file(filename);
+    if (!buffer) {
+        fprintf(stderr, "Error opening file: %s\n", filename);
+        return -1;
+    }
+
+    PnmlReader r;
+    memset(&r, 0, sizeof(r));
+    XmlAttribute attrs[PNML_MAX_ATTRIBUTES];
+    char *p = buffer;
+
+    while (*p) {
+        if (*p != '<') {
+            // Character data: only the content of <text> elements is kept
+            char *lt = strchr(p, '<');
+            if (!lt) break;
+            if (r.depth > 0 && r.stack[r.depth - 1] == EL_TEXT) appendText(&r, p, (size_t) (lt - p));
+            p = lt;
+            continue;
+        }
+        if (strncmp(p, "<!--", 4) == 0) {
+            char *end = strstr(p + 4, "-->");
+            p = end ? end + 3 : p + strlen(p);
+        } else if (strncmp(p, "<![CDATA[", 9) == 0) {
+            char *end = strstr(p + 9, "]]>");
+            if (!end) break;
+            if (r.depth > 0 && r.stack[r.depth - 1] == EL_TEXT) appendText(&r, p + 9, (size_t) (end - p - 9));
+            p = end + 3;
+        } else if (p[1] == '?' || p[1] == '!') {
+            char *end = strchr(p, '>');
+            p = end ? end + 1 : p + strlen(p);
+        } else if (p[1] == '/') {
+            char *end = strchr(p, '>');
+            if (r.depth > 0) {
+                endElement(&r, net);
+                r.depth--;
             }
-            visible = 1; // Assume visible unless specified
-            if (fgets(line, sizeof(line), file) && strstr(line, "activity=\"$invisible$\"")) {
-                visible = 0;
+            p = end ? end + 1 : p + strlen(p);
+        } else {
+            char *name = p + 1;
+            char *q = name;
+            while (*q && *q != '>' && *q != '/' && !xml_is_space(*q)) q++;
+            ElementKind kind = classifyElement(&r, name, (size_t) (q - name));
+            int count, selfClosing;
+            p = xml_parse_attributes(q, attrs, PNML_MAX_ATTRIBUTES, &count, &selfClosing);
+            startElement(&r, net, kind, attrs, count);
+            if (r.depth < PNML_MAX_DEPTH) {
+                r.stack[r.depth++] = kind;
+                if (selfClosing) {
+                    endElement(&r, net);
+                    r.depth--;
+                }
             }
-            addTransition(net, id, name, visible);
-        } else if (strstr(line, "<arc")) {
-            sscanf(line, " <arc id=\"%49[^\"]\" source=\"%49[^\"]\" target=\"%49[^\"]\"", id, source, target);
-            addArc(net, id, source, target);
-        } else if (strstr(line, "<finalmarkings>")) {
-            fgets(line, sizeof(line), file); // Read the <marking> line
-            sscanf(line, " <place idref=\"%49[^\"]", id);
-            fgets(line, sizeof(line), file); // Read the final marking text line
-            sscanf(line, " <text>%d</text>", &finalMarking);
-            addFinalMarking(net, id, finalMarking);
         }
     }
-    fclose(file);
+
+    resolveAliases(&r, net);
+    free(r.aliases);
+    free(r.text);
+    free(buffer);
+    return 0;
 }
 
+/*
+ * PNML writer
+ *
+ * All output goes through a single buffer (XmlWriter of c_xml.h) that is flushed with fwrite
+ * when full, instead of issuing several fprintf calls per element.
+ */
+
 // Function to export to PNML
 void exportPNML(PetriNet* net, const char* filename) {
     FILE *file = fopen(filename, "w");
@@ -167,87 +366,100 @@ void exportPNML(PetriNet* net, const char* filename) {
         return;
     }
 
-    fprintf(file, "<?xml version='1.0' encoding='UTF-8'?>\n<pnml>\n  <net id=\"generated_net\" type=\"http://www.pnml.org/version-2009/grammar/pnmlcoremodel\">\n    <page id=\"n0\">\n");
+    XmlWriter *w = (XmlWriter*) malloc(sizeof(XmlWriter));
+    w->file = file;
+    w->len = 0;
+
+    const char *netId = net->id[0] ? net->id : "generated_net";
+    xml_write_string(w, "<?xml version='1.0' encoding='UTF-8'?>\n<pnml>\n  <net id=\"");
+    xml_write_escaped(w, netId);
+    xml_write_string(w, "\" type=\"http://www.pnml.org/version-2009/grammar/pnmlcoremodel\">\n");
+    if (net->name[0]) {
+        xml_write_string(w, "    <name>\n      <text>");
+        xml_write_escaped(w, net->name);
+        xml_write_string(w, "</text>\n    </name>\n");
+    }
+    xml_write_string(w, "    <page id=\"n0\">\n");
 
     // Export places
-    Place* p = net->places;
-    while (p) {
-        fprintf(file, "      <place id=\"%s\">\n        <name>\n          <text>%s</text>\n        </name>\n", p->id, p->id);
+    for (Place* p = net->places; p; p = p->next) {
+        xml_write_string(w, "      <place id=\"");
+        xml_write_escaped(w, p->id);
+        xml_write_string(w, "\">\n        <name>\n          <text>");
+        xml_write_escaped(w, p->name);
+        xml_write_string(w, "</text>\n        </name>\n");
         if (p->initialMarking) {
-            fprintf(file, "        <initialMarking>\n          <text>%d</text>\n        </initialMarking>\n", p->initialMarking);
+            xml_write_string(w, "        <initialMarking>\n          <text>");
+            xml_write_int(w, p->initialMarking);
+            xml_write_string(w, "</text>\n        </initialMarking>\n");
         }
-        fprintf(file, "      </place>\n");
-        p = p->next;
+        xml_write_string(w, "      </place>\n");
     }
 
     // Export transitions
-    Transition* t = net->transitions;
-    while (t) {
-        fprintf(file, "      <transition id=\"%s\">\n        <name>\n          <text>%s</text>\n        </name>\n", t->id, t->name);
+    for (Transition* t = net->transitions; t; t = t->next) {
+        xml_write_string(w, "      <transition id=\"");
+        xml_write_escaped(w, t->id);
+        xml_write_string(w, "\">\n        <name>\n          <text>");
+        xml_write_escaped(w, t->name);
+        xml_write_string(w, "</text>\n        </name>\n");
         if (!t->visible) {
-            fprintf(file, "        <toolspecific tool=\"ProM\" version=\"6.4\" activity=\"$invisible$\"/>\n");
+            xml_write_string(w, "        <toolspecific tool=\"ProM\" version=\"6.4\" activity=\"$invisible$\"");
+            if (t->localNodeID[0]) {
+                xml_write_string(w, " localNodeID=\"");
+                xml_write_escaped(w, t->localNodeID);
+                xml_write_string(w, "\"");
+            }
+            xml_write_string(w, "/>\n");
         }
-        fprintf(file, "      </transition>\n");
-        t = t->next;
+        xml_write_string(w, "      </transition>\n");
     }
 
     // Export arcs
-    Arc* a = net->arcs;
-    while (a) {
-        fprintf(file, "      <arc id=\"%s\" source=\"%s\" target=\"%s\"/>\n", a->id, a->source, a->target);
-        a = a->next;
+    for (Arc* a = net->arcs; a; a = a->next) {
+        xml_write_string(w, "      <arc id=\"");
+        xml_write_escaped(w, a->id);
+        xml_write_string(w, "\" source=\"");
+        xml_write_escaped(w, a->source);
+        xml_write_string(w, "\" target=\"");
+        xml_write_escaped(w, a->target);
+        if (a->weight != 1) {
+            xml_write_string(w, "\">\n        <inscription>\n          <text>");
+            xml_write_int(w, a->weight);
+            xml_write_string(w, "</text>\n        </inscription>\n      </arc>\n");
+        } else {
+            xml_write_string(w, "\"/>\n");
+        }
     }
 
-    fprintf(file, "    </page>\n");
+    xml_write_string(w, "    </page>\n");
 
-    // Final markings section
+    // Final markings section (a single marking listing all its places)
     if (net->finalMarkings) {
-        fprintf(file, "    <finalmarkings>\n");
-        FinalMarking* f = net->finalMarkings;
-        while (f) {
-            fprintf(file, "      <marking>\n        <place idref=\"%s\">\n          <text>%d</text>\n        </place>\n      </marking>\n", f->place_id, f->finalMarking);
-            f = f->next;
+        xml_write_string(w, "    <finalmarkings>\n      <marking>\n");
+        for (FinalMarking* f = net->finalMarkings; f; f = f->next) {
+            xml_write_string(w, "        <place idref=\"");
+            xml_write_escaped(w, f->place_id);
+            xml_write_string(w, "\">\n          <text>");
+            xml_write_int(w, f->finalMarking);
+            xml_write_string(w, "</text>\n        </place>\n");
         }
-        fprintf(file, "    </finalmarkings>\n");
+        xml_write_string(w, "      </marking>\n    </finalmarkings>\n");
     }
 
-    fprintf(file, "  </net>\n</pnml>\n");
+    xml_write_string(w, "  </net>\n</pnml>\n");
+    xml_writer_flush(w);
+    free(w);
     fclose(file);
 }
 
 // Function to free the memory
 void freePetriNet(PetriNet* net) {
-    Place* p = net->places;
-    while (p) {
-        Place* tmp = p;
-        p = p->next;
-        free(tmp);
-    }
-
-    Transition* t = net->transitions;
-    while (t) {
-        Transition* tmp = t;
-        t = t->next;
-        free(tmp);
-    }
-
-    Arc* a = net->arcs;
-    while (a) {
-        Arc* tmp = a;
-        a = a->next;
-        free(tmp);
-    }
-
-    FinalMarking* f = net->finalMarkings;
-    while (f) {
-        FinalMarking* tmp = f;
-        f = f->next;
-        free(tmp);
-    }
-
+    arena_release(&net->arena);
     free(net);
 }
 
+#ifndef K_LIB
 int main(int argc, char* argv[]) {
     if (argc != 3) {
         printf("Usage: %s <input_pnml> <output_pnml>\n", argv[0]);
@@ -255,9 +467,13 @@ int main(int argc, char* argv[]) {
     }
 
     PetriNet* net = createPetriNet();
-    importPNML(net, argv[1]);
+    if (importPNML(net, argv[1]) != 0) {
+        freePetriNet(net);
+        return 1;
+    }
     exportPNML(net, argv[2]);
     freePetriNet(net);
 
     return 0;
 }
+#endif
@@ -0,0 +1,88 @@
+#ifndef C_PNML_H
+#define C_PNML_H
+
+#include "c_arena.h"
+
+/*
+signature of Petri net methods:
+
+PetriNet* createPetriNet();
+void addPlace(PetriNet* net, char* id, int initialMarking);
+void addNamedPlace(PetriNet* net, char* id, char* name, int initialMarking);
+void addTransition(PetriNet* net, char* id, char* name, int visible);
+void addArc(PetriNet* net, char* id, char* source, char* target);
+void addFinalMarking(PetriNet* net, char* place_id, int finalMarking);
+
+int importPNML(PetriNet* net, const char* filename);
+void exportPNML(PetriNet* net, const char* filename);
+void freePetriNet(PetriNet* net);
+
+Elements are kept in insertion order, so an import followed by an export
+reproduces places, transitions and arcs in the order of the input file.
+They are allocated from the arena of the net (c_arena.h) and freed together
+by freePetriNet.
+
+To link c_pnml.c into another program, compile it with -DK_LIB (leaves out its main).
+*/
+
+// Structure for a Place
+typedef struct Place {
+    char id[50];
+    char name[100]; // Place label (name)
+    int initialMarking;
+    struct Place *next;
+} Place;
+
+// Structure for a Final Marking
+typedef struct FinalMarking {
+    char place_id[50];
+    int finalMarking;
+    struct FinalMarking *next;
+} FinalMarking;
+
+// Structure for a Transition
+typedef struct Transition {
+    char id[50];
+    char name[100]; // Transition label (name)
+    int visible; // 1 if visible, 0 if invisible
+    char localNodeID[50]; // ProM localNodeID of invisible transitions (may be empty)
+    struct Transition *next;
+} Transition;
+
+// Structure for an Arc
+typedef struct Arc {
+    char id[50];
+    char source[50];
+    char target[50];
+    int weight; // Arc inscription (1 unless specified)
+    struct Arc *next;
+} Arc;
+
+// Structure for a Petri Net
+typedef struct PetriNet {
+    char id[100];
+    char name[100];
+    Place *places;
+    Transition *transitions;
+    Arc *arcs;
+    FinalMarking *finalMarkings;
+    // Tails of the lists above, used to append in O(1)
+    Place *lastPlace;
+    Transition *lastTransition;
+    Arc *lastArc;
+    FinalMarking *lastFinalMarking;
+    Arena arena; // Places, transitions, arcs and final markings
+} PetriNet;
+
+PetriNet* createPetriNet();
+void addPlace(PetriNet* net, char* id, int initialMarking);
+void addNamedPlace(PetriNet* net, char* id, char* name, int initialMarking);
+void addTransition(PetriNet* net, char* id, char* name, int visible);
+void addArc(PetriNet* net, char* id, char* source, char* target);
+void addFinalMarking(PetriNet* net, char* place_id, int finalMarking);
+
+int importPNML(PetriNet* net, const char* filename);
+void exportPNML(PetriNet* net, const char* filename);
+void freePetriNet(PetriNet* net);
+
+#endif
@@ -0,0 +1,339 @@
+/*
+ * Prefix tree - index of the trace prefixes of an EncodedLog (see c_prefix_tree.h)
+ * Implemented in C with POSIX mmap for loading
+ *
+ * **Main Components:**
+
+- **Build:**
+  - Level by level over the CSR log, starting with all cases at the root. The cases of the
+    nodes of a level are sorted by their activity at that depth with two stable counting
+    sorts (by activity, then by node), which splits the range of each node into the cases
+    ending there and one run per child, in activity order. A child's range is a subrange
+    of its parent's, so one case array serves all nodes (the sorts are stable, so the cases
+    ending at a node and those of each leaf stay in ascending order). Each level costs
+    O(cases at the level + activities), the whole build O(events + depth * activities), and
+    no node is allocated one by one.
+
+- **Queries:**
+  - A prefix is found by binary search among the sorted children, one level per activity;
+    counts, next-activity distributions and case lists are then read off the node.
+
+- **File:**
+  - A fixed header (magic, version, byte-order mark, sizes), the nodes, the cases and the
+    activity names (NUL-terminated), each section 8-byte aligned. Loading maps the file
+    read-only and checks the header and the sizes against the file size, and the child, case
+    and activity references of every node once, so the queries can trust them; only the name
+    pointers are allocated.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "c_prefix_tree.h"
+
+#define PREFIX_TREE_MAGIC "KPTR"
+#define PREFIX_TREE_VERSION 1
+#define PREFIX_TREE_BYTE_ORDER 0x01020304u
+
+typedef struct {
+    char magic[4];
+    unsigned int version;
+    unsigned int byte_order;    /* PREFIX_TREE_BYTE_ORDER as written */
+    int node_count;
+    int case_count;
+    int activity_count;
+    long long names_size;       /* bytes of the names, with their terminators */
+} PrefixTreeHeader;
+
+#define ALIGN8(n) (((n) + 7) & ~(size_t)7)
+
+/* Build */
+
+PrefixTree *build_prefix_tree(const EncodedLog *enc) {
+    int n = enc->case_count;
+    int alphabet = enc->dictionary.count;
+    PrefixTree *tree = (PrefixTree *)calloc(1, sizeof(PrefixTree));
+    tree->case_count = n;
+    tree->cases = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    for (int c = 0; c < n; c++) tree->cases[c] = c;
+    tree->activity_count = alphabet;
+    tree->activities = (char **)malloc(sizeof(char *) * (alphabet > 0 ? alphabet : 1));
+    for (int a = 0; a < alphabet; a++) tree->activities[a] = strdup(enc->dictionary.names[a]);
+
+    /* At most one node per event, plus the root */
+    tree->nodes = (PrefixNode *)malloc(sizeof(PrefixNode) * ((size_t)enc->event_count + 1));
+    PrefixNode *root = &tree->nodes[0];
+    root->activity = -1;
+    root->parent = -1;
+    root->depth = 0;
+    root->first_child = -1;
+    root->child_count = 0;
+    root->case_from = 0;
+    root->case_to = n;
+    root->end_count = 0;
+    tree->node_count = 1;
+
+    /* Cases of the level: case, activity at the depth (-1 if the case ends) and node in the level */
+    int *item_case = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *item_key = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *item_node = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *by_key = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *by_node = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *counts = (int *)malloc(sizeof(int) * ((n > alphabet ? n : alphabet) + 2));
+
+    int level_from = 0, level_to = 1;
+    for (int depth = 0; level_from < level_to; depth++) {
+        int items = 0;
+        for (int v = level_from; v < level_to; v++) {
+            for (int i = tree->nodes[v].case_from; i < tree->nodes[v].case_to; i++) {
+                int c = tree->cases[i];
+                int offset = enc->case_offsets[c] + depth;
+                item_case[items] = c;
+                item_key[items] = offset < enc->case_offsets[c + 1] ? enc->events[offset] : -1;
+                item_node[items] = v - level_from;
+                items++;
+            }
+        }
+
+        /* Stable counting sort by activity (ending cases first), then by node */
+        memset(counts, 0, sizeof(int) * (alphabet + 2));
+        for (int i = 0; i < items; i++) counts[item_key[i] + 2]++;
+        for (int k = 1; k < alphabet + 2; k++) counts[k] += counts[k - 1];
+        for (int i = 0; i < items; i++) by_key[counts[item_key[i] + 1]++] = i;
+
+        int level_nodes = level_to - level_from;
+        memset(counts, 0, sizeof(int) * (level_nodes + 1));
+        for (int i = 0; i < items; i++) counts[item_node[i] + 1]++;
+        for (int k = 1; k <= level_nodes; k++) counts[k] += counts[k - 1];
+        for (int i = 0; i < items; i++) by_node[counts[item_node[by_key[i]]]++] = by_key[i];
+
+        /* Write the ranges back and split them into the ending cases and the children */
+        int next = 0;
+        for (int v = level_from; v < level_to; v++) {
+            PrefixNode *node = &tree->nodes[v];
+            int i = node->case_from;
+            node->first_child = tree->node_count;
+            while (i < node->case_to) {
+                int key = item_key[by_node[next]];
+                int run_from = i;
+                while (i < node->case_to && item_key[by_node[next]] == key) tree->cases[i++] = item_case[by_node[next++]];
+                if (key < 0) {
+                    node->end_count = i - run_from;
+                    continue;
+                }
+                PrefixNode *child = &tree->nodes[tree->node_count++];
+                child->activity = key;
+                child->parent = v;
+                child->depth = depth + 1;
+                child->first_child = -1;
+                child->child_count = 0;
+                child->case_from = run_from;
+                child->case_to = i;
+                child->end_count = 0;
+                node->child_count++;
+            }
+            if (node->child_count == 0) node->first_child = -1;
+        }
+        level_from = level_to;
+        level_to = tree->node_count;
+    }
+
+    free(item_case);
+    free(item_key);
+    free(item_node);
+    free(by_key);
+    free(by_node);
+    free(counts);
+    tree->nodes = (PrefixNode *)realloc(tree->nodes, sizeof(PrefixNode) * tree->node_count);
+    return tree;
+}
+
+void free_prefix_tree(PrefixTree *tree) {
+    if (tree->map) {
+        munmap(tree->map, tree->map_size);
+    } else {
+        free(tree->nodes);
+        free(tree->cases);
+        for (int a = 0; a < tree->activity_count; a++) free(tree->activities[a]);
+    }
+    free(tree->activities);
+    free(tree);
+}
+
+/* File */
+
+static size_t nodes_offset(void) {
+    return ALIGN8(sizeof(PrefixTreeHeader));
+}
+
+static size_t cases_offset(int node_count) {
+    return nodes_offset() + ALIGN8(sizeof(PrefixNode) * (size_t)node_count);
+}
+
+static size_t names_offset(int node_count, int case_count) {
+    return cases_offset(node_count) + ALIGN8(sizeof(int) * (size_t)case_count);
+}
+
+int save_prefix_tree(const PrefixTree *tree, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        perror("Failed to open output file");
+        return -1;
+    }
+
+    PrefixTreeHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PREFIX_TREE_MAGIC, 4);
+    header.version = PREFIX_TREE_VERSION;
+    header.byte_order = PREFIX_TREE_BYTE_ORDER;
+    header.node_count = tree->node_count;
+    header.case_count = tree->case_count;
+    header.activity_count = tree->activity_count;
+    for (int a = 0; a < tree->activity_count; a++) header.names_size += strlen(tree->activities[a]) + 1;
+
+    static const char padding[8];
+    size_t nodes_size = sizeof(PrefixNode) * (size_t)tree->node_count;
+    size_t cases_size = sizeof(int) * (size_t)tree->case_count;
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(padding, 1, nodes_offset() - sizeof(header), fp);
+    fwrite(tree->nodes, 1, nodes_size, fp);
+    fwrite(padding, 1, ALIGN8(nodes_size) - nodes_size, fp);
+    fwrite(tree->cases, 1, cases_size, fp);
+    fwrite(padding, 1, ALIGN8(cases_size) - cases_size, fp);
+    for (int a = 0; a < tree->activity_count; a++) fwrite(tree->activities[a], 1, strlen(tree->activities[a]) + 1, fp);
+
+    int status = ferror(fp) ? -1 : 0;
+    if (fclose(fp) != 0) status = -1;
+    if (status != 0) fprintf(stderr, "Failed to write %s\n", filename);
+    return status;
+}
+
+/*
+ * 1 if the nodes of a mapped file can be queried without leaving the arrays: child and case
+ * ranges within bounds, activities known (leaves have first_child -1 and no children)
+ */
+static int valid_prefix_nodes(const PrefixNode *nodes, int node_count, int case_count, int activity_count) {
+    for (int i = 0; i < node_count; i++) {
+        const PrefixNode *v = &nodes[i];
+        if (v->child_count < 0 || v->end_count < 0) return 0;
+        if (v->child_count > 0 && (v->first_child < 0 || (long long)v->first_child + v->child_count > node_count)) return 0;
+        if (v->case_from < 0 || v->case_from > v->case_to || v->case_to > case_count) return 0;
+        if (v->end_count > v->case_to - v->case_from) return 0;
+        if (v->activity < -1 || v->activity >= activity_count) return 0;
+    }
+    return 1;
+}
+
+PrefixTree *load_prefix_tree(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open input file");
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(PrefixTreeHeader)) {
+        fprintf(stderr, "Not a prefix tree: %s\n", filename);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("Failed to map input file");
+        return NULL;
+    }
+
+    const PrefixTreeHeader *header = (const PrefixTreeHeader *)map;
+    const char *error = NULL;
+    if (memcmp(header->magic, PREFIX_TREE_MAGIC, 4) != 0) error = "not a prefix tree";
+    else if (header->version != PREFIX_TREE_VERSION) error = "unsupported version";
+    else if (header->byte_order != PREFIX_TREE_BYTE_ORDER) error = "written with another byte order";
+    else if (header->node_count < 1 || header->case_count < 0 || header->activity_count < 0 || header->names_size < 0 ||
+             names_offset(header->node_count, header->case_count) + (size_t)header->names_size > size) error = "truncated";
+    else if (!valid_prefix_nodes((const PrefixNode *)((const char *)map + nodes_offset()), header->node_count,
+                                 header->case_count, header->activity_count)) error = "corrupt nodes";
+    if (error) {
+        fprintf(stderr, "Cannot load %s: %s\n", filename, error);
+        munmap(map, size);
+        return NULL;
+    }
+
+    PrefixTree *tree = (PrefixTree *)calloc(1, sizeof(PrefixTree));
+    tree->map = map;
+    tree->map_size = size;
+    tree->node_count = header->node_count;
+    tree->case_count = header->case_count;
+    tree->activity_count = header->activity_count;
+    tree->nodes = (PrefixNode *)((char *)map + nodes_offset());
+    tree->cases = (int *)((char *)map + cases_offset(tree->node_count));
+
+    /* Name pointers into the mapping; every name must be terminated within the file */
+    tree->activities = (char **)malloc(sizeof(char *) * (tree->activity_count > 0 ? tree->activity_count : 1));
+    char *name = (char *)map + names_offset(tree->node_count, tree->case_count);
+    char *names_end = name + header->names_size;
+    for (int a = 0; a < tree->activity_count; a++) {
+        char *terminator = name < names_end ? (char *)memchr(name, '\0', names_end - name) : NULL;
+        if (!terminator) {
+            fprintf(stderr, "Cannot load %s: truncated\n", filename);
+            free_prefix_tree(tree);
+            return NULL;
+        }
+        tree->activities[a] = name;
+        name = terminator + 1;
+    }
+    return tree;
+}
+
+/* Queries */
+
+int prefix_tree_activity(const PrefixTree *tree, const char *name) {
+    for (int a = 0; a < tree->activity_count; a++) {
+        if (strcmp(tree->activities[a], name) == 0) return a;
+    }
+    return -1;
+}
+
+int prefix_child(const PrefixTree *tree, int node, int activity) {
+    const PrefixNode *v = &tree->nodes[node];
+    int lo = v->first_child, hi = v->first_child + v->child_count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        int a = tree->nodes[mid].activity;
+        if (a == activity) return mid;
+        if (a < activity) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+int find_prefix(const PrefixTree *tree, const int *prefix, int length) {
+    int node = 0;
+    for (int i = 0; i < length && node >= 0; i++) node = prefix_child(tree, node, prefix[i]);
+    return node;
+}
+
+int prefix_case_count(const PrefixTree *tree, const int *prefix, int length) {
+    int node = find_prefix(tree, prefix, length);
+    return node < 0 ? 0 : tree->nodes[node].case_to - tree->nodes[node].case_from;
+}
+
+const int *prefix_cases(const PrefixTree *tree, int node, int *count) {
+    *count = tree->nodes[node].case_to - tree->nodes[node].case_from;
+    return tree->cases + tree->nodes[node].case_from;
+}
+
+int next_activities(const PrefixTree *tree, int node, int *activities, int *counts) {
+    const PrefixNode *v = &tree->nodes[node];
+    for (int i = 0; i < v->child_count; i++) {
+        const PrefixNode *child = &tree->nodes[v->first_child + i];
+        activities[i] = child->activity;
+        counts[i] = child->case_to - child->case_from;
+    }
+    return v->child_count;
+}
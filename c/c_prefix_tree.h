@@ -0,0 +1,74 @@
+/*
+ * Prefix tree - index of the trace prefixes of an EncodedLog
+ *
+ * Every node is a prefix (activity sequence) that starts at least one case;
+ * the root is the empty prefix. The nodes are one flat array in breadth-first
+ * order: the children of a node are a contiguous range sorted by activity
+ * (binary search), and the cases of a node (the cases that start with its
+ * prefix) are a contiguous range of one case array: first the cases that end
+ * at the node, then the ranges of the children in order, each group in
+ * ascending case order. A query returns ranges of these arrays, never copies.
+ * Library module without a main.
+ *
+ * A tree is saved to a binary file (header, nodes, cases, activity names) and
+ * loaded back with mmap, without parsing: the arrays of a loaded tree point
+ * into the mapping. The file is in the byte order of the machine that wrote it.
+ */
+
+#ifndef C_PREFIX_TREE_H
+#define C_PREFIX_TREE_H
+
+#include <stddef.h>
+
+#include "c_xes.h"
+
+typedef struct {
+    int activity;           /* last activity of the prefix (-1 for the root) */
+    int parent;             /* -1 for the root */
+    int depth;              /* prefix length */
+    int first_child;        /* children: first_child .. first_child + child_count - 1 */
+    int child_count;
+    int case_from;          /* cases with the prefix: cases[case_from .. case_to) */
+    int case_to;
+    int end_count;          /* the first end_count of them end with the prefix */
+} PrefixNode;
+
+typedef struct {
+    PrefixNode *nodes;      /* node 0 is the root */
+    int node_count;
+    int *cases;             /* case ids (indices of the log) */
+    int case_count;
+    char **activities;      /* activity id -> name */
+    int activity_count;
+
+    void *map;              /* mapping of a loaded tree (NULL if built) */
+    size_t map_size;
+} PrefixTree;
+
+PrefixTree *build_prefix_tree(const EncodedLog *enc);
+void free_prefix_tree(PrefixTree *tree);
+
+/* Write tree to filename: 0 on success */
+int save_prefix_tree(const PrefixTree *tree, const char *filename);
+/* Map a saved tree; NULL on error */
+PrefixTree *load_prefix_tree(const char *filename);
+
+/* Activity id of a name, -1 if not in the tree */
+int prefix_tree_activity(const PrefixTree *tree, const char *name);
+/* Child of node with activity, -1 if none */
+int prefix_child(const PrefixTree *tree, int node, int activity);
+/* Node of a prefix (activity ids), -1 if no case starts with it */
+int find_prefix(const PrefixTree *tree, const int *prefix, int length);
+
+/* Number of cases that start with prefix */
+int prefix_case_count(const PrefixTree *tree, const int *prefix, int length);
+/* Cases that start with the prefix of node: sets *count, returns a range of tree->cases */
+const int *prefix_cases(const PrefixTree *tree, int node, int *count);
+/*
+ * Next-activity distribution after node: writes the activities of the children and the number
+ * of cases continuing with each to activities and counts (child_count entries, by activity) and
+ * returns their number; the cases that end at node are its end_count
+ */
+int next_activities(const PrefixTree *tree, int node, int *activities, int *counts);
+
+#endif
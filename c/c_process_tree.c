@@ -0,0 +1,440 @@
+/*
+ * Process tree data structure with PTML import and export (see process_tree_ptml.txt)
+ * Implemented in ANSI C
+ *
+ * Build: cc -O2 -o c_process_tree c_process_tree.c
+ * Usage: c_process_tree input.ptml output.ptml
+ *
+ * **Main Components:**
+
+- **Flat node array:**
+  - Nodes are stored in a growable array and reference each other by index (see
+    c_process_tree.h); children are appended in O(1) through the last child index.
+
+- **PTML importer:**
+  - The whole file is loaded in memory and scanned tag by tag in a single pass.
+  - The UUIDs of the nodes are resolved through a hash map pointing into the file buffer. A
+    `parentsNode` that refers to a node defined later creates the node in advance; the element
+    fills it in when it is reached. An edge to a node that already has a parent, or one that
+    would close a cycle, makes the import fail.
+  - Labels are interned, so every distinct name is stored once.
+
+- **PTML exporter:**
+  - Writes the nodes reachable from the root (pre-order) and then the `parentsNode` edges,
+    through a single output buffer. Node ids are generated from the pre-order position.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_process_tree.h"
+#include "c_xml.h"
+
+#define INITIAL_NODE_CAPACITY 64
+#define INITIAL_LABEL_CAPACITY 16
+#define PTML_MAX_ATTRIBUTES 16
+
+ProcessTree *create_process_tree(void) {
+    ProcessTree *tree = (ProcessTree *)calloc(1, sizeof(ProcessTree));
+    tree->root = -1;
+    return tree;
+}
+
+/* Make room for at least capacity nodes */
+void reserve_tree_nodes(ProcessTree *tree, int capacity) {
+    if (capacity <= tree->node_capacity) return;
+    tree->nodes = (TreeNode *)realloc(tree->nodes, sizeof(TreeNode) * capacity);
+    tree->node_capacity = capacity;
+}
+
+/* Add a detached node and return its index */
+int add_tree_node(ProcessTree *tree, int op, int label) {
+    if (tree->node_count >= tree->node_capacity) {
+        reserve_tree_nodes(tree, tree->node_capacity ? tree->node_capacity * 2 : INITIAL_NODE_CAPACITY);
+    }
+    TreeNode *node = &tree->nodes[tree->node_count];
+    node->op = op;
+    node->label = label;
+    node->parent = -1;
+    node->first_child = -1;
+    node->last_child = -1;
+    node->next_sibling = -1;
+    return tree->node_count++;
+}
+
+/* Append a label to the label table and return its index (no deduplication) */
+int add_tree_label(ProcessTree *tree, const char *name) {
+    if (tree->label_count >= tree->label_capacity) {
+        tree->label_capacity = tree->label_capacity ? tree->label_capacity * 2 : INITIAL_LABEL_CAPACITY;
+        tree->labels = (char **)realloc(tree->labels, sizeof(char *) * tree->label_capacity);
+    }
+    tree->labels[tree->label_count] = arena_strdup(&tree->label_strings, name);
+    return tree->label_count++;
+}
+
+/* Append child as the last child of parent */
+void add_tree_child(ProcessTree *tree, int parent, int child) {
+    TreeNode *p = &tree->nodes[parent];
+    TreeNode *c = &tree->nodes[child];
+    c->parent = parent;
+    c->next_sibling = -1;
+    if (p->last_child >= 0) tree->nodes[p->last_child].next_sibling = child;
+    else p->first_child = child;
+    p->last_child = child;
+}
+
+/* Detach child from parent (the subtree of child is kept) */
+void remove_tree_child(ProcessTree *tree, int parent, int child) {
+    TreeNode *p = &tree->nodes[parent];
+    int previous = -1;
+    for (int c = p->first_child; c >= 0; previous = c, c = tree->nodes[c].next_sibling) {
+        if (c != child) continue;
+        if (previous >= 0) tree->nodes[previous].next_sibling = tree->nodes[c].next_sibling;
+        else p->first_child = tree->nodes[c].next_sibling;
+        if (p->last_child == c) p->last_child = previous;
+        tree->nodes[c].parent = -1;
+        tree->nodes[c].next_sibling = -1;
+        return;
+    }
+}
+
+void free_process_tree(ProcessTree *tree) {
+    arena_release(&tree->label_strings);
+    free(tree->labels);
+    free(tree->nodes);
+    free(tree);
+}
+
+/*
+ * String map (open addressing, FNV-1a) from a string to an int. Keys are not
+ * copied: they point into the PTML buffer or into the label table.
+ */
+
+typedef struct {
+    const char *key;
+    size_t len;
+    int value;
+} MapEntry;
+
+typedef struct {
+    MapEntry *entries;
+    int count;
+    int capacity;       /* power of two */
+} StringMap;
+
+static unsigned int hash_string(const char *s, size_t len) {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static MapEntry *map_slot(const StringMap *map, const char *key, size_t len) {
+    unsigned int mask = (unsigned int)map->capacity - 1;
+    unsigned int i = hash_string(key, len) & mask;
+    while (map->entries[i].key) {
+        if (map->entries[i].len == len && memcmp(map->entries[i].key, key, len) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return &map->entries[i];
+}
+
+static void map_init(StringMap *map) {
+    map->count = 0;
+    map->capacity = 256;
+    map->entries = (MapEntry *)calloc(map->capacity, sizeof(MapEntry));
+}
+
+/* Value of key, or -1 */
+static int map_get(const StringMap *map, const char *key, size_t len) {
+    MapEntry *e = map_slot(map, key, len);
+    return e->key ? e->value : -1;
+}
+
+static void map_put(StringMap *map, const char *key, size_t len, int value) {
+    if (2 * (map->count + 1) > map->capacity) {
+        /* Keep the load factor at most 1/2 */
+        MapEntry *old = map->entries;
+        int old_capacity = map->capacity;
+        map->capacity *= 2;
+        map->entries = (MapEntry *)calloc(map->capacity, sizeof(MapEntry));
+        for (int i = 0; i < old_capacity; i++) {
+            if (old[i].key) *map_slot(map, old[i].key, old[i].len) = old[i];
+        }
+        free(old);
+    }
+    MapEntry *e = map_slot(map, key, len);
+    if (!e->key) {
+        e->key = key;
+        e->len = len;
+        map->count++;
+    }
+    e->value = value;
+}
+
+/*
+ * PTML reader
+ */
+
+typedef struct {
+    StringMap nodes;        /* node UUID -> node index */
+    StringMap labels;       /* label -> index in the label table */
+    char *defined;          /* defined[i]: node i had its own element */
+    int defined_capacity;
+    const char *root;       /* root attribute of <processTree> */
+    size_t root_len;
+} PtmlReader;
+
+/* Operator of a node element, or -1 if the tag is not a node */
+static int classify_node(const char *name, size_t len) {
+#define TAG_IS(s) (len == sizeof(s) - 1 && strncmp(name, s, len) == 0)
+    if (TAG_IS("manualTask")) return PT_TASK;
+    if (TAG_IS("automaticTask")) return PT_TAU;
+    if (TAG_IS("sequence")) return PT_SEQUENCE;
+    if (TAG_IS("xor")) return PT_XOR;
+    if (TAG_IS("and")) return PT_PARALLEL;
+    if (TAG_IS("or")) return PT_OR;
+    if (TAG_IS("xorLoop") || TAG_IS("loop")) return PT_LOOP;
+#undef TAG_IS
+    return -1;
+}
+
+/* Index of the node with the given UUID, created (undefined) on first reference */
+static int resolve_node(PtmlReader *r, ProcessTree *tree, const char *id, size_t len) {
+    int index = map_get(&r->nodes, id, len);
+    if (index >= 0) return index;
+    index = add_tree_node(tree, PT_TAU, -1);
+    map_put(&r->nodes, id, len, index);
+    if (index >= r->defined_capacity) {
+        int old_capacity = r->defined_capacity;
+        r->defined_capacity = tree->node_capacity;
+        r->defined = (char *)realloc(r->defined, r->defined_capacity);
+        memset(r->defined + old_capacity, 0, r->defined_capacity - old_capacity);
+    }
+    return index;
+}
+
+static int intern_label(PtmlReader *r, ProcessTree *tree, const char *name) {
+    int label = map_get(&r->labels, name, strlen(name));
+    if (label < 0) {
+        label = add_tree_label(tree, name);
+        map_put(&r->labels, tree->labels[label], strlen(name), label);
+    }
+    return label;
+}
+
+/*
+ * Import a PTML file into an empty tree; returns 0 on success, -1 if the file can not be read or
+ * its parentsNode edges do not form a tree (a node with two parents, or a cycle)
+ */
+int import_ptml(ProcessTree *tree, const char *filename) {
+    char *buffer = xml_read_file(filename);
+    if (!buffer) {
+        printf("Error opening file: %s\n", filename);
+        return -1;
+    }
+
+    PtmlReader r;
+    memset(&r, 0, sizeof(r));
+    map_init(&r.nodes);
+    map_init(&r.labels);
+    XmlAttribute attrs[PTML_MAX_ATTRIBUTES];
+    char label[1024];
+    char *p = buffer;
+    int status = 0;
+
+    while ((p = strchr(p, '<')) != NULL) {
+        if (strncmp(p, "<!--", 4) == 0) {
+            char *end = strstr(p + 4, "-->");
+            p = end ? end + 3 : p + strlen(p);
+            continue;
+        }
+        if (p[1] == '?' || p[1] == '!' || p[1] == '/') {
+            char *end = strchr(p, '>');
+            p = end ? end + 1 : p + strlen(p);
+            continue;
+        }
+        char *name = p + 1;
+        char *q = name;
+        while (*q && *q != '>' && *q != '/' && !xml_is_space(*q)) q++;
+        size_t name_len = (size_t)(q - name);
+        int count;
+        p = xml_parse_attributes(q, attrs, PTML_MAX_ATTRIBUTES, &count, NULL);
+
+        size_t id_len = 0;
+        const char *id;
+        int op = classify_node(name, name_len);
+        if (op >= 0) {
+            id = xml_find_attribute(attrs, count, "id", &id_len);
+            if (!id) continue;
+            int index = resolve_node(&r, tree, id, id_len);
+            xml_get_attribute(attrs, count, "name", label, sizeof(label));
+            tree->nodes[index].op = op;
+            /* Silent tasks keep their name (often "tau") only if they have one */
+            tree->nodes[index].label = (op == PT_TASK || label[0]) ? intern_label(&r, tree, label) : -1;
+            r.defined[index] = 1;
+        } else if (name_len == 11 && strncmp(name, "parentsNode", 11) == 0) {
+            size_t target_len;
+            const char *source = xml_find_attribute(attrs, count, "sourceId", &id_len);
+            const char *target = xml_find_attribute(attrs, count, "targetId", &target_len);
+            if (!source || !target) continue;
+            int parent = resolve_node(&r, tree, source, id_len);
+            int child = resolve_node(&r, tree, target, target_len);
+            /* A node has one parent and no node is its own ancestor: reject repeated edges and cycles */
+            const char *error = tree->nodes[child].parent >= 0 ? "has two parents" : NULL;
+            for (int a = parent; a >= 0 && !error; a = tree->nodes[a].parent) {
+                if (a == child) error = "is its own ancestor";
+            }
+            if (error) {
+                fprintf(stderr, "Error in %s: node %.*s %s\n", filename, (int)target_len, target, error);
+                status = -1;
+                break;
+            }
+            add_tree_child(tree, parent, child);
+        } else if (name_len == 11 && strncmp(name, "processTree", 11) == 0) {
+            xml_get_attribute(attrs, count, "id", tree->id, sizeof(tree->id));
+            xml_get_attribute(attrs, count, "name", tree->name, sizeof(tree->name));
+            r.root = xml_find_attribute(attrs, count, "root", &r.root_len);
+        }
+    }
+
+    for (int i = 0; i < tree->node_count && status == 0; i++) {
+        if (!r.defined[i]) {
+            printf("Warning: node %d is referenced by a parentsNode but not defined.\n", i);
+        }
+    }
+    if (r.root && status == 0) {
+        tree->root = map_get(&r.nodes, r.root, r.root_len);
+    }
+    if (tree->root < 0 && status == 0) {
+        /* No (known) root attribute: use the first node without a parent */
+        for (int i = 0; i < tree->node_count && tree->root < 0; i++) {
+            if (tree->nodes[i].parent < 0) tree->root = i;
+        }
+    }
+
+    free(r.nodes.entries);
+    free(r.labels.entries);
+    free(r.defined);
+    free(buffer);
+    return status;
+}
+
+/*
+ * PTML writer
+ *
+ * All output goes through a single buffer (XmlWriter of c_xml.h) that is flushed with fwrite when full.
+ */
+
+static const char *ptml_tag(int op) {
+    switch (op) {
+    case PT_TASK: return "manualTask";
+    case PT_TAU: return "automaticTask";
+    case PT_SEQUENCE: return "sequence";
+    case PT_XOR: return "xor";
+    case PT_PARALLEL: return "and";
+    case PT_OR: return "or";
+    default: return "xorLoop";
+    }
+}
+
+/* Export the nodes reachable from the root to PTML; returns 0 on success */
+int export_ptml(const ProcessTree *tree, const char *filename) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        printf("Error opening file: %s\n", filename);
+        return -1;
+    }
+
+    /* Pre-order of the nodes reachable from the root; ids are positions in this order */
+    int *order = (int *)malloc(sizeof(int) * (tree->node_count + 1));
+    int *rank = (int *)malloc(sizeof(int) * (tree->node_count + 1));
+    int *stack = (int *)malloc(sizeof(int) * (tree->node_count + 1));
+    int count = 0, top = 0;
+    if (tree->root >= 0) stack[top++] = tree->root;
+    while (top > 0) {
+        int node = stack[--top];
+        rank[node] = count;
+        order[count++] = node;
+        /* Push the children in reverse order, so that the first child is visited first */
+        int first = top;
+        for (int c = tree->nodes[node].first_child; c >= 0; c = tree->nodes[c].next_sibling) stack[top++] = c;
+        for (int i = first, j = top - 1; i < j; i++, j--) {
+            int tmp = stack[i];
+            stack[i] = stack[j];
+            stack[j] = tmp;
+        }
+    }
+
+    XmlWriter *w = (XmlWriter *)malloc(sizeof(XmlWriter));
+    w->file = file;
+    w->len = 0;
+
+    xml_write_string(w, "<?xml version='1.0' encoding='UTF-8'?>\n<ptml>\n  <processTree");
+    if (tree->id[0]) {
+        xml_write_string(w, " id=\"");
+        xml_write_escaped(w, tree->id);
+        xml_write_string(w, "\"");
+    }
+    if (tree->name[0]) {
+        xml_write_string(w, " name=\"");
+        xml_write_escaped(w, tree->name);
+        xml_write_string(w, "\"");
+    }
+    xml_write_string(w, " root=\"n0\">\n");
+
+    for (int i = 0; i < count; i++) {
+        const TreeNode *node = &tree->nodes[order[i]];
+        xml_write_string(w, "    <");
+        xml_write_string(w, ptml_tag(node->op));
+        xml_write_string(w, " id=\"n");
+        xml_write_int(w, i);
+        xml_write_string(w, "\" name=\"");
+        if (node->label >= 0) xml_write_escaped(w, tree->labels[node->label]);
+        xml_write_string(w, "\"/>\n");
+    }
+    int edge = 0;
+    for (int i = 0; i < count; i++) {
+        for (int c = tree->nodes[order[i]].first_child; c >= 0; c = tree->nodes[c].next_sibling) {
+            xml_write_string(w, "    <parentsNode id=\"e");
+            xml_write_int(w, edge++);
+            xml_write_string(w, "\" sourceId=\"n");
+            xml_write_int(w, i);
+            xml_write_string(w, "\" targetId=\"n");
+            xml_write_int(w, rank[c]);
+            xml_write_string(w, "\"/>\n");
+        }
+    }
+    xml_write_string(w, "  </processTree>\n</ptml>\n");
+
+    xml_writer_flush(w);
+    free(w);
+    free(order);
+    free(rank);
+    free(stack);
+    fclose(file);
+    return 0;
+}
+
+#ifndef K_LIB
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        printf("Usage: %s input.ptml output.ptml\n", argv[0]);
+        return 1;
+    }
+
+    ProcessTree *tree = create_process_tree();
+    if (import_ptml(tree, argv[1]) != 0) {
+        free_process_tree(tree);
+        return 1;
+    }
+    export_ptml(tree, argv[2]);
+    free_process_tree(tree);
+
+    printf("Process tree has been exported to %s.\n", argv[2]);
+    return 0;
+}
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Process trees (see process_tree_ptml.txt)
+ *
+ * The nodes of a tree are stored in one flat array and linked by index
+ * (parent, first child, last child, next sibling); task labels are indices in
+ * the label table of the tree, whose strings are allocated from the arena of
+ * the tree (c_arena.h). Detached nodes stay in the array but are not
+ * exported.
+ *
+ * To link c_process_tree.c into another program, compile it with -DK_LIB
+ * (leaves out its main).
+ */
+
+#ifndef C_PROCESS_TREE_H
+#define C_PROCESS_TREE_H
+
+#include "c_arena.h"
+
+typedef enum {
+    PT_TASK,        /* manualTask */
+    PT_TAU,         /* automaticTask */
+    PT_SEQUENCE,    /* sequence */
+    PT_XOR,         /* xor */
+    PT_PARALLEL,    /* and */
+    PT_OR,          /* or */
+    PT_LOOP         /* xorLoop (also read from loop): do, redo; with three or more
+                       children do, redo_1 .. redo_k (choice), exit */
+} TreeOperator;
+
+typedef struct {
+    int op;             /* TreeOperator */
+    int label;          /* index in the label table, -1 if the node has no name */
+    int parent;         /* -1 for the root and for detached nodes */
+    int first_child;
+    int last_child;
+    int next_sibling;
+} TreeNode;
+
+typedef struct {
+    char id[100];       /* attributes of <processTree> (may be empty) */
+    char name[100];
+    int root;           /* -1 while the tree is empty */
+    TreeNode *nodes;
+    int node_count;
+    int node_capacity;
+    char **labels;
+    int label_count;
+    int label_capacity;
+    Arena label_strings;
+} ProcessTree;
+
+ProcessTree *create_process_tree(void);
+void reserve_tree_nodes(ProcessTree *tree, int capacity);
+int add_tree_node(ProcessTree *tree, int op, int label);
+int add_tree_label(ProcessTree *tree, const char *name);
+void add_tree_child(ProcessTree *tree, int parent, int child);
+void remove_tree_child(ProcessTree *tree, int parent, int child);
+int import_ptml(ProcessTree *tree, const char *filename);
+int export_ptml(const ProcessTree *tree, const char *filename);
+void free_process_tree(ProcessTree *tree);
+
+#endif
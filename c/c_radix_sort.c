@@ -0,0 +1,148 @@
+/*
+ * Radix sort of permutations by 64-bit keys (see c_radix_sort.h)
+ * Implemented in ANSI C; parallel with OpenMP (-fopenmp), sequential without
+ *
+ * **Main Components:**
+
+- **Keys next to the indices:**
+  - The keys are gathered once into an array parallel to the indices, so the passes read
+    and write both sequentially instead of looking the keys up through the permutation.
+
+- **Passes:**
+  - Each thread counts the bytes of its contiguous slice of the array (a 256-entry
+    histogram per thread). One thread turns the histograms into write offsets, bucket by
+    bucket and within a bucket thread by thread, which keeps the sort stable. Each thread
+    then scatters its slice to its offsets. A pass in which one bucket holds every key
+    moves nothing and is skipped.
+  - Small arrays (below RADIX_PARALLEL_THRESHOLD) are sorted by one thread.
+
+- **(group, time, index) order:**
+  - The index is the tie-break of the stable sort of the identity permutation, so only
+    (group, time) goes into the keys. When the group and the time relative to the earliest
+    one fit together in 64 bits (a log spanning years in milliseconds needs about 40), they
+    are packed into one key and sorted once; otherwise the permutation is sorted by time and
+    then by group.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "c_radix_sort.h"
+
+#define RADIX_BUCKETS 256
+#define RADIX_PARALLEL_THRESHOLD 65536
+
+#ifdef _OPENMP
+#define MAX_THREADS() omp_get_max_threads()
+#define THREAD_NUM() omp_get_thread_num()
+#define THREAD_COUNT() omp_get_num_threads()
+#else
+#define MAX_THREADS() 1
+#define THREAD_NUM() 0
+#define THREAD_COUNT() 1
+#endif
+
+void radix_sort_order(int *order, int n, const unsigned long long *keys) {
+    if (n < 2) return;
+    unsigned long long *key = (unsigned long long *)malloc(sizeof(unsigned long long) * n);
+    unsigned long long *key_out = (unsigned long long *)malloc(sizeof(unsigned long long) * n);
+    int *index = order;
+    int *index_out = (int *)malloc(sizeof(int) * n);
+    int *buffer = index_out;
+    for (int i = 0; i < n; i++) key[i] = keys[order[i]];
+
+    int parallel = n >= RADIX_PARALLEL_THRESHOLD;
+    int max_threads = parallel ? MAX_THREADS() : 1;
+    int *counts = (int *)malloc(sizeof(int) * RADIX_BUCKETS * max_threads);
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        int skip = 0;
+#pragma omp parallel if (parallel)
+        {
+            int t = THREAD_NUM(), threads = THREAD_COUNT();
+            int from = (int)((long long)n * t / threads), to = (int)((long long)n * (t + 1) / threads);
+            int *c = counts + RADIX_BUCKETS * t;
+            memset(c, 0, sizeof(int) * RADIX_BUCKETS);
+            for (int i = from; i < to; i++) c[(key[i] >> shift) & 0xFF]++;
+#pragma omp barrier
+#pragma omp single
+            {
+                int offset = 0;
+                for (int b = 0; b < RADIX_BUCKETS; b++) {
+                    int bucket = 0;
+                    for (int u = 0; u < threads; u++) {
+                        int count = counts[RADIX_BUCKETS * u + b];
+                        counts[RADIX_BUCKETS * u + b] = offset;
+                        offset += count;
+                        bucket += count;
+                    }
+                    if (bucket == n) skip = 1;
+                }
+            }
+            if (!skip) {
+                for (int i = from; i < to; i++) {
+                    int position = c[(key[i] >> shift) & 0xFF]++;
+                    key_out[position] = key[i];
+                    index_out[position] = index[i];
+                }
+            }
+        }
+        if (skip) continue;
+        unsigned long long *k = key;
+        key = key_out;
+        key_out = k;
+        int *x = index;
+        index = index_out;
+        index_out = x;
+    }
+
+    if (index != order) memcpy(order, index, sizeof(int) * n);
+    free(key);
+    free(key_out);
+    free(buffer);
+    free(counts);
+}
+
+/* Number of bits of value */
+static int bit_width(unsigned long long value) {
+    int bits = 0;
+    while (value) {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+void radix_sort_by_group_time(int *order, int n, const int *groups, const long long *timestamps) {
+    if (n <= 0) return;
+    long long min_time = timestamps[0], max_time = timestamps[0];
+    int max_group = 0;
+#pragma omp parallel for reduction(min : min_time) reduction(max : max_time, max_group) if (n >= RADIX_PARALLEL_THRESHOLD)
+    for (int i = 0; i < n; i++) {
+        if (timestamps[i] < min_time) min_time = timestamps[i];
+        if (timestamps[i] > max_time) max_time = timestamps[i];
+        if (groups[i] > max_group) max_group = groups[i];
+    }
+    int time_bits = bit_width((unsigned long long)max_time - (unsigned long long)min_time);
+    int packed = time_bits < 64 && time_bits + bit_width((unsigned long long)max_group) <= 64;
+
+    unsigned long long *keys = (unsigned long long *)malloc(sizeof(unsigned long long) * n);
+#pragma omp parallel for if (n >= RADIX_PARALLEL_THRESHOLD)
+    for (int i = 0; i < n; i++) {
+        unsigned long long time = (unsigned long long)timestamps[i] - (unsigned long long)min_time;
+        order[i] = i;
+        keys[i] = packed ? ((unsigned long long)groups[i] << time_bits) | time : radix_signed_key(timestamps[i]);
+    }
+    radix_sort_order(order, n, keys);
+    if (!packed) {
+#pragma omp parallel for if (n >= RADIX_PARALLEL_THRESHOLD)
+        for (int i = 0; i < n; i++) keys[i] = (unsigned long long)groups[i];
+        radix_sort_order(order, n, keys);
+    }
+    free(keys);
+}
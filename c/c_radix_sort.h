@@ -0,0 +1,28 @@
+/*
+ * Radix sort of permutations by 64-bit keys
+ *
+ * radix_sort_order sorts an array of indices by the keys of the indices,
+ * stably: indices with equal keys keep their order, so sorting by a minor key
+ * and then by a major key sorts by (major, minor), e.g. events by (case,
+ * timestamp). Least significant digit first, one byte per pass; passes in
+ * which all keys have the same byte are skipped, so keys of a narrow range
+ * (timestamps of one log, small ids) take few passes. Parallel with OpenMP
+ * (-fopenmp), sequential without. Library module without a main.
+ */
+
+#ifndef C_RADIX_SORT_H
+#define C_RADIX_SORT_H
+
+/* Key of a signed 64-bit value (e.g. a timestamp) that sorts in the same order */
+static inline unsigned long long radix_signed_key(long long value) {
+    return (unsigned long long)value ^ (1ULL << 63);
+}
+
+/* Sort order[0 .. n) stably by keys[order[i]] */
+void radix_sort_order(int *order, int n, const unsigned long long *keys);
+
+/* Permutation of the items 0 .. n - 1 by (groups[i], timestamps[i], i), e.g. the events of a log
+   by (case, time) or the E2O relationships by (object, time); groups are >= 0 */
+void radix_sort_by_group_time(int *order, int n, const int *groups, const long long *timestamps);
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Ordering the events of a log by timestamp (see c_sort_log.h)
+ * Implemented in ANSI C; parallel with OpenMP (-fopenmp), sequential without
+ *
+ * **Main Components:**
+
+- **Selection:**
+  - A case is sorted if all its events have a timestamp and the timestamps are not already
+    non-decreasing; a log in order costs one read of the timestamps and nothing else.
+
+- **Sort:**
+  - The events of the selected cases are flattened into (case, timestamp) columns and
+    radix-sorted into a permutation (radix_sort_by_group_time); the records stay in place
+    until the end.
+  - The permutation lists the events case by case, so each case is rearranged from its own
+    range of it, in parallel over the cases (the activity pointers and timestamps are
+    gathered into scratch arrays at the same positions, then copied back).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_sort_log.h"
+#include "c_radix_sort.h"
+#include "c_timestamp.h"
+
+/* 1 if the events of c have timestamps that are out of order */
+static int needs_sort(const Case *c) {
+    for (int j = 0; j < c->activity_count; j++) {
+        if (c->timestamps[j] == TIMESTAMP_NONE) return 0;
+    }
+    for (int j = 1; j < c->activity_count; j++) {
+        if (c->timestamps[j - 1] > c->timestamps[j]) return 1;
+    }
+    return 0;
+}
+
+int sort_log_events(Log *log) {
+    /* Selected cases and the offsets of their events in the flattened columns */
+    int *selected = (int *)malloc(sizeof(int) * (log->case_count > 0 ? log->case_count : 1));
+    int *offsets = (int *)malloc(sizeof(int) * (log->case_count + 1));
+    int count = 0, n = 0;
+    for (int c = 0; c < log->case_count; c++) {
+        if (!needs_sort(&log->cases[c])) continue;
+        selected[count] = c;
+        offsets[count++] = n;
+        n += log->cases[c].activity_count;
+    }
+    offsets[count] = n;
+    if (count == 0) {
+        free(selected);
+        free(offsets);
+        return 0;
+    }
+
+    int *groups = (int *)malloc(sizeof(int) * n);
+    long long *timestamps = (long long *)malloc(sizeof(long long) * n);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (int s = 0; s < count; s++) {
+        const Case *c = &log->cases[selected[s]];
+        for (int j = 0; j < c->activity_count; j++) {
+            groups[offsets[s] + j] = s;
+            timestamps[offsets[s] + j] = c->timestamps[j];
+        }
+    }
+    int *order = (int *)malloc(sizeof(int) * n);
+    radix_sort_by_group_time(order, n, groups, timestamps);
+    free(groups);
+
+    char **activities = (char **)malloc(sizeof(char *) * n);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (int s = 0; s < count; s++) {
+        Case *c = &log->cases[selected[s]];
+        int from = offsets[s], to = offsets[s + 1];
+        for (int i = from; i < to; i++) {
+            int j = order[i] - from;
+            activities[i] = c->activities[j];
+            timestamps[i] = c->timestamps[j];
+        }
+        memcpy(c->activities, activities + from, sizeof(char *) * (to - from));
+        memcpy(c->timestamps, timestamps + from, sizeof(long long) * (to - from));
+    }
+
+    free(activities);
+    free(timestamps);
+    free(order);
+    free(offsets);
+    free(selected);
+    return count;
+}
@@ -0,0 +1,20 @@
+/*
+ * Ordering the events of a log by timestamp
+ *
+ * XES exports are not always sorted inside the traces. sort_log_events
+ * puts the events of every case in time:timestamp order (stable: events
+ * with the same time keep their order), through one radix sort of all the
+ * events to reorder by (case, timestamp) (c_radix_sort.h). Cases with an
+ * event without a timestamp are left as they are. Library module without a
+ * main.
+ */
+
+#ifndef C_SORT_LOG_H
+#define C_SORT_LOG_H
+
+#include "c_xes.h"
+
+/* Sort the events of the cases of log by timestamp; returns the number of cases reordered */
+int sort_log_events(Log *log);
+
+#endif
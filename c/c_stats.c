@@ -0,0 +1,245 @@
+/*
+ * Phase timing and memory instrumentation
+ * Linked into a tool built with -DK_STATS (see c_stats.h); POSIX (clock_gettime, getrusage)
+ *
+ * **Main Components:**
+
+- **Phases:**
+  - `stats_begin(name)` / `stats_end()` delimit a phase (read, parse, encode, export, ...).
+    Phases may nest up to STATS_MAX_DEPTH levels. Repeated phases with the same name are
+    aggregated (calls, total time, totals of the counters, maximum of the peak heap).
+  - `stats_count(bytes, records)` adds the bytes read/written and records parsed/written to
+    the innermost open phase.
+
+- **Allocation counting:**
+  - The wrappers count allocation calls and requested bytes for every open phase and keep the
+    live heap size. The size of a freed block is taken from the allocator
+    (malloc_usable_size on glibc, malloc_size on macOS), so blocks may be freed by code that is
+    not instrumented and vice versa; elsewhere only calls and requested bytes are counted.
+
+- **Report (at exit):**
+  - A table on stderr, or a JSON object in the file named by K_STATS_FILE, with one entry per
+    phase plus the peak heap and the peak RSS (getrusage) of the whole process.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define C_STATS_IMPL
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define BLOCK_SIZE(p) malloc_usable_size(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define BLOCK_SIZE(p) malloc_size(p)
+#endif
+
+#include "c_stats.h"
+
+#define STATS_MAX_PHASES 32
+#define STATS_MAX_DEPTH 8
+
+typedef struct {
+    const char *name;
+    int calls;
+    double seconds;
+    long long bytes;
+    long long records;
+    long long allocations;
+    long long allocated_bytes;
+    long long peak_heap;        /* maximum of the live heap while the phase was open */
+} PhaseStats;
+
+typedef struct {
+    PhaseStats *phase;
+    double start;
+    long long allocations;
+    long long allocated_bytes;
+    long long peak_heap;
+} OpenPhase;
+
+static PhaseStats phases[STATS_MAX_PHASES];
+static int phase_count = 0;
+static OpenPhase open_phases[STATS_MAX_DEPTH];
+static int depth = 0;
+static int report_registered = 0;
+
+static long long total_allocations = 0;
+static long long total_allocated_bytes = 0;
+static long long live_heap = 0;
+static long long peak_heap = 0;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void report(void);
+
+void stats_begin(const char *phase) {
+    if (!report_registered) {
+        atexit(report);
+        report_registered = 1;
+    }
+    if (depth >= STATS_MAX_DEPTH) {
+        depth++;   /* too deep: ignored, but keeps begin/end balanced */
+        return;
+    }
+
+    PhaseStats *p = NULL;
+    for (int i = 0; i < phase_count; i++) {
+        if (strcmp(phases[i].name, phase) == 0) {
+            p = &phases[i];
+            break;
+        }
+    }
+    if (!p && phase_count < STATS_MAX_PHASES) {
+        p = &phases[phase_count++];
+        memset(p, 0, sizeof(*p));
+        p->name = phase;
+    }
+
+    OpenPhase *o = &open_phases[depth++];
+    o->phase = p;
+    o->allocations = 0;
+    o->allocated_bytes = 0;
+    o->peak_heap = live_heap;
+    o->start = now_seconds();
+}
+
+void stats_end(void) {
+    double end = now_seconds();
+    if (depth == 0) return;
+    if (depth-- > STATS_MAX_DEPTH) return;
+
+    OpenPhase *o = &open_phases[depth];
+    PhaseStats *p = o->phase;
+    if (!p) return;
+    p->calls++;
+    p->seconds += end - o->start;
+    p->allocations += o->allocations;
+    p->allocated_bytes += o->allocated_bytes;
+    if (o->peak_heap > p->peak_heap) p->peak_heap = o->peak_heap;
+}
+
+void stats_count(long long bytes, long long records) {
+    if (depth == 0 || depth > STATS_MAX_DEPTH || !open_phases[depth - 1].phase) return;
+    open_phases[depth - 1].phase->bytes += bytes;
+    open_phases[depth - 1].phase->records += records;
+}
+
+/* Account an allocation of size bytes; block_size is the change of the live heap */
+static void count_allocation(size_t size, long long block_size) {
+    total_allocations++;
+    total_allocated_bytes += (long long)size;
+    live_heap += block_size;
+    if (live_heap > peak_heap) peak_heap = live_heap;
+    int open = depth < STATS_MAX_DEPTH ? depth : STATS_MAX_DEPTH;
+    for (int i = 0; i < open; i++) {
+        open_phases[i].allocations++;
+        open_phases[i].allocated_bytes += (long long)size;
+        if (live_heap > open_phases[i].peak_heap) open_phases[i].peak_heap = live_heap;
+    }
+}
+
+static long long block_size(void *p) {
+#ifdef BLOCK_SIZE
+    return p ? (long long)BLOCK_SIZE(p) : 0;
+#else
+    (void)p;
+    return 0;
+#endif
+}
+
+void *stats_malloc(size_t size) {
+    void *p = malloc(size);
+    if (p) count_allocation(size, block_size(p));
+    return p;
+}
+
+void *stats_calloc(size_t count, size_t size) {
+    void *p = calloc(count, size);
+    if (p) count_allocation(count * size, block_size(p));
+    return p;
+}
+
+void *stats_realloc(void *p, size_t size) {
+    long long old_size = block_size(p);
+    void *q = realloc(p, size);
+    if (q) count_allocation(size, block_size(q) - old_size);
+    return q;
+}
+
+char *stats_strdup(const char *s) {
+    size_t len = strlen(s) + 1;
+    char *p = (char *)stats_malloc(len);
+    if (p) memcpy(p, s, len);
+    return p;
+}
+
+void stats_free(void *p) {
+    live_heap -= block_size(p);
+    free(p);
+}
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;   /* bytes on macOS */
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static double per_second(long long amount, double seconds) {
+    return seconds > 0 ? (double)amount / seconds : 0.0;
+}
+
+static void report_json(FILE *fp) {
+    fprintf(fp, "{\"phases\":[");
+    for (int i = 0; i < phase_count; i++) {
+        const PhaseStats *p = &phases[i];
+        fprintf(fp, "%s\n  {\"phase\":\"%s\",\"calls\":%d,\"seconds\":%.6f,\"bytes\":%lld,\"records\":%lld,"
+                    "\"mb_per_s\":%.2f,\"records_per_s\":%.0f,\"allocations\":%lld,\"allocated_bytes\":%lld,"
+                    "\"peak_heap_bytes\":%lld}",
+                i > 0 ? "," : "", p->name, p->calls, p->seconds, p->bytes, p->records,
+                per_second(p->bytes, p->seconds) / 1e6, per_second(p->records, p->seconds),
+                p->allocations, p->allocated_bytes, p->peak_heap);
+    }
+    fprintf(fp, "\n],\"allocations\":%lld,\"allocated_bytes\":%lld,\"peak_heap_bytes\":%lld,\"peak_rss_kb\":%ld}\n",
+            total_allocations, total_allocated_bytes, peak_heap, peak_rss_kb());
+}
+
+static void report_text(FILE *fp) {
+    fprintf(fp, "%-12s %6s %10s %12s %10s %9s %12s %12s %14s %14s\n", "phase", "calls", "seconds", "bytes",
+            "records", "MB/s", "records/s", "allocations", "alloc bytes", "peak heap");
+    for (int i = 0; i < phase_count; i++) {
+        const PhaseStats *p = &phases[i];
+        fprintf(fp, "%-12s %6d %10.6f %12lld %10lld %9.2f %12.0f %12lld %14lld %14lld\n", p->name, p->calls,
+                p->seconds, p->bytes, p->records, per_second(p->bytes, p->seconds) / 1e6,
+                per_second(p->records, p->seconds), p->allocations, p->allocated_bytes, p->peak_heap);
+    }
+    fprintf(fp, "total: %lld allocations, %lld bytes allocated, peak heap %lld bytes, peak RSS %ld KB\n",
+            total_allocations, total_allocated_bytes, peak_heap, peak_rss_kb());
+}
+
+static void report(void) {
+    const char *filename = getenv("K_STATS_FILE");
+    if (filename && *filename) {
+        FILE *fp = fopen(filename, "w");
+        if (fp) {
+            report_json(fp);
+            fclose(fp);
+            return;
+        }
+        fprintf(stderr, "Failed to open %s, writing the statistics to stderr\n", filename);
+    }
+    report_text(stderr);
+}
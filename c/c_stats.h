@@ -0,0 +1,61 @@
+/*
+ * Opt-in phase timing and memory instrumentation (see c_stats.c)
+ *
+ * Without -DK_STATS the macros below expand to nothing and their arguments are
+ * not evaluated, so the instrumented code costs nothing in normal builds.
+ * With -DK_STATS (and c_stats.c linked in), every phase records its wall time,
+ * bytes, records, allocation calls, allocated bytes and peak heap, and a report
+ * is printed at exit: to stderr, or as JSON to the file named by the
+ * K_STATS_FILE environment variable.
+ *
+ * Include this header after the system headers: with -DK_STATS it redirects
+ * malloc, calloc, realloc, strdup and free of the including file to counting
+ * wrappers.
+ *
+ * The phases and counters are process-wide and not synchronized, so the
+ * report is only meaningful for one importer at a time (not for concurrent
+ * imports, see c_batch_import.h).
+ *
+ * Example: cc -O2 -DK_STATS -o c_xes c_xes.c c_stats.c
+ */
+
+#ifndef C_STATS_H
+#define C_STATS_H
+
+#ifdef K_STATS
+
+#include <stddef.h>
+
+void stats_begin(const char *phase);
+void stats_end(void);
+void stats_count(long long bytes, long long records);
+
+void *stats_malloc(size_t size);
+void *stats_calloc(size_t count, size_t size);
+void *stats_realloc(void *p, size_t size);
+char *stats_strdup(const char *s);
+void stats_free(void *p);
+
+/* Start/end a phase; phases may nest, bytes and records go to the innermost one */
+#define K_STATS_BEGIN(phase) stats_begin(phase)
+#define K_STATS_END() stats_end()
+#define K_STATS_COUNT(bytes, records) stats_count(bytes, records)
+
+#ifndef C_STATS_IMPL
+#undef strdup
+#define malloc(size) stats_malloc(size)
+#define calloc(count, size) stats_calloc(count, size)
+#define realloc(p, size) stats_realloc(p, size)
+#define strdup(s) stats_strdup(s)
+#define free(p) stats_free(p)
+#endif
+
+#else
+
+#define K_STATS_BEGIN(phase) ((void)0)
+#define K_STATS_END() ((void)0)
+#define K_STATS_COUNT(bytes, records) ((void)0)
+
+#endif
+
+#endif
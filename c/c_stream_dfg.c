@@ -0,0 +1,501 @@
+/*
+ * Online Directly-Follows Graph from an event stream
+ * Reads (case id, activity, timestamp) events as they arrive and keeps the DFG of the stream up
+ * to date, writing snapshots of it periodically
+ * Implemented in C (POSIX) on top of c_xes.c (activity dictionary) and c_dfg.c
+ *
+ * Build: cc -O2 -DK_LIB -o c_stream_dfg c_stream_dfg.c c_xes.c c_dfg.c
+ * Usage: c_stream_dfg [options] < events.csv
+ *   --socket PATH           read from a local (Unix domain) socket instead of stdin, one
+ *                           connection after the other, until SIGINT or SIGTERM
+ *   --max-cases N           open cases kept (default 1000000); the least recently active case is
+ *                           evicted when a new one does not fit
+ *   --idle SECONDS          evict cases without events for SECONDS (by the event timestamps)
+ *   --snapshot-events N     write a snapshot every N events (default 1000000, 0: never)
+ *   --snapshot-seconds S    write a snapshot every S seconds of wall-clock time (0: never)
+ *   --output FILE           write the snapshots to FILE (replaced atomically) instead of stdout
+ *
+ * Input: one event per line, "case,activity[,timestamp]"; the timestamp is seconds since the epoch
+ * or ISO 8601 (2024-01-31T12:00:00[.fff][Z|+hh:mm]). A last snapshot is written at the end.
+ *
+ * **Main Components:**
+
+- **Case table:**
+  - Open cases are kept in an open-addressing hash table (linear probing, backward-shift
+    deletion, no tombstones) keyed by the 64-bit FNV-1a hash of the case id; the id itself is
+    not stored, so an entry takes 32 bytes and the table is allocated once for --max-cases.
+  - The entries are linked in least-recently-used order; eviction takes the head of the list,
+    both when the table is full and for --idle. An evicted case that gets more events later
+    starts again as a new case.
+
+- **DFG:**
+  - Every event adds the edge from the last activity of its case and moves the end count of
+    the case to the new activity (as in c_append_log.c), so a snapshot needs no pass over the
+    open cases. New activities grow the DFG by doubling (resize_dfg), so its n may exceed the
+    number of activities; the counts beyond are zero and left out of the snapshots.
+
+- **Input:**
+  - The input is read with read(2) in 1 MB blocks and split into lines in place; poll(2) wakes
+    the loop for time-based snapshots while the stream is idle. A line longer than a block is
+    skipped (counted in skipped_lines) up to its newline.
+
+- **Snapshots:**
+  - One JSON object per snapshot: event and case counters, the activities, and the start, end
+    and directly-follows counts by activity index.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "c_dfg.h"
+#include "c_timestamp.h"
+#include "c_xes.h"
+
+#define BLOCK_SIZE (1 << 20)
+
+typedef struct {
+    unsigned long long key;     /* hash of the case id, 0: empty slot */
+    long long last_time;        /* timestamp of the last event */
+    int last_activity;
+    int prev;                   /* least recently used order (slot indices, -1 at the ends) */
+    int next;
+} CaseSlot;
+
+typedef struct {
+    CaseSlot *slots;
+    unsigned int mask;          /* slot count - 1 (power of two) */
+    int count;
+    int max_count;
+    int head;                   /* least recently used */
+    int tail;                   /* most recently used */
+} CaseTable;
+
+typedef struct {
+    ActivityDictionary dictionary;
+    DFG *dfg;
+    CaseTable cases;
+    long long idle_seconds;     /* 0: no idle eviction */
+    long long now;              /* latest timestamp seen */
+    long long events;
+    long long skipped_lines;
+    long long started_cases;
+    long long evicted_cases;
+} StreamDFG;
+
+typedef struct {
+    long long snapshot_events;
+    double snapshot_seconds;
+    const char *output;
+    long long next_snapshot_events;
+    double next_snapshot_time;
+    int snapshots;
+} SnapshotConfig;
+
+/* Set by SIGINT/SIGTERM: stop reading and write the last snapshot */
+static volatile sig_atomic_t stop_requested = 0;
+
+/* Function prototypes */
+void init_stream_dfg(StreamDFG *s, int max_cases, long long idle_seconds);
+void free_stream_dfg(StreamDFG *s);
+void add_stream_event(StreamDFG *s, const char *case_id, size_t case_length, const char *activity, long long time);
+int write_snapshot(const StreamDFG *s, const char *output);
+
+/* Case table */
+
+static unsigned long long hash_case(const char *s, size_t length) {
+    unsigned long long h = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ull;
+    }
+    return h ? h : 1;
+}
+
+static void init_case_table(CaseTable *t, int max_count) {
+    unsigned int capacity = 16;
+    while (capacity < (unsigned int)max_count * 2) capacity *= 2;
+    t->slots = (CaseSlot *)calloc(capacity, sizeof(CaseSlot));
+    t->mask = capacity - 1;
+    t->count = 0;
+    t->max_count = max_count;
+    t->head = t->tail = -1;
+}
+
+static void lru_unlink(CaseTable *t, int i) {
+    CaseSlot *s = &t->slots[i];
+    if (s->prev >= 0) t->slots[s->prev].next = s->next;
+    else t->head = s->next;
+    if (s->next >= 0) t->slots[s->next].prev = s->prev;
+    else t->tail = s->prev;
+}
+
+static void lru_append(CaseTable *t, int i) {
+    CaseSlot *s = &t->slots[i];
+    s->prev = t->tail;
+    s->next = -1;
+    if (t->tail >= 0) t->slots[t->tail].next = i;
+    else t->head = i;
+    t->tail = i;
+}
+
+/* Move the entry of slot from to the empty slot to, fixing the links that point to it */
+static void move_slot(CaseTable *t, unsigned int from, unsigned int to) {
+    t->slots[to] = t->slots[from];
+    CaseSlot *s = &t->slots[to];
+    if (s->prev >= 0) t->slots[s->prev].next = (int)to;
+    else t->head = (int)to;
+    if (s->next >= 0) t->slots[s->next].prev = (int)to;
+    else t->tail = (int)to;
+    t->slots[from].key = 0;
+}
+
+/* Remove the entry of slot i, shifting back the entries of its probe run */
+static void remove_slot(CaseTable *t, unsigned int i) {
+    lru_unlink(t, (int)i);
+    t->slots[i].key = 0;
+    t->count--;
+    unsigned int hole = i;
+    for (unsigned int j = (i + 1) & t->mask; t->slots[j].key; j = (j + 1) & t->mask) {
+        unsigned int home = (unsigned int)t->slots[j].key & t->mask;
+        /* The entry at j may move to the hole if its home slot is not in (hole, j] */
+        if (((j - home) & t->mask) >= ((j - hole) & t->mask)) {
+            move_slot(t, j, hole);
+            hole = j;
+        }
+    }
+}
+
+/* Stream */
+
+void init_stream_dfg(StreamDFG *s, int max_cases, long long idle_seconds) {
+    memset(s, 0, sizeof(*s));
+    init_activity_dictionary(&s->dictionary);
+    s->dfg = create_dfg(0);
+    init_case_table(&s->cases, max_cases);
+    s->idle_seconds = idle_seconds;
+}
+
+void free_stream_dfg(StreamDFG *s) {
+    free_activity_dictionary(&s->dictionary);
+    free_dfg(s->dfg);
+    free(s->cases.slots);
+}
+
+static void evict_least_recent(StreamDFG *s) {
+    remove_slot(&s->cases, (unsigned int)s->cases.head);
+    s->evicted_cases++;
+}
+
+/* Add an event; the activity must be NUL-terminated, the case id is case_length bytes */
+void add_stream_event(StreamDFG *s, const char *case_id, size_t case_length, const char *activity, long long time) {
+    CaseTable *t = &s->cases;
+    int a = intern_activity(&s->dictionary, activity);
+    if (a >= s->dfg->n) {
+        int n = s->dfg->n;
+        resize_dfg(s->dfg, s->dictionary.count > 2 * n ? s->dictionary.count : 2 * n);
+    }
+    if (time > s->now) s->now = time;
+    s->events++;
+
+    unsigned long long key = hash_case(case_id, case_length);
+    unsigned int i = (unsigned int)key & t->mask;
+    while (t->slots[i].key && t->slots[i].key != key) i = (i + 1) & t->mask;
+
+    if (t->slots[i].key) {
+        CaseSlot *c = &t->slots[i];
+        add_dfg_edge(s->dfg, c->last_activity, a, 1);
+        add_dfg_end(s->dfg, c->last_activity, -1);
+        c->last_activity = a;
+        c->last_time = time;
+        lru_unlink(t, (int)i);
+        lru_append(t, (int)i);
+    } else {
+        if (t->count >= t->max_count) {
+            evict_least_recent(s);
+            /* The eviction may have shifted entries into the probe run: look again */
+            i = (unsigned int)key & t->mask;
+            while (t->slots[i].key) i = (i + 1) & t->mask;
+        }
+        CaseSlot *c = &t->slots[i];
+        c->key = key;
+        c->last_activity = a;
+        c->last_time = time;
+        t->count++;
+        lru_append(t, (int)i);
+        add_dfg_start(s->dfg, a, 1);
+        s->started_cases++;
+    }
+    add_dfg_end(s->dfg, a, 1);
+
+    if (s->idle_seconds > 0) {
+        while (t->head >= 0 && t->slots[t->head].last_time < s->now - s->idle_seconds) evict_least_recent(s);
+    }
+}
+
+/* Input */
+
+/* Parse one line "case,activity[,timestamp]" (without its newline) and add the event */
+static void add_line(StreamDFG *s, char *line, char *end) {
+    if (end > line && end[-1] == '\r') end--;
+    if (end <= line) return;
+    char *comma = memchr(line, ',', (size_t)(end - line));
+    if (!comma || comma == line) {
+        s->skipped_lines++;
+        return;
+    }
+    char *activity = comma + 1;
+    char *activity_end = memchr(activity, ',', (size_t)(end - activity));
+    long long time = 0;
+    if (activity_end) {
+        long long ms = parse_timestamp(activity_end + 1, end);
+        if (ms != TIMESTAMP_NONE) time = ms / 1000;
+    } else {
+        activity_end = end;
+    }
+    *activity_end = '\0';
+    add_stream_event(s, line, (size_t)(comma - line), activity, time);
+}
+
+static double wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void maybe_snapshot(const StreamDFG *s, SnapshotConfig *config) {
+    int due = 0;
+    if (config->snapshot_events > 0 && s->events >= config->next_snapshot_events) {
+        due = 1;
+        config->next_snapshot_events = s->events + config->snapshot_events;
+    }
+    if (config->snapshot_seconds > 0 && wall_time() >= config->next_snapshot_time) {
+        due = 1;
+        config->next_snapshot_time = wall_time() + config->snapshot_seconds;
+    }
+    if (due) {
+        write_snapshot(s, config->output);
+        config->snapshots++;
+    }
+}
+
+/* Read events from fd until its end; 0 on success, -1 on a read error */
+static int read_stream(StreamDFG *s, int fd, SnapshotConfig *config) {
+    char *buffer = (char *)malloc(BLOCK_SIZE + 1);
+    size_t length = 0;
+    int status = 0;
+    int skipping = 0;   /* in the rest of a line longer than the buffer */
+
+    for (;;) {
+        if (config->snapshot_seconds > 0) {
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            int timeout = (int)((config->next_snapshot_time - wall_time()) * 1000);
+            int ready = poll(&pfd, 1, timeout > 0 ? timeout : 0);
+            if (stop_requested) break;
+            if (ready <= 0) {
+                maybe_snapshot(s, config);
+                continue;
+            }
+        }
+        if (stop_requested) break;
+        ssize_t n = read(fd, buffer + length, BLOCK_SIZE - length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("Failed to read the event stream");
+            status = -1;
+            break;
+        }
+        if (n == 0) break;
+        length += (size_t)n;
+
+        char *line = buffer, *end = buffer + length;
+        char *newline;
+        if (skipping) {
+            newline = memchr(line, '\n', length);
+            if (!newline) {
+                length = 0;
+                continue;
+            }
+            line = newline + 1;
+            skipping = 0;
+        }
+        while ((newline = memchr(line, '\n', (size_t)(end - line))) != NULL) {
+            add_line(s, line, newline);
+            line = newline + 1;
+            if (config->snapshot_events > 0 && s->events >= config->next_snapshot_events) maybe_snapshot(s, config);
+        }
+        length = (size_t)(end - line);
+        memmove(buffer, line, length);
+        if (length == BLOCK_SIZE) {
+            /* A line longer than the buffer: drop it up to its newline */
+            s->skipped_lines++;
+            skipping = 1;
+            length = 0;
+        }
+        maybe_snapshot(s, config);
+    }
+    /* Last line without a newline */
+    if (length > 0 && status == 0 && !skipping) add_line(s, buffer, buffer + length);
+    free(buffer);
+    return status;
+}
+
+/* Accept connections on a Unix domain socket and read each of them to its end */
+static int read_socket(StreamDFG *s, const char *path, SnapshotConfig *config) {
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (server < 0 || strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Failed to create socket %s\n", path);
+        if (server >= 0) close(server);
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+    unlink(path);
+    if (bind(server, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(server, 1) < 0) {
+        perror("Failed to listen on the socket");
+        close(server);
+        return -1;
+    }
+    int status = 0;
+    while (!stop_requested) {
+        int client = accept(server, NULL, NULL);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            perror("Failed to accept a connection");
+            status = -1;
+            break;
+        }
+        read_stream(s, client, config);
+        close(client);
+    }
+    close(server);
+    unlink(path);
+    return status;
+}
+
+/* Snapshots */
+
+static void write_json_string(FILE *fp, const char *s) {
+    fputc('"', fp);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(fp, "\\%c", c);
+        else if (c < 0x20) fprintf(fp, "\\u%04x", c);
+        else fputc(c, fp);
+    }
+    fputc('"', fp);
+}
+
+static void write_counts(FILE *fp, const char *key, const long long *counts, int n) {
+    int first = 1;
+    fprintf(fp, ",\"%s\":[", key);
+    for (int a = 0; a < n; a++) {
+        if (counts[a] <= 0) continue;
+        fprintf(fp, "%s[%d,%lld]", first ? "" : ",", a, counts[a]);
+        first = 0;
+    }
+    fputc(']', fp);
+}
+
+/* Write the current DFG as one JSON line to output (NULL: stdout); 0 on success */
+int write_snapshot(const StreamDFG *s, const char *output) {
+    char temporary[4096];
+    FILE *fp = stdout;
+    if (output) {
+        snprintf(temporary, sizeof(temporary), "%s.tmp", output);
+        fp = fopen(temporary, "w");
+        if (!fp) {
+            perror("Failed to open the snapshot file");
+            return -1;
+        }
+    }
+
+    const DFG *dfg = s->dfg;
+    fprintf(fp, "{\"events\":%lld,\"cases\":%lld,\"open_cases\":%d,\"evicted_cases\":%lld,\"skipped_lines\":%lld",
+            s->events, s->started_cases, s->cases.count, s->evicted_cases, s->skipped_lines);
+    fprintf(fp, ",\"activities\":[");
+    for (int a = 0; a < s->dictionary.count; a++) {
+        if (a) fputc(',', fp);
+        write_json_string(fp, s->dictionary.names[a]);
+    }
+    fputc(']', fp);
+    write_counts(fp, "start", dfg->start_counts, dfg->n);
+    write_counts(fp, "end", dfg->end_counts, dfg->n);
+    fprintf(fp, ",\"edges\":[");
+    int first = 1;
+    for (int a = 0; a < dfg->n; a++) {
+        BITSET_FOREACH(b, DFG_ROW(dfg->succ, a, dfg->words), dfg->words) {
+            fprintf(fp, "%s[%d,%d,%lld]", first ? "" : ",", a, b, dfg->counts[(size_t)a * dfg->n + b]);
+            first = 0;
+        }
+    }
+    fprintf(fp, "]}\n");
+
+    if (!output) {
+        fflush(fp);
+        return 0;
+    }
+    int status = fclose(fp) == 0 ? 0 : -1;
+    if (status == 0 && rename(temporary, output) != 0) status = -1;
+    if (status != 0) perror("Failed to write the snapshot");
+    return status;
+}
+
+static void request_stop(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+/* Main function */
+int main(int argc, char *argv[]) {
+    const char *socket_path = NULL;
+    int max_cases = 1000000;
+    long long idle_seconds = 0;
+    SnapshotConfig config = { 1000000, 0, NULL, 0, 0, 0 };
+
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", option);
+            return 1;
+        }
+        const char *value = argv[++i];
+        if (strcmp(option, "--socket") == 0) socket_path = value;
+        else if (strcmp(option, "--max-cases") == 0) max_cases = atoi(value);
+        else if (strcmp(option, "--idle") == 0) idle_seconds = atoll(value);
+        else if (strcmp(option, "--snapshot-events") == 0) config.snapshot_events = atoll(value);
+        else if (strcmp(option, "--snapshot-seconds") == 0) config.snapshot_seconds = atof(value);
+        else if (strcmp(option, "--output") == 0) config.output = value;
+        else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [--max-cases N] [--idle SECONDS] [--snapshot-events N] "
+                            "[--snapshot-seconds S] [--output FILE] < events.csv\n", argv[0]);
+            return 1;
+        }
+    }
+    if (max_cases < 1) max_cases = 1;
+    config.next_snapshot_events = config.snapshot_events;
+    config.next_snapshot_time = wall_time() + config.snapshot_seconds;
+
+    /* Without SA_RESTART, so that a blocked read or accept returns */
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = request_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    StreamDFG s;
+    init_stream_dfg(&s, max_cases, idle_seconds);
+    int status = socket_path ? read_socket(&s, socket_path, &config) : read_stream(&s, 0, &config);
+    if (write_snapshot(&s, config.output) != 0) status = -1;
+    free_stream_dfg(&s);
+    return status == 0 ? 0 : 1;
+}
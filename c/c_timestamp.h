@@ -0,0 +1,78 @@
+/*
+ * Timestamps as 64-bit integers: milliseconds since 1970-01-01T00:00:00Z.
+ * Parses the ISO 8601 forms of XES and OCEL (date, optional time with
+ * fraction, optional Z or +hh:mm offset) and plain integers (seconds since
+ * the epoch, as in CSV streams). Header only, like c_bitset.h.
+ */
+
+#ifndef C_TIMESTAMP_H
+#define C_TIMESTAMP_H
+
+#include <string.h>
+
+/* Value of an unrecognized or missing timestamp; sorts before every real one */
+#define TIMESTAMP_NONE (-9223372036854775807LL - 1)
+
+/* Days since the epoch of a proleptic Gregorian date (Howard Hinnant's algorithm) */
+static inline long long timestamp_days_from_civil(long long y, int m, int d) {
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static inline int timestamp_digits(const char **p, const char *end, int n) {
+    int value = 0;
+    for (int i = 0; i < n; i++, (*p)++) {
+        if (*p >= end || **p < '0' || **p > '9') return -1;
+        value = value * 10 + (**p - '0');
+    }
+    return value;
+}
+
+/* Timestamp of the characters p .. end, TIMESTAMP_NONE if empty or not recognized */
+static inline long long parse_timestamp(const char *p, const char *end) {
+    const char *q = p;
+    long long seconds = 0;
+    while (q < end && *q >= '0' && *q <= '9') seconds = seconds * 10 + (*q++ - '0');
+    if (q == end) return q > p ? seconds * 1000 : TIMESTAMP_NONE;
+
+    int year = timestamp_digits(&p, end, 4);
+    if (year < 0 || p >= end || *p++ != '-') return TIMESTAMP_NONE;
+    int month = timestamp_digits(&p, end, 2);
+    if (month < 1 || p >= end || *p++ != '-') return TIMESTAMP_NONE;
+    int day = timestamp_digits(&p, end, 2);
+    if (day < 1) return TIMESTAMP_NONE;
+    int hour = 0, minute = 0, second = 0, millisecond = 0;
+    if (p < end && (*p == 'T' || *p == ' ')) {
+        p++;
+        hour = timestamp_digits(&p, end, 2);
+        if (p < end && *p == ':') p++;
+        minute = timestamp_digits(&p, end, 2);
+        if (p < end && *p == ':') p++;
+        second = timestamp_digits(&p, end, 2);
+        if (hour < 0 || minute < 0 || second < 0) return TIMESTAMP_NONE;
+        if (p < end && *p == '.') {
+            p++;
+            for (int scale = 100; p < end && *p >= '0' && *p <= '9'; p++, scale /= 10) millisecond += (*p - '0') * scale;
+        }
+    }
+    long long ms = (timestamp_days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second) * 1000 + millisecond;
+    if (p < end && (*p == '+' || *p == '-')) {
+        int sign = *p++ == '+' ? 1 : -1;
+        int oh = timestamp_digits(&p, end, 2);
+        if (p < end && *p == ':') p++;
+        int om = timestamp_digits(&p, end, 2);
+        if (oh >= 0 && om >= 0) ms -= sign * (oh * 3600 + om * 60) * 1000LL;
+    }
+    return ms;
+}
+
+/* Timestamp of a NUL-terminated string (NULL: TIMESTAMP_NONE) */
+static inline long long parse_timestamp_string(const char *s) {
+    return s ? parse_timestamp(s, s + strlen(s)) : TIMESTAMP_NONE;
+}
+
+#endif
@@ -0,0 +1,396 @@
+/*
+ * Trace clustering with MinHash and LSH
+ * Groups the variants of an XES event log by the similarity of their activity n-grams and writes
+ * one XES log per cluster
+ * Implemented in ANSI C on top of c_xes.c
+ *
+ * Build: cc -O2 -DK_LIB -o c_trace_clustering c_trace_clustering.c c_xes.c
+ * Usage: c_trace_clustering input.xes k output_prefix
+ *   (writes output_prefix_0.xes ... with the cases of each cluster, in log order)
+ * Entry points: cluster_traces, export_clusters (declared in k.h)
+ *
+ * **Main Components:**
+
+- **Variants:**
+  - Cases with the same activity sequence are one variant (hash table over the encoded
+    sequences); everything below works on variants weighted by their number of cases.
+
+- **MinHash signatures:**
+  - The set of a variant is its activity n-grams (NGRAM_SIZE, padded with start and end
+    markers, so the first and last activities count). Each n-gram is hashed once and the
+    signature keeps, for each of SIGNATURE_SIZE seeded mixes of the hash, the minimum; the
+    fraction of equal positions of two signatures estimates the Jaccard similarity of the sets.
+
+- **LSH banding:**
+  - The signature is cut into LSH_BANDS bands; variants whose band hashes are equal fall into
+    the same bucket (sorting by band hash). Each member of a bucket is compared with the first
+    one only and joined to it (union-find) if their estimated similarity reaches
+    LSH_THRESHOLD, so the cost grows with the number of variants, not with their pairs.
+
+- **k groups:**
+  - If the LSH groups are more than k, they are clustered with k-modes on their signatures:
+    farthest-first initial centers from the heaviest group, assignment to the most similar
+    center, and centers updated position by position with a weighted majority vote. Every
+    step is O(groups * k * SIGNATURE_SIZE).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_xes.h"
+
+#define NGRAM_SIZE 2
+#define SIGNATURE_SIZE 64
+#define LSH_BANDS 16
+#define LSH_ROWS (SIGNATURE_SIZE / LSH_BANDS)
+#define LSH_THRESHOLD 0.5
+#define KMODES_ITERATIONS 20
+
+typedef unsigned long long Signature[SIGNATURE_SIZE];
+
+/* Function prototypes */
+int cluster_traces(const EncodedLog *enc, int k, int *case_cluster);
+int export_clusters(const Log *log, const int *case_cluster, int cluster_count, const char *prefix);
+
+/* Main function (left out with -DK_CLI, e.g. when compiled into k.c) */
+#ifndef K_CLI
+int main(int argc, char *argv[]) {
+    if (argc != 4 || atoi(argv[2]) < 1) {
+        fprintf(stderr, "Usage: %s input.xes k output_prefix\n", argv[0]);
+        return 1;
+    }
+
+    FILE *fp = fopen(argv[1], "r");
+    if (!fp) {
+        perror("Failed to open input file");
+        return 1;
+    }
+    Log *log = create_log();
+    parse_xes(fp, log);
+    fclose(fp);
+    EncodedLog *enc = encode_log(log);
+
+    int *case_cluster = (int *)malloc(sizeof(int) * (enc->case_count > 0 ? enc->case_count : 1));
+    int clusters = cluster_traces(enc, atoi(argv[2]), case_cluster);
+    int status = export_clusters(log, case_cluster, clusters, argv[3]);
+
+    free(case_cluster);
+    free_encoded_log(enc);
+    free_log(log);
+    return status == 0 ? 0 : 1;
+}
+#endif
+
+/* Hashing */
+
+/* splitmix64 finalizer */
+static unsigned long long mix64(unsigned long long x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+static unsigned long long hash_ints(const int *values, int count) {
+    unsigned long long h = 14695981039346656037ull;
+    for (int i = 0; i < count; i++) {
+        h ^= (unsigned long long)(unsigned int)values[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* Variants */
+
+typedef struct {
+    int count;                  /* number of variants */
+    int *representative;        /* variant -> first case */
+    int *weight;                /* variant -> number of cases */
+    int *case_variant;          /* case -> variant */
+} Variants;
+
+static int same_sequence(const EncodedLog *enc, int a, int b) {
+    int length = enc->case_offsets[a + 1] - enc->case_offsets[a];
+    return length == enc->case_offsets[b + 1] - enc->case_offsets[b] &&
+           memcmp(enc->events + enc->case_offsets[a], enc->events + enc->case_offsets[b], sizeof(int) * length) == 0;
+}
+
+static void find_variants(const EncodedLog *enc, Variants *v) {
+    int n = enc->case_count;
+    unsigned int capacity = 16;
+    while (capacity < (unsigned int)n * 2) capacity *= 2;
+    int *slots = (int *)malloc(sizeof(int) * capacity);
+    for (unsigned int i = 0; i < capacity; i++) slots[i] = -1;
+
+    v->count = 0;
+    v->representative = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    v->weight = (int *)calloc(n > 0 ? n : 1, sizeof(int));
+    v->case_variant = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    for (int c = 0; c < n; c++) {
+        const int *events = enc->events + enc->case_offsets[c];
+        unsigned int slot = (unsigned int)hash_ints(events, enc->case_offsets[c + 1] - enc->case_offsets[c]) & (capacity - 1);
+        int id;
+        while ((id = slots[slot]) >= 0 && !same_sequence(enc, v->representative[id], c)) slot = (slot + 1) & (capacity - 1);
+        if (id < 0) {
+            id = v->count++;
+            slots[slot] = id;
+            v->representative[id] = c;
+        }
+        v->weight[id]++;
+        v->case_variant[c] = id;
+    }
+    free(slots);
+}
+
+static void free_variants(Variants *v) {
+    free(v->representative);
+    free(v->weight);
+    free(v->case_variant);
+}
+
+/* MinHash */
+
+static void compute_signature(const EncodedLog *enc, int c, const unsigned long long *seeds, unsigned long long *signature) {
+    const int *events = enc->events + enc->case_offsets[c];
+    int length = enc->case_offsets[c + 1] - enc->case_offsets[c];
+    int gram[NGRAM_SIZE];
+    for (int h = 0; h < SIGNATURE_SIZE; h++) signature[h] = ~0ull;
+
+    /* Positions -NGRAM_SIZE + 1 .. length - 1, outside the trace: -1 (start), -2 (end) */
+    for (int start = 1 - NGRAM_SIZE; start < length || (length == 0 && start < 1); start++) {
+        for (int j = 0; j < NGRAM_SIZE; j++) {
+            int i = start + j;
+            gram[j] = i < 0 ? -1 : i >= length ? -2 : events[i];
+        }
+        unsigned long long g = hash_ints(gram, NGRAM_SIZE);
+        for (int h = 0; h < SIGNATURE_SIZE; h++) {
+            unsigned long long x = mix64(g ^ seeds[h]);
+            if (x < signature[h]) signature[h] = x;
+        }
+    }
+}
+
+static double similarity(const unsigned long long *a, const unsigned long long *b) {
+    int equal = 0;
+    for (int h = 0; h < SIGNATURE_SIZE; h++) equal += a[h] == b[h];
+    return (double)equal / SIGNATURE_SIZE;
+}
+
+/* LSH banding */
+
+static int find_root(int *parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+typedef struct {
+    unsigned long long key;
+    int variant;
+} BandEntry;
+
+static int compare_band_entries(const void *a, const void *b) {
+    const BandEntry *x = (const BandEntry *)a, *y = (const BandEntry *)b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return x->variant - y->variant;
+}
+
+/* Join the variants that share a band bucket with similar signatures; parent is the union-find */
+static void lsh_groups(Signature *signatures, int n, int *parent) {
+    BandEntry *entries = (BandEntry *)malloc(sizeof(BandEntry) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) parent[i] = i;
+    for (int band = 0; band < LSH_BANDS; band++) {
+        for (int i = 0; i < n; i++) {
+            unsigned long long key = band;
+            for (int r = 0; r < LSH_ROWS; r++) key = mix64(key ^ signatures[i][band * LSH_ROWS + r]);
+            entries[i].key = key;
+            entries[i].variant = i;
+        }
+        qsort(entries, n, sizeof(BandEntry), compare_band_entries);
+        for (int i = 0; i < n;) {
+            int j = i + 1;
+            int first = entries[i].variant;
+            while (j < n && entries[j].key == entries[i].key) {
+                int other = entries[j].variant;
+                if (similarity(signatures[first], signatures[other]) >= LSH_THRESHOLD) {
+                    int a = find_root(parent, first), b = find_root(parent, other);
+                    if (a != b) parent[b] = a;
+                }
+                j++;
+            }
+            i = j;
+        }
+    }
+    free(entries);
+}
+
+/* k-modes */
+
+/* Cluster the n weighted signatures into k groups with k-modes; assignment[i] is the group of i */
+static void kmodes(Signature *signatures, const long long *weights, int n, int k, int *assignment) {
+    Signature *centers = (Signature *)malloc(sizeof(Signature) * k);
+    double *best = (double *)malloc(sizeof(double) * n);
+    long long *votes = (long long *)malloc(sizeof(long long) * k);
+    unsigned long long *candidates = (unsigned long long *)malloc(sizeof(unsigned long long) * k);
+
+    /* Farthest-first: the heaviest first, then the one least similar to its nearest center */
+    int first = 0;
+    for (int i = 1; i < n; i++) if (weights[i] > weights[first]) first = i;
+    memcpy(centers[0], signatures[first], sizeof(Signature));
+    for (int i = 0; i < n; i++) best[i] = similarity(signatures[i], centers[0]);
+    for (int c = 1; c < k; c++) {
+        int next = 0;
+        for (int i = 1; i < n; i++) if (best[i] < best[next]) next = i;
+        memcpy(centers[c], signatures[next], sizeof(Signature));
+        for (int i = 0; i < n; i++) {
+            double s = similarity(signatures[i], centers[c]);
+            if (s > best[i]) best[i] = s;
+        }
+    }
+
+    for (int iteration = 0; iteration < KMODES_ITERATIONS; iteration++) {
+        int changed = 0;
+        for (int i = 0; i < n; i++) {
+            int nearest = 0;
+            double nearest_similarity = -1;
+            for (int c = 0; c < k; c++) {
+                double s = similarity(signatures[i], centers[c]);
+                if (s > nearest_similarity) {
+                    nearest_similarity = s;
+                    nearest = c;
+                }
+            }
+            if (iteration == 0 || assignment[i] != nearest) changed = 1;
+            assignment[i] = nearest;
+        }
+        if (!changed) break;
+
+        /* Weighted majority vote per position (Boyer-Moore); empty groups keep their center */
+        for (int h = 0; h < SIGNATURE_SIZE; h++) {
+            for (int c = 0; c < k; c++) {
+                votes[c] = 0;
+                candidates[c] = centers[c][h];
+            }
+            for (int i = 0; i < n; i++) {
+                int c = assignment[i];
+                if (signatures[i][h] == candidates[c]) {
+                    votes[c] += weights[i];
+                } else if (votes[c] >= weights[i]) {
+                    votes[c] -= weights[i];
+                } else {
+                    candidates[c] = signatures[i][h];
+                    votes[c] = weights[i] - votes[c];
+                }
+            }
+            for (int c = 0; c < k; c++) centers[c][h] = candidates[c];
+        }
+    }
+
+    free(centers);
+    free(best);
+    free(votes);
+    free(candidates);
+}
+
+/*
+ * Cluster the cases of enc into at most k groups of similar variants (all cases of a variant
+ * are in the same group); writes the group of each case to case_cluster and returns the
+ * number of groups, numbered by their first case
+ */
+int cluster_traces(const EncodedLog *enc, int k, int *case_cluster) {
+    if (k < 1) k = 1;
+    Variants v;
+    find_variants(enc, &v);
+    int n = v.count;
+
+    unsigned long long seeds[SIGNATURE_SIZE];
+    for (int h = 0; h < SIGNATURE_SIZE; h++) seeds[h] = mix64(0x9e3779b97f4a7c15ull * (h + 1));
+    Signature *signatures = (Signature *)malloc(sizeof(Signature) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) compute_signature(enc, v.representative[i], seeds, signatures[i]);
+
+    /* LSH groups, numbered densely, with the signature of their heaviest variant */
+    int *parent = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    lsh_groups(signatures, n, parent);
+    int *group = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *group_head = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    long long *group_weight = (long long *)calloc(n > 0 ? n : 1, sizeof(long long));
+    int group_count = 0;
+    for (int i = 0; i < n; i++) group[i] = -1;
+    for (int i = 0; i < n; i++) {
+        int root = find_root(parent, i);
+        if (group[root] < 0) {
+            group[root] = group_count;
+            group_head[group_count++] = i;
+        }
+        int g = group[root];
+        group[i] = g;
+        if (v.weight[i] > v.weight[group_head[g]]) group_head[g] = i;
+        group_weight[g] += v.weight[i];
+    }
+
+    int *group_cluster = (int *)malloc(sizeof(int) * (group_count > 0 ? group_count : 1));
+    if (group_count > k) {
+        Signature *group_signatures = (Signature *)malloc(sizeof(Signature) * group_count);
+        for (int g = 0; g < group_count; g++) memcpy(group_signatures[g], signatures[group_head[g]], sizeof(Signature));
+        kmodes(group_signatures, group_weight, group_count, k, group_cluster);
+        free(group_signatures);
+    } else {
+        for (int g = 0; g < group_count; g++) group_cluster[g] = g;
+    }
+
+    /* Number the clusters by their first case */
+    int clusters = group_count < k ? group_count : k;
+    int *number = (int *)malloc(sizeof(int) * (clusters > 0 ? clusters : 1));
+    for (int c = 0; c < clusters; c++) number[c] = -1;
+    int cluster_count = 0;
+    for (int c = 0; c < enc->case_count; c++) {
+        int cluster = group_cluster[group[v.case_variant[c]]];
+        if (number[cluster] < 0) number[cluster] = cluster_count++;
+        case_cluster[c] = number[cluster];
+    }
+
+    free(number);
+    free(group_cluster);
+    free(group);
+    free(group_head);
+    free(group_weight);
+    free(parent);
+    free(signatures);
+    free_variants(&v);
+    return cluster_count;
+}
+
+/* Write the cases of each cluster to prefix_<cluster>.xes with export_xes: 0 on success */
+int export_clusters(const Log *log, const int *case_cluster, int cluster_count, const char *prefix) {
+    /* Shallow view of the cases of one cluster, sharing the activity strings of log */
+    Log view;
+    view.cases = (Case *)malloc(sizeof(Case) * (log->case_count > 0 ? log->case_count : 1));
+    view.case_capacity = log->case_count;
+    int status = 0;
+
+    for (int cluster = 0; cluster < cluster_count && status == 0; cluster++) {
+        view.case_count = 0;
+        for (int c = 0; c < log->case_count; c++) {
+            if (case_cluster[c] == cluster) view.cases[view.case_count++] = log->cases[c];
+        }
+        char filename[4096];
+        snprintf(filename, sizeof(filename), "%s_%d.xes", prefix, cluster);
+        FILE *fp = fopen(filename, "w");
+        if (!fp) {
+            perror("Failed to open output file");
+            status = -1;
+            break;
+        }
+        export_xes(fp, &view);
+        fclose(fp);
+        printf("Cluster %d: %d cases -> %s\n", cluster, view.case_count, filename);
+    }
+
+    free(view.cases);
+    return status;
+}
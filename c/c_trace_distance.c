@@ -0,0 +1,232 @@
+/*
+ * Trace distance - edit distances between activity sequences (see c_trace_distance.h)
+ * Implemented in ANSI C; the batch API is parallel with OpenMP (-fopenmp), sequential without
+ *
+ * **Main Components:**
+
+- **Bit-parallel columns:**
+  - The query is the vertical side of the matrix. A column is kept as two bitsets of vertical
+    differences (+1, -1) and advanced over one text event with the match bitset of its
+    activity: an addition propagates the matches down the column, so a column costs O(words)
+    instead of O(query length). Multi-word columns pass the horizontal difference at the
+    bottom of each word on to the next word (Hyyro's formulation).
+
+- **Band:**
+  - With a threshold max, rows more than max below the diagonal can not be on a path within
+    max. Their words start as if untouched (distance growing by one per row, an upper bound)
+    and are only computed once the band reaches them; cells within max are still exact.
+
+- **Early exit:**
+  - Every EXIT_CHECK_INTERVAL columns the distances of the computed cells are summed up
+    from the top row (D[0][j] = j) and each is extended by the length difference still to
+    cover; if none stays within max, the distance is above max and the text is left.
+
+- **Batch:**
+  - One pattern, many texts: each thread keeps its own column words and takes the texts in
+    chunks (dynamic schedule, since the texts differ in length).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_trace_distance.h"
+
+#define EXIT_CHECK_INTERVAL 16
+
+TracePattern *create_trace_pattern(const int *query, int length, int alphabet) {
+    TracePattern *p = (TracePattern *)malloc(sizeof(TracePattern));
+    p->length = length;
+    p->words = bitset_words(length);
+    p->alphabet = alphabet;
+    p->peq = bitset_alloc((alphabet > 0 ? alphabet : 1) * (p->words > 0 ? p->words : 1));
+    for (int i = 0; i < length; i++) {
+        if (query[i] >= 0 && query[i] < alphabet) bitset_set(p->peq + (size_t)query[i] * p->words, i);
+    }
+    return p;
+}
+
+void free_trace_pattern(TracePattern *p) {
+    free(p->peq);
+    free(p);
+}
+
+/*
+ * Advance one word of the column over a text event: eq are the matches of the event in the
+ * word, h_in the horizontal difference above the word (-1, 0, +1) and high the bit of the
+ * row whose horizontal difference is returned (the last row of the word or of the query)
+ */
+static int advance_word(bitset_word *pv, bitset_word *mv, bitset_word eq, int h_in, bitset_word high) {
+    bitset_word xv = eq | *mv;
+    if (h_in < 0) eq |= 1;
+    bitset_word xh = (((eq & *pv) + *pv) ^ *pv) | eq;
+    bitset_word ph = *mv | ~(xh | *pv);
+    bitset_word mh = *pv & xh;
+    int h_out = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+    ph <<= 1;
+    mh <<= 1;
+    if (h_in < 0) mh |= 1;
+    else if (h_in > 0) ph |= 1;
+    *pv = mh | ~(xv | ph);
+    *mv = ph & xv;
+    return h_out;
+}
+
+/* 1 if a computed cell of column j (words 0 .. last) can still end within max */
+static int within_reach(const TracePattern *p, const bitset_word *pv, const bitset_word *mv, int last, int j, int n, int max) {
+    int m = p->length;
+    int d = j;
+    if (d + abs(m - (n - j)) <= max) return 1;
+    for (int w = 0; w <= last; w++) {
+        int rows = m - w * 64 < 64 ? m - w * 64 : 64;
+        for (int b = 0; b < rows; b++) {
+            d += (int)(pv[w] >> b & 1) - (int)(mv[w] >> b & 1);
+            int i = w * 64 + b + 1;
+            if (d + abs((m - i) - (n - j)) <= max) return 1;
+        }
+    }
+    return 0;
+}
+
+/* Distance of the query to text, bounded by max if max >= 0; pv and mv hold p->words words */
+static int myers(const TracePattern *p, const int *text, int n, int max, bitset_word *pv, bitset_word *mv) {
+    int m = p->length;
+    int words = p->words;
+    if (max >= 0 && abs(m - n) > max) return max + 1;
+    if (m == 0) return n;
+
+    bitset_word high = (bitset_word)1 << ((m - 1) & 63);
+    if (words == 1) {
+        /* Queries of up to 64 events (most traces): one word, no band */
+        bitset_word zero = 0;
+        int d = m;
+        pv[0] = ~(bitset_word)0;
+        mv[0] = 0;
+        for (int j = 1; j <= n; j++) {
+            int a = text[j - 1];
+            d += advance_word(pv, mv, a >= 0 && a < p->alphabet ? p->peq[a] : zero, 1, high);
+            if (max >= 0 && j % EXIT_CHECK_INTERVAL == 0 && j < n && !within_reach(p, pv, mv, 0, j, n, max)) return max + 1;
+        }
+        return max >= 0 && d > max ? max + 1 : d;
+    }
+
+    /* Words 0 .. last are computed; rows below the band (i > j + max) wait */
+    int last = words - 1;
+    if (max >= 0 && max / 64 < last) last = max / 64;
+    for (int w = 0; w <= last; w++) {
+        pv[w] = ~(bitset_word)0;
+        mv[w] = 0;
+    }
+    int bottom = (last + 1) * 64 < m ? (last + 1) * 64 : m;    /* D at the last row of word last */
+    bitset_word zero = 0;
+
+    for (int j = 1; j <= n; j++) {
+        if (last < words - 1 && (last + 1) * 64 + 1 <= j + max) {
+            last++;
+            pv[last] = ~(bitset_word)0;
+            mv[last] = 0;
+            bottom += m - last * 64 < 64 ? m - last * 64 : 64;
+        }
+
+        int a = text[j - 1];
+        const bitset_word *eq = a >= 0 && a < p->alphabet ? p->peq + (size_t)a * words : NULL;
+        int h = 1;      /* D[0][j] - D[0][j - 1] */
+        for (int w = 0; w <= last; w++) {
+            h = advance_word(&pv[w], &mv[w], eq ? eq[w] : zero, h, w == words - 1 ? high : (bitset_word)1 << 63);
+        }
+        bottom += h;
+
+        if (max >= 0 && j % EXIT_CHECK_INTERVAL == 0 && j < n && !within_reach(p, pv, mv, last, j, n, max)) return max + 1;
+    }
+    return max >= 0 && bottom > max ? max + 1 : bottom;
+}
+
+int bounded_trace_distance(const TracePattern *p, const int *text, int length, int max) {
+    bitset_word *v = bitset_alloc(2 * (p->words > 0 ? p->words : 1));
+    int d = myers(p, text, length, max, v, v + p->words);
+    free(v);
+    return d;
+}
+
+int trace_distance(const TracePattern *p, const int *text, int length) {
+    return bounded_trace_distance(p, text, length, -1);
+}
+
+int edit_distance(const int *a, int a_length, const int *b, int b_length, int alphabet) {
+    /* The shorter sequence is the pattern (fewer words per column) */
+    if (a_length > b_length) {
+        const int *t = a;
+        a = b;
+        b = t;
+        int l = a_length;
+        a_length = b_length;
+        b_length = l;
+    }
+    TracePattern *p = create_trace_pattern(a, a_length, alphabet);
+    int d = trace_distance(p, b, b_length);
+    free_trace_pattern(p);
+    return d;
+}
+
+void trace_distances(const TracePattern *p, const EncodedLog *texts, int max, int *out) {
+#pragma omp parallel
+    {
+        bitset_word *v = bitset_alloc(2 * (p->words > 0 ? p->words : 1));
+#pragma omp for schedule(dynamic, 1024)
+        for (int c = 0; c < texts->case_count; c++) {
+            int from = texts->case_offsets[c];
+            out[c] = myers(p, texts->events + from, texts->case_offsets[c + 1] - from, max, v, v + p->words);
+        }
+        free(v);
+    }
+}
+
+/* Variants */
+
+static unsigned int hash_sequence(const int *events, int length) {
+    unsigned int h = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        h ^= (unsigned int)events[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+EncodedLog *encode_variants(const EncodedLog *enc, int *case_variant) {
+    EncodedLog *variants = (EncodedLog *)malloc(sizeof(EncodedLog));
+    init_activity_dictionary(&variants->dictionary);
+    for (int a = 0; a < enc->dictionary.count; a++) intern_activity(&variants->dictionary, enc->dictionary.names[a]);
+    variants->case_count = 0;
+    variants->event_count = 0;
+    variants->case_offsets = (int *)malloc(sizeof(int) * (enc->case_count + 1));
+    variants->events = (int *)malloc(sizeof(int) * (enc->event_count > 0 ? enc->event_count : 1));
+    variants->case_offsets[0] = 0;
+
+    unsigned int capacity = 16;
+    while (capacity < (unsigned int)enc->case_count * 2) capacity *= 2;
+    int *slots = (int *)malloc(sizeof(int) * capacity);
+    for (unsigned int i = 0; i < capacity; i++) slots[i] = -1;
+
+    for (int c = 0; c < enc->case_count; c++) {
+        const int *events = enc->events + enc->case_offsets[c];
+        int length = enc->case_offsets[c + 1] - enc->case_offsets[c];
+        unsigned int slot = hash_sequence(events, length) & (capacity - 1);
+        int v;
+        while ((v = slots[slot]) >= 0) {
+            int from = variants->case_offsets[v];
+            if (variants->case_offsets[v + 1] - from == length &&
+                memcmp(variants->events + from, events, sizeof(int) * length) == 0) break;
+            slot = (slot + 1) & (capacity - 1);
+        }
+        if (v < 0) {
+            v = variants->case_count++;
+            slots[slot] = v;
+            memcpy(variants->events + variants->event_count, events, sizeof(int) * length);
+            variants->event_count += length;
+            variants->case_offsets[variants->case_count] = variants->event_count;
+        }
+        if (case_variant) case_variant[c] = v;
+    }
+    free(slots);
+    return variants;
+}
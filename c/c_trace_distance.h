@@ -0,0 +1,52 @@
+/*
+ * Trace distance - edit distances between activity sequences
+ *
+ * The Levenshtein distance (insertions, deletions and substitutions of one
+ * event, each costing 1) between sequences of activity ids of an EncodedLog.
+ * A query is compiled once into a TracePattern (one match bitset per activity
+ * of the alphabet) and compared with any number of texts by the bit-parallel
+ * algorithm of Myers: one column of the dynamic programming matrix costs a few
+ * word operations per 64 query events. Library module without a main.
+ *
+ * Threshold queries (bounded_trace_distance, max >= 0) only compute the band
+ * of the matrix around the diagonal that can stay within max and stop as soon
+ * as no cell of the current column can lead to a distance within max; they
+ * return max + 1 for every text farther than max.
+ */
+
+#ifndef C_TRACE_DISTANCE_H
+#define C_TRACE_DISTANCE_H
+
+#include "c_bitset.h"
+#include "c_xes.h"
+
+typedef struct {
+    int length;             /* query events */
+    int words;              /* bitset_words(length) */
+    int alphabet;           /* activity ids 0 .. alphabet - 1 */
+    bitset_word *peq;       /* alphabet x words: bit i of row a is set if query[i] == a */
+} TracePattern;
+
+/* Compile a query over activity ids 0 .. alphabet - 1 (ids outside match nothing) */
+TracePattern *create_trace_pattern(const int *query, int length, int alphabet);
+void free_trace_pattern(TracePattern *p);
+
+/* Edit distance between the query and text */
+int trace_distance(const TracePattern *p, const int *text, int length);
+/* Edit distance between the query and text if at most max, max + 1 otherwise */
+int bounded_trace_distance(const TracePattern *p, const int *text, int length, int max);
+/* Edit distance between two sequences of ids below alphabet */
+int edit_distance(const int *a, int a_length, const int *b, int b_length, int alphabet);
+
+/*
+ * Batch: distance of the query to every case of texts (its ids must be those of the alphabet
+ * of the pattern) into out, bounded by max (max < 0: exact); the cases are divided among
+ * OpenMP threads
+ */
+void trace_distances(const TracePattern *p, const EncodedLog *texts, int max, int *out);
+
+/* The distinct activity sequences of enc as a log (in order of first occurrence), with the
+   variant of each case to case_variant (case_count entries) if not NULL */
+EncodedLog *encode_variants(const EncodedLog *enc, int *case_variant);
+
+#endif
@@ -0,0 +1,499 @@
+/*
+ * Tree-based trace fitness
+ * Checks which traces of an XES event log belong to the language of a process tree (PTML),
+ * directly on the tree, without converting it into a Petri net
+ * Implemented in ANSI C on top of c_process_tree.c and c_xes.c
+ *
+ * Build: cc -O2 -DK_LIB -o c_tree_fitness c_tree_fitness.c c_process_tree.c c_xes.c
+ * Usage: c_tree_fitness input.ptml input.xes
+ * Entry point: tree_fitness (declared in k.h)
+ *
+ * **Main Components:**
+
+- **Membership on segments:**
+  - accepts(node, i, j) tells whether the subtree of node can produce the events i..j-1 of the
+    trace; results are memoized in a hash table keyed by (node, i, j), so every sub-tree state
+    is evaluated once per trace.
+  - Sequence: positions reachable after each child; loop: fixpoint of do (redo do)* over the
+    positions, followed by the exit child if any (see c_process_tree.h); exclusive choice: any
+    child.
+  - Parallel ('and', 'or'): when the alphabets of the children are disjoint, every child checks
+    the projection of the segment on its own alphabet (with its own memo table); otherwise the
+    events are assigned to the children by backtracking.
+  - Precomputed per node: alphabet (bitset over labels) and whether the empty trace is accepted,
+    to reject segments early.
+
+- **Variants:**
+  - Traces are checked once per variant (hash table over the encoded activity sequences), in
+    `tree_fitness` (also used by the `k replay` command).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_bitset.h"
+#include "c_process_tree.h"
+#include "c_xes.h"
+
+typedef struct {
+    const ProcessTree *tree;
+    int words;                  /* words per alphabet bitset */
+    bitset_word *alphabets;     /* alphabet of every node (row per node) */
+    char *nullable;             /* nullable[n]: the subtree accepts the empty trace */
+    char *disjoint;             /* disjoint[n]: the children have disjoint alphabets */
+} TreeChecker;
+
+/* A word (sequence of tree labels) with the memo table of its segments */
+typedef struct {
+    const int *word;
+    int len;
+    unsigned long long *keys;   /* 0: empty slot */
+    char *values;
+    int count;
+    int capacity;               /* power of two */
+} Memo;
+
+#define ALPHABET(checker, node) ((checker)->alphabets + (size_t)(node) * (checker)->words)
+
+/* Function prototypes */
+TreeChecker *create_tree_checker(const ProcessTree *tree);
+int tree_accepts_node(const TreeChecker *checker, int node, const int *word, int len);
+int tree_accepts(const TreeChecker *checker, const int *word, int len);
+void free_tree_checker(TreeChecker *checker);
+int tree_fitness(const ProcessTree *tree, const EncodedLog *enc, int *variant_count, int *fitting_variants);
+
+static int accepts(const TreeChecker *checker, Memo *memo, int node, int i, int j);
+
+/* Alphabet and nullability of the subtree of node (post-order) */
+static void analyze_node(TreeChecker *checker, int node) {
+    const ProcessTree *tree = checker->tree;
+    const TreeNode *n = &tree->nodes[node];
+    int w = checker->words;
+    bitset_word *alphabet = ALPHABET(checker, node);
+    int child_count = 0, all_nullable = 1, any_nullable = 0, total = 0;
+
+    for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling) {
+        analyze_node(checker, c);
+        bitset_or(alphabet, alphabet, ALPHABET(checker, c), w);
+        total += bitset_count(ALPHABET(checker, c), w);
+        all_nullable &= checker->nullable[c];
+        any_nullable |= checker->nullable[c];
+        child_count++;
+    }
+    checker->disjoint[node] = total == bitset_count(alphabet, w);
+
+    switch (n->op) {
+    case PT_TASK:
+        bitset_set(alphabet, n->label);
+        checker->nullable[node] = 0;
+        break;
+    case PT_SEQUENCE:
+    case PT_PARALLEL:
+        checker->nullable[node] = (char)all_nullable;
+        break;
+    case PT_XOR:
+    case PT_OR:
+        checker->nullable[node] = (char)(any_nullable || child_count == 0);
+        break;
+    case PT_LOOP: {
+        int exit_child = child_count >= 3 ? n->last_child : -1;
+        checker->nullable[node] = (char)(checker->nullable[n->first_child] &&
+                                         (exit_child < 0 || checker->nullable[exit_child]));
+        break;
+    }
+    default:
+        checker->nullable[node] = 1;
+        break;
+    }
+}
+
+TreeChecker *create_tree_checker(const ProcessTree *tree) {
+    TreeChecker *checker = (TreeChecker *)malloc(sizeof(TreeChecker));
+    checker->tree = tree;
+    checker->words = bitset_words(tree->label_count);
+    checker->alphabets = bitset_alloc((tree->node_count + 1) * checker->words);
+    checker->nullable = (char *)calloc(tree->node_count + 1, 1);
+    checker->disjoint = (char *)calloc(tree->node_count + 1, 1);
+    if (tree->root >= 0) analyze_node(checker, tree->root);
+    return checker;
+}
+
+void free_tree_checker(TreeChecker *checker) {
+    free(checker->alphabets);
+    free(checker->nullable);
+    free(checker->disjoint);
+    free(checker);
+}
+
+/* Memo table */
+
+static void memo_init(Memo *memo, const int *word, int len) {
+    memo->word = word;
+    memo->len = len;
+    memo->count = 0;
+    memo->capacity = 64;
+    memo->keys = (unsigned long long *)calloc(memo->capacity, sizeof(unsigned long long));
+    memo->values = (char *)malloc(memo->capacity);
+}
+
+static void memo_free(Memo *memo) {
+    free(memo->keys);
+    free(memo->values);
+}
+
+static unsigned long long memo_key(const Memo *memo, int node, int i, int j) {
+    unsigned long long span = (unsigned long long)memo->len + 1;
+    return ((unsigned long long)node * span + (unsigned long long)i) * span + (unsigned long long)j + 1;
+}
+
+static int memo_slot(const Memo *memo, unsigned long long key) {
+    unsigned long long h = key * 0x9E3779B97F4A7C15ull;
+    int mask = memo->capacity - 1;
+    int slot = (int)(h >> 32) & mask;
+    while (memo->keys[slot] && memo->keys[slot] != key) slot = (slot + 1) & mask;
+    return slot;
+}
+
+static void memo_put(Memo *memo, unsigned long long key, char value) {
+    if (2 * (memo->count + 1) > memo->capacity) {
+        unsigned long long *old_keys = memo->keys;
+        char *old_values = memo->values;
+        int old_capacity = memo->capacity;
+        memo->capacity *= 2;
+        memo->keys = (unsigned long long *)calloc(memo->capacity, sizeof(unsigned long long));
+        memo->values = (char *)malloc(memo->capacity);
+        for (int s = 0; s < old_capacity; s++) {
+            if (!old_keys[s]) continue;
+            int slot = memo_slot(memo, old_keys[s]);
+            memo->keys[slot] = old_keys[s];
+            memo->values[slot] = old_values[s];
+        }
+        free(old_keys);
+        free(old_values);
+    }
+    int slot = memo_slot(memo, key);
+    if (!memo->keys[slot]) memo->count++;
+    memo->keys[slot] = key;
+    memo->values[slot] = value;
+}
+
+/* Sequence of children, starting at position i: can the last child end at j? */
+static int accepts_sequence(const TreeChecker *checker, Memo *memo, int first_child, int i, int j) {
+    const ProcessTree *tree = checker->tree;
+    int width = j - i + 1;
+    char *reach = (char *)calloc(width, 1);
+    char *next = (char *)malloc(width);
+    reach[0] = 1;
+    for (int c = first_child; c >= 0; c = tree->nodes[c].next_sibling) {
+        int any = 0;
+        memset(next, 0, width);
+        for (int s = 0; s < width; s++) {
+            if (!reach[s]) continue;
+            for (int e = s; e < width; e++) {
+                if (!next[e] && accepts(checker, memo, c, i + s, i + e)) {
+                    next[e] = 1;
+                    any = 1;
+                }
+            }
+        }
+        memcpy(reach, next, width);
+        if (!any) break;
+    }
+    int result = reach[width - 1];
+    free(reach);
+    free(next);
+    return result;
+}
+
+/* Loop: do (redo do)* [exit] over the segment i..j-1 */
+static int accepts_loop(const TreeChecker *checker, Memo *memo, const TreeNode *n, int child_count, int i, int j) {
+    const ProcessTree *tree = checker->tree;
+    int width = j - i + 1;
+    int do_child = n->first_child;
+    int exit_child = child_count >= 3 ? n->last_child : -1;
+    /* after_do[s]: position i+s can be reached right after an execution of do */
+    char *after_do = (char *)calloc(width, 1);
+    char *after_redo = (char *)calloc(width, 1);
+    int *queue = (int *)malloc(sizeof(int) * width);
+    int head = 0, tail = 0;
+
+    for (int e = 0; e < width; e++) {
+        if (accepts(checker, memo, do_child, i, i + e)) {
+            after_do[e] = 1;
+            queue[tail++] = e;
+        }
+    }
+    while (head < tail) {
+        int s = queue[head++];
+        /* Any redo child, then do again */
+        for (int c = tree->nodes[do_child].next_sibling; c >= 0 && c != exit_child; c = tree->nodes[c].next_sibling) {
+            for (int m = s; m < width; m++) {
+                if (after_redo[m] || !accepts(checker, memo, c, i + s, i + m)) continue;
+                after_redo[m] = 1;
+                for (int e = m; e < width; e++) {
+                    if (!after_do[e] && accepts(checker, memo, do_child, i + m, i + e)) {
+                        after_do[e] = 1;
+                        queue[tail++] = e;
+                    }
+                }
+            }
+        }
+    }
+
+    int result = 0;
+    if (exit_child < 0) {
+        result = after_do[width - 1];
+    } else {
+        for (int s = 0; s < width && !result; s++) {
+            if (after_do[s] && accepts(checker, memo, exit_child, i + s, j)) result = 1;
+        }
+    }
+    free(after_do);
+    free(after_redo);
+    free(queue);
+    return result;
+}
+
+/* Backtracking assignment of the events of a parallel segment to children sharing labels */
+typedef struct {
+    const TreeChecker *checker;
+    const int *segment;
+    int len;
+    int *children;
+    int child_count;
+    int **words;        /* events assigned to every child so far */
+    int *lengths;
+    int optional;       /* 'or': children may be skipped */
+} Assignment;
+
+static int check_assignment(Assignment *a) {
+    int executed = 0;
+    for (int k = 0; k < a->child_count; k++) {
+        if (a->optional && a->lengths[k] == 0) continue;
+        if (!tree_accepts_node(a->checker, a->children[k], a->words[k], a->lengths[k])) return 0;
+        executed = 1;
+    }
+    return executed || !a->optional;
+}
+
+static int assign_events(Assignment *a, int e) {
+    if (e == a->len) return check_assignment(a);
+    int label = a->segment[e];
+    for (int k = 0; k < a->child_count; k++) {
+        if (!bitset_test(ALPHABET(a->checker, a->children[k]), label)) continue;
+        a->words[k][a->lengths[k]++] = label;
+        int result = assign_events(a, e + 1);
+        a->lengths[k]--;
+        if (result) return 1;
+    }
+    return 0;
+}
+
+static int accepts_parallel(const TreeChecker *checker, int node, const int *segment, int len) {
+    const ProcessTree *tree = checker->tree;
+    const TreeNode *n = &tree->nodes[node];
+    int child_count = 0;
+    for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling) child_count++;
+
+    Assignment a;
+    a.checker = checker;
+    a.segment = segment;
+    a.len = len;
+    a.child_count = child_count;
+    a.optional = n->op == PT_OR;
+    a.children = (int *)malloc(sizeof(int) * child_count);
+    a.words = (int **)malloc(sizeof(int *) * child_count);
+    a.lengths = (int *)calloc(child_count, sizeof(int));
+    int *storage = (int *)malloc(sizeof(int) * (child_count * (len + 1)));
+    int k = 0;
+    for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling, k++) {
+        a.children[k] = c;
+        a.words[k] = storage + k * (len + 1);
+    }
+
+    int result;
+    if (checker->disjoint[node]) {
+        /* Projection on the alphabet of every child */
+        for (int e = 0; e < len; e++) {
+            for (k = 0; k < child_count; k++) {
+                if (bitset_test(ALPHABET(checker, a.children[k]), segment[e])) {
+                    a.words[k][a.lengths[k]++] = segment[e];
+                    break;
+                }
+            }
+        }
+        result = check_assignment(&a);
+    } else {
+        result = assign_events(&a, 0);
+    }
+
+    free(storage);
+    free(a.children);
+    free(a.words);
+    free(a.lengths);
+    return result;
+}
+
+static int accepts(const TreeChecker *checker, Memo *memo, int node, int i, int j) {
+    const TreeNode *n = &checker->tree->nodes[node];
+    if (i == j) return checker->nullable[node];
+    if (n->op == PT_TASK) return j == i + 1 && memo->word[i] == n->label;
+    if (n->op == PT_TAU) return 0;
+
+    unsigned long long key = memo_key(memo, node, i, j);
+    int slot = memo_slot(memo, key);
+    if (memo->keys[slot]) return memo->values[slot];
+
+    int result = 1;
+    const bitset_word *alphabet = ALPHABET(checker, node);
+    for (int e = i; e < j; e++) {
+        if (!bitset_test(alphabet, memo->word[e])) {
+            result = 0;
+            break;
+        }
+    }
+    if (result) {
+        int child_count = 0;
+        for (int c = n->first_child; c >= 0; c = checker->tree->nodes[c].next_sibling) child_count++;
+        switch (n->op) {
+        case PT_SEQUENCE:
+            result = accepts_sequence(checker, memo, n->first_child, i, j);
+            break;
+        case PT_XOR:
+            result = 0;
+            for (int c = n->first_child; c >= 0 && !result; c = checker->tree->nodes[c].next_sibling) {
+                result = accepts(checker, memo, c, i, j);
+            }
+            break;
+        case PT_PARALLEL:
+        case PT_OR:
+            result = accepts_parallel(checker, node, memo->word + i, j - i);
+            break;
+        case PT_LOOP:
+            result = child_count > 0 && accepts_loop(checker, memo, n, child_count, i, j);
+            break;
+        default:
+            result = 0;
+            break;
+        }
+    }
+    memo_put(memo, key, (char)result);
+    return result;
+}
+
+/* Does the subtree of node accept the word? (labels of the tree) */
+int tree_accepts_node(const TreeChecker *checker, int node, const int *word, int len) {
+    Memo memo;
+    memo_init(&memo, word, len);
+    int result = accepts(checker, &memo, node, 0, len);
+    memo_free(&memo);
+    return result;
+}
+
+/* Does the tree accept the word? (labels of the tree, -1 for unknown activities) */
+int tree_accepts(const TreeChecker *checker, const int *word, int len) {
+    if (checker->tree->root < 0) return 0;
+    for (int e = 0; e < len; e++) {
+        if (word[e] < 0) return 0;
+    }
+    return tree_accepts_node(checker, checker->tree->root, word, len);
+}
+
+/* Variant table: open addressing over the activity sequences of the encoded log */
+typedef struct {
+    int case_index;     /* representative case, -1: empty slot */
+    int fits;
+} VariantEntry;
+
+static unsigned int hash_variant(const int *events, int len) {
+    unsigned int h = 2166136261u;
+    for (int e = 0; e < len; e++) {
+        h ^= (unsigned int)events[e];
+        h *= 16777619u;
+    }
+    return h ^ (unsigned int)len;
+}
+
+/* Check the traces of enc against the tree, once per variant; returns the number of fitting traces */
+int tree_fitness(const ProcessTree *tree, const EncodedLog *enc, int *variant_count, int *fitting_variants) {
+    /* Activity id of the log -> label of the tree (-1 if the tree does not contain it) */
+    ActivityDictionary labels;
+    init_activity_dictionary(&labels);
+    for (int l = 0; l < tree->label_count; l++) intern_activity(&labels, tree->labels[l]);
+    int *label_of = (int *)malloc(sizeof(int) * (enc->dictionary.count + 1));
+    for (int a = 0; a < enc->dictionary.count; a++) label_of[a] = lookup_activity(&labels, enc->dictionary.names[a]);
+
+    TreeChecker *checker = create_tree_checker(tree);
+    int capacity = 64;
+    while (capacity < 2 * enc->case_count) capacity *= 2;
+    VariantEntry *variants = (VariantEntry *)malloc(sizeof(VariantEntry) * capacity);
+    for (int s = 0; s < capacity; s++) variants[s].case_index = -1;
+    int *word = (int *)malloc(sizeof(int) * (enc->event_count + 1));
+    int fitting = 0;
+    *variant_count = 0;
+    *fitting_variants = 0;
+
+    for (int c = 0; c < enc->case_count; c++) {
+        const int *events = enc->events + enc->case_offsets[c];
+        int len = enc->case_offsets[c + 1] - enc->case_offsets[c];
+        int slot = (int)(hash_variant(events, len) & (unsigned int)(capacity - 1));
+        while (variants[slot].case_index >= 0) {
+            int other = variants[slot].case_index;
+            int other_len = enc->case_offsets[other + 1] - enc->case_offsets[other];
+            if (other_len == len && memcmp(enc->events + enc->case_offsets[other], events, sizeof(int) * len) == 0) break;
+            slot = (slot + 1) & (capacity - 1);
+        }
+        if (variants[slot].case_index < 0) {
+            for (int e = 0; e < len; e++) word[e] = label_of[events[e]];
+            variants[slot].case_index = c;
+            variants[slot].fits = tree_accepts(checker, word, len);
+            (*variant_count)++;
+            *fitting_variants += variants[slot].fits;
+        }
+        fitting += variants[slot].fits;
+    }
+
+    free(word);
+    free(variants);
+    free(label_of);
+    free_activity_dictionary(&labels);
+    free_tree_checker(checker);
+    return fitting;
+}
+
+#ifndef K_CLI
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s input.ptml input.xes\n", argv[0]);
+        return 1;
+    }
+
+    ProcessTree *tree = create_process_tree();
+    if (import_ptml(tree, argv[1]) != 0) {
+        free_process_tree(tree);
+        return 1;
+    }
+    FILE *fp = fopen(argv[2], "r");
+    if (!fp) {
+        perror("Failed to open input file");
+        free_process_tree(tree);
+        return 1;
+    }
+    Log *log = create_log();
+    parse_xes(fp, log);
+    fclose(fp);
+    EncodedLog *enc = encode_log(log);
+
+    int variant_count, fitting_variants;
+    int fitting = tree_fitness(tree, enc, &variant_count, &fitting_variants);
+    printf("Variants: %d (%d fitting)\n", variant_count, fitting_variants);
+    printf("Fitting traces: %d / %d\n", fitting, enc->case_count);
+    printf("Trace fitness: %.4f\n", enc->case_count ? (double)fitting / enc->case_count : 1.0);
+
+    free_encoded_log(enc);
+    free_log(log);
+    free_process_tree(tree);
+    return 0;
+}
+#endif
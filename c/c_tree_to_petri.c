@@ -0,0 +1,306 @@
+/*
+ * Process tree to accepting Petri net
+ * Converts a process tree (PTML, see process_tree_ptml.txt) into an accepting Petri net (PNML)
+ * Implemented in ANSI C on top of c_process_tree.c and c_pnml.c
+ *
+ * Build: cc -O2 -DK_LIB -o c_tree_to_petri c_tree_to_petri.c c_process_tree.c c_pnml.c
+ * Usage: c_tree_to_petri input.ptml output.pnml
+ * Entry point: process_tree_to_petri_net (declared in k.h)
+ *
+ * **Main Components:**
+
+- **Block translation:**
+  - Every node is translated between an entry and an exit place: a task (or tau) becomes a
+    transition, a sequence chains its children through new places, an exclusive choice shares
+    the entry and exit place among its children, a parallel node uses a silent split and join,
+    and a loop connects do (entry -> middle), redo (middle -> entry) and exit (middle -> exit).
+  - The 'or' operator is over-approximated as a parallel node whose children can be skipped.
+  - The net is built on integer place/transition ids and only converted to the PetriNet
+    structure of c_pnml.c at the end.
+
+- **Tau reduction:**
+  - A silent transition t with •t = {p}, t• = {q} and p• = {t} is removed and q is fused into
+    p (fusion of series places, which preserves the language). Silent self-loops (•t = t• =
+    {p}) are removed as well. Places are fused with union-find and the rule is applied until
+    no transition can be removed.
+
+- **Accepting net:**
+  - 'source' carries the initial marking (1 token), 'sink' the final marking (1 token).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_pnml.h"
+#include "c_process_tree.h"
+
+typedef struct {
+    int place;
+    int transition;
+    int to_transition;  /* 1: place -> transition, 0: transition -> place */
+} NetArc;
+
+/* Petri net over integer ids, as produced by the block translation */
+typedef struct {
+    int place_count;
+    int *transition_labels;     /* tree label of every transition, -1 if silent */
+    char *removed;              /* removed[t]: transition t was reduced */
+    int transition_count;
+    int transition_capacity;
+    NetArc *arcs;
+    int arc_count;
+    int arc_capacity;
+} TreeNet;
+
+/* Function prototypes */
+PetriNet *process_tree_to_petri_net(const ProcessTree *tree);
+
+static int new_place(TreeNet *net) {
+    return net->place_count++;
+}
+
+static int new_transition(TreeNet *net, int label) {
+    if (net->transition_count >= net->transition_capacity) {
+        net->transition_capacity = net->transition_capacity ? net->transition_capacity * 2 : 64;
+        net->transition_labels = (int *)realloc(net->transition_labels, sizeof(int) * net->transition_capacity);
+    }
+    net->transition_labels[net->transition_count] = label;
+    return net->transition_count++;
+}
+
+static void new_arc(TreeNet *net, int place, int transition, int to_transition) {
+    if (net->arc_count >= net->arc_capacity) {
+        net->arc_capacity = net->arc_capacity ? net->arc_capacity * 2 : 128;
+        net->arcs = (NetArc *)realloc(net->arcs, sizeof(NetArc) * net->arc_capacity);
+    }
+    net->arcs[net->arc_count].place = place;
+    net->arcs[net->arc_count].transition = transition;
+    net->arcs[net->arc_count].to_transition = to_transition;
+    net->arc_count++;
+}
+
+/* Transition from place 'from' to place 'to' */
+static void connect(TreeNet *net, int from, int to, int label) {
+    int t = new_transition(net, label);
+    new_arc(net, from, t, 1);
+    new_arc(net, to, t, 0);
+}
+
+/* Translate the subtree of node between the places entry and exit */
+static void translate(const ProcessTree *tree, TreeNet *net, int node, int entry, int exit) {
+    const TreeNode *n = &tree->nodes[node];
+    int child_count = 0;
+    for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling) child_count++;
+
+    switch (n->op) {
+    case PT_TASK:
+        connect(net, entry, exit, n->label);
+        return;
+    case PT_TAU:
+        connect(net, entry, exit, -1);
+        return;
+    default:
+        break;
+    }
+    if (child_count == 0) {
+        /* Operator without children: behaves as a silent step */
+        connect(net, entry, exit, -1);
+        return;
+    }
+
+    switch (n->op) {
+    case PT_SEQUENCE: {
+        int current = entry;
+        for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling) {
+            int next = tree->nodes[c].next_sibling >= 0 ? new_place(net) : exit;
+            translate(tree, net, c, current, next);
+            current = next;
+        }
+        break;
+    }
+    case PT_XOR:
+        for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling) {
+            translate(tree, net, c, entry, exit);
+        }
+        break;
+    case PT_PARALLEL:
+    case PT_OR: {
+        int split = new_transition(net, -1);
+        int join = new_transition(net, -1);
+        new_arc(net, entry, split, 1);
+        new_arc(net, exit, join, 0);
+        for (int c = n->first_child; c >= 0; c = tree->nodes[c].next_sibling) {
+            int child_entry = new_place(net);
+            int child_exit = new_place(net);
+            new_arc(net, child_entry, split, 0);
+            new_arc(net, child_exit, join, 1);
+            translate(tree, net, c, child_entry, child_exit);
+            if (n->op == PT_OR) connect(net, child_entry, child_exit, -1);
+        }
+        break;
+    }
+    case PT_LOOP: {
+        int do_entry = new_place(net);
+        int middle = new_place(net);
+        int c = n->first_child;
+        connect(net, entry, do_entry, -1);
+        translate(tree, net, c, do_entry, middle);
+        int exit_child = child_count >= 3 ? n->last_child : -1;
+        for (c = tree->nodes[c].next_sibling; c >= 0 && c != exit_child; c = tree->nodes[c].next_sibling) {
+            translate(tree, net, c, middle, do_entry);
+        }
+        if (exit_child >= 0) translate(tree, net, exit_child, middle, exit);
+        else connect(net, middle, exit, -1);
+        break;
+    }
+    default:
+        connect(net, entry, exit, -1);
+        break;
+    }
+}
+
+static int find_place(int *parent, int p) {
+    while (parent[p] != p) {
+        parent[p] = parent[parent[p]];
+        p = parent[p];
+    }
+    return p;
+}
+
+/* Remove redundant silent transitions, fusing places in parent (union-find) */
+static void reduce_taus(TreeNet *net, int *parent) {
+    int *in_place = (int *)malloc(sizeof(int) * (net->transition_count + 1));
+    int *out_place = (int *)malloc(sizeof(int) * (net->transition_count + 1));
+    int *consumers = (int *)malloc(sizeof(int) * (net->place_count + 1));
+    int changed = 1;
+
+    while (changed) {
+        changed = 0;
+        /* Single input/output place of every transition (-2 if several) and consumers per place */
+        for (int t = 0; t < net->transition_count; t++) in_place[t] = out_place[t] = -1;
+        for (int p = 0; p < net->place_count; p++) consumers[p] = 0;
+        for (int i = 0; i < net->arc_count; i++) {
+            const NetArc *a = &net->arcs[i];
+            if (net->removed[a->transition]) continue;
+            int p = find_place(parent, a->place);
+            int *slot = a->to_transition ? &in_place[a->transition] : &out_place[a->transition];
+            if (*slot == -1) *slot = p;
+            else if (*slot != p) *slot = -2;
+            if (a->to_transition) consumers[p]++;
+        }
+        for (int t = 0; t < net->transition_count; t++) {
+            if (net->removed[t] || net->transition_labels[t] >= 0) continue;
+            int p = in_place[t], q = out_place[t];
+            if (p < 0 || q < 0) continue;
+            /* Places fused earlier in this sweep invalidate the counts: re-check them later */
+            if (find_place(parent, p) != p || find_place(parent, q) != q) continue;
+            if (p == q) {
+                net->removed[t] = 1;
+                consumers[p]--;
+                changed = 1;
+            } else if (consumers[p] == 1) {
+                net->removed[t] = 1;
+                parent[q] = p;
+                consumers[p] += consumers[q] - 1;
+                changed = 1;
+            }
+        }
+    }
+
+    free(in_place);
+    free(out_place);
+    free(consumers);
+}
+
+/* Convert a process tree into an accepting Petri net (initial marking source, final marking sink) */
+PetriNet *process_tree_to_petri_net(const ProcessTree *tree) {
+    TreeNet tn;
+    memset(&tn, 0, sizeof(tn));
+    int source = new_place(&tn);
+    int sink = new_place(&tn);
+    if (tree->root >= 0) translate(tree, &tn, tree->root, source, sink);
+    tn.removed = (char *)calloc(tn.transition_count + 1, 1);
+
+    int *parent = (int *)malloc(sizeof(int) * tn.place_count);
+    for (int p = 0; p < tn.place_count; p++) parent[p] = p;
+    reduce_taus(&tn, parent);
+
+    PetriNet *net = createPetriNet();
+    char id[50], source_id[50], target_id[50];
+    int root_source = find_place(parent, source);
+    int root_sink = find_place(parent, sink);
+
+    /* Places: name the fused classes after source/sink, the others p_1, p_2, ... */
+    int *place_number = (int *)calloc(tn.place_count, sizeof(int));
+    int place_counter = 0;
+    for (int p = 0; p < tn.place_count; p++) {
+        if (find_place(parent, p) != p) continue;
+        if (p == root_source) {
+            addPlace(net, "source", 1);
+        } else if (p == root_sink) {
+            addPlace(net, "sink", 0);
+        } else {
+            place_number[p] = ++place_counter;
+            snprintf(id, sizeof(id), "p_%d", place_number[p]);
+            addPlace(net, id, 0);
+        }
+    }
+    addFinalMarking(net, root_sink == root_source ? "source" : "sink", 1);
+
+    /* Transitions t_1, t_2, ... named after their label (silent ones 'tau') */
+    int *transition_number = (int *)calloc(tn.transition_count + 1, sizeof(int));
+    int transition_counter = 0;
+    for (int t = 0; t < tn.transition_count; t++) {
+        if (tn.removed[t]) continue;
+        transition_number[t] = ++transition_counter;
+        snprintf(id, sizeof(id), "t_%d", transition_number[t]);
+        int label = tn.transition_labels[t];
+        addTransition(net, id, label >= 0 ? tree->labels[label] : "tau", label >= 0);
+    }
+
+    int arc_counter = 0;
+    for (int i = 0; i < tn.arc_count; i++) {
+        const NetArc *a = &tn.arcs[i];
+        if (tn.removed[a->transition]) continue;
+        int p = find_place(parent, a->place);
+        char *place_id = p == root_source ? "source" : p == root_sink ? "sink" : NULL;
+        if (!place_id) {
+            snprintf(source_id, sizeof(source_id), "p_%d", place_number[p]);
+            place_id = source_id;
+        }
+        snprintf(target_id, sizeof(target_id), "t_%d", transition_number[a->transition]);
+        snprintf(id, sizeof(id), "arc_%d", ++arc_counter);
+        if (a->to_transition) addArc(net, id, place_id, target_id);
+        else addArc(net, id, target_id, place_id);
+    }
+
+    free(place_number);
+    free(transition_number);
+    free(parent);
+    free(tn.transition_labels);
+    free(tn.removed);
+    free(tn.arcs);
+    return net;
+}
+
+#ifndef K_CLI
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s input.ptml output.pnml\n", argv[0]);
+        return 1;
+    }
+
+    ProcessTree *tree = create_process_tree();
+    if (import_ptml(tree, argv[1]) != 0) {
+        free_process_tree(tree);
+        return 1;
+    }
+    PetriNet *net = process_tree_to_petri_net(tree);
+    exportPNML(net, argv[2]);
+
+    freePetriNet(net);
+    free_process_tree(tree);
+    return 0;
+}
+#endif
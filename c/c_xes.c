@@ -1,65 +1,73 @@
 /*
  * XES Importer/Exporter
- * Only stores the activity of each event (concept:name)
+ * Only stores the activity (concept:name) and the timestamp (time:timestamp) of each event
  * Implemented in ANSI C without external dependencies
  *
- * The code implements an XES importer/exporter in ANSI C without external dependencies. It only focuses on storing the activity of each event (`concept:name`) and ignores all other attributes.
+ * The code implements an XES importer/exporter in ANSI C without external dependencies. It only focuses on storing the activity (`concept:name`) and the timestamp (`time:timestamp`) of each event and ignores all other attributes.
  *
  * **Main Components:**
 
 - **Data Structures:**
   - `Case`: Represents a single case (trace) containing a list of activities.
-  - `Log`: Represents the entire log containing multiple cases.
+  - `Log`: Represents the entire log containing multiple cases. The activity strings and the
+    activity/timestamp arrays of the cases are allocated from the arena of the log (`c_arena.h`),
+    so parsing does not call malloc per event and `free_log` releases them in a few calls.
 
 - **Functions:**
   - `create_log()`: Allocates and initializes a new log.
   - `free_log(Log *log)`: Frees all memory associated with the log.
-  - `add_activity_to_case(Case *c, const char *activity)`: Adds an activity to a case.
+  - `add_activity_to_case(Log *log, Case *c, const char *activity)`: Adds an activity to a case
+    of the log.
+  - `add_event_to_case(Log *log, Case *c, const char *activity, long long timestamp)`: Adds an
+    activity with its timestamp to a case of the log.
   - `add_case(Log *log)`: Adds a new case to the log.
-  - `parse_xes(FILE *fp, Log *log)`: Parses an XES file and fills the log data structure.
+  - `read_xes(FILE *fp, const XesHandler *handler, void *context)`: Reads an XES file in one pass,
+    calling the handler at the start and end of each trace and for each event, without storing
+    anything (one-pass statistics).
+  - `parse_xes(FILE *fp, Log *log)`: Parses an XES file and fills the log data structure (read_xes
+    with a handler that adds the cases and events to the log).
   - `export_xes(FILE *fp, Log *log)`: Exports the log data structure back into an XES file.
+  - `encode_log(const Log *log)`: Interns the activities into an `ActivityDictionary` and returns
+    the log as an `EncodedLog` (activity ids in CSR layout), the input of the discovery algorithms.
+
+- **Reuse:**
+  - The declarations are in `c_xes.h`. Compile with `-DK_LIB` to link this file into another program
+    without its `main`.
+
+- **Instrumentation:**
+  - Built with `-DK_STATS` and `c_stats.c`, the phases parse, encode and export report their time,
+    bytes, events and allocations at exit (see `c_stats.h`).
 
 - **Parsing Logic:**
   - Reads the input XES file line by line.
-  - Maintains state variables `in_trace` and `in_event` to keep track of where we are in the XML structure.
+  - Maintains the state variable `in_event` to keep track of where we are in the XML structure.
   - When an `<event>` tag is encountered inside a `<trace>`, it starts collecting `concept:name` values.
-  - It searches for lines containing `key="concept:name"` and extracts the `value`.
+  - It searches for lines containing `key="concept:name"` (or with single quotes, as written by
+    `rb_xes.rb`) and extracts the `value`.
+  - The `value` of `key="time:timestamp"` is parsed into milliseconds since the epoch
+    (`c_timestamp.h`), so the events can be ordered without keeping the strings.
 
 - **Export Logic:**
   - Writes the XML header and the `<log>` tag with version information.
   - Iterates over each case and each activity within the case.
-  - Writes each event back into the XES format with only the `concept:name` attribute.
+  - Writes each event back into the XES format with only the `concept:name` attribute (the order
+    of the events is kept; see `c_sort_log.h` for ordering them by timestamp).
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "c_xes.h"
+#include "c_timestamp.h"
+#include "c_stats.h"
+
 #define MAX_ACTIVITY_LENGTH 256
-#define MAX_ACTIVITIES_PER_CASE 1024
+#define INITIAL_ACTIVITY_CAPACITY 16
 #define INITIAL_CASE_CAPACITY 128
+#define INITIAL_DICTIONARY_CAPACITY 64
 
-/* Data structure to hold activities for each case */
-typedef struct {
-    char **activities;
-    int activity_count;
-    int activity_capacity;
-} Case;
-
-typedef struct {
-    Case *cases;
-    int case_count;
-    int case_capacity;
-} Log;
-
-/* Function prototypes */
-Log *create_log();
-void free_log(Log *log);
-void add_activity_to_case(Case *c, const char *activity);
-void add_case(Log *log);
-void parse_xes(FILE *fp, Log *log);
-void export_xes(FILE *fp, Log *log);
-
+#ifndef K_LIB
 int main(int argc, char *argv[]) {
     if (argc < 3) {
         fprintf(stderr, "Usage: %s input.xes output.xes\n", argv[0]);
@@ -97,6 +105,7 @@ int main(int argc, char *argv[]) {
 
     return 0;
 }
+#endif
 
 /* Create an empty log */
 Log *create_log() {
@@ -104,35 +113,37 @@ Log *create_log() {
     log->case_count = 0;
     log->case_capacity = INITIAL_CASE_CAPACITY;
     log->cases = (Case *)malloc(sizeof(Case) * log->case_capacity);
+    memset(&log->arena, 0, sizeof(log->arena));
     return log;
 }
 
 /* Free the log and its contents */
 void free_log(Log *log) {
-    for (int i = 0; i < log->case_count; i++) {
-        Case *c = &log->cases[i];
-        for (int j = 0; j < c->activity_count; j++) {
-            free(c->activities[j]);
-        }
-        free(c->activities);
-    }
+    arena_release(&log->arena);
     free(log->cases);
     free(log);
 }
 
-/* Add a new activity to a case */
-void add_activity_to_case(Case *c, const char *activity) {
-    if (c->activity_capacity == 0) {
-        c->activity_capacity = MAX_ACTIVITIES_PER_CASE;
-        c->activities = (char **)malloc(sizeof(char *) * c->activity_capacity);
-    } else if (c->activity_count >= c->activity_capacity) {
-        c->activity_capacity *= 2;
-        c->activities = (char **)realloc(c->activities, sizeof(char *) * c->activity_capacity);
+/* Add a new activity with its timestamp to a case of the log (the arrays grow by copying in the arena) */
+void add_event_to_case(Log *log, Case *c, const char *activity, long long timestamp) {
+    if (c->activity_count >= c->activity_capacity) {
+        int capacity = c->activity_capacity ? c->activity_capacity * 2 : INITIAL_ACTIVITY_CAPACITY;
+        c->activities = (char **)arena_grow(&log->arena, c->activities, sizeof(char *) * c->activity_count,
+                                            sizeof(char *) * capacity);
+        c->timestamps = (long long *)arena_grow(&log->arena, c->timestamps, sizeof(long long) * c->activity_count,
+                                                sizeof(long long) * capacity);
+        c->activity_capacity = capacity;
     }
-    c->activities[c->activity_count] = strdup(activity);
+    c->activities[c->activity_count] = arena_strdup(&log->arena, activity);
+    c->timestamps[c->activity_count] = timestamp;
     c->activity_count++;
 }
 
+/* Add a new activity without a timestamp to a case of the log */
+void add_activity_to_case(Log *log, Case *c, const char *activity) {
+    add_event_to_case(log, c, activity, TIMESTAMP_NONE);
+}
+
 /* Add a new case to the log */
 void add_case(Log *log) {
     if (log->case_count >= log->case_capacity) {
@@ -141,13 +152,14 @@ void add_case(Log *log) {
     }
     Case *c = &log->cases[log->case_count++];
     c->activities = NULL;
+    c->timestamps = NULL;
     c->activity_count = 0;
     c->activity_capacity = 0;
 }
 
 /* Simple XML parsing functions */
 
-char *trim_whitespace(char *str) {
+static char *trim_whitespace(char *str) {
     char *end;
 
     // Trim leading space
@@ -167,7 +179,7 @@ char *trim_whitespace(char *str) {
 }
 
 /* Check if the line starts with a given prefix */
-int starts_with(const char *str, const char *prefix) {
+static int starts_with(const char *str, const char *prefix) {
     while (*prefix) {
         if (*prefix++ != *str++) return 0;
     }
@@ -175,26 +187,27 @@ int starts_with(const char *str, const char *prefix) {
 }
 
 /* Simple XML parser to parse XES and extract concept:name attributes */
-void parse_xes(FILE *fp, Log *log) {
+void read_xes(FILE *fp, const XesHandler *handler, void *context) {
     char line[1024];
-    int in_trace = 0;
     int in_event = 0;
     int has_concept = 0;
     char activity[MAX_ACTIVITY_LENGTH];
+    long long timestamp = TIMESTAMP_NONE;
 
+    K_STATS_BEGIN("parse");
+    K_STATS_COUNT(-ftell(fp), 0);
     while (fgets(line, sizeof(line), fp)) {
         char *trimmed = trim_whitespace(line);
 
         /* Start of a trace */
         if (starts_with(trimmed, "<trace")) {
-            add_case(log);
-            in_trace = 1;
+            if (handler->begin_trace) handler->begin_trace(context);
             continue;
         }
 
         /* End of a trace */
         if (starts_with(trimmed, "</trace>")) {
-            in_trace = 0;
+            if (handler->end_trace) handler->end_trace(context);
             continue;
         }
 
@@ -202,14 +215,15 @@ void parse_xes(FILE *fp, Log *log) {
         if (starts_with(trimmed, "<event")) {
             in_event = 1;
             has_concept = 0;
+            timestamp = TIMESTAMP_NONE;
             continue;
         }
 
         /* End of an event */
         if (starts_with(trimmed, "</event>")) {
             if (in_event && has_concept) {
-                Case *current_case = &log->cases[log->case_count - 1];
-                add_activity_to_case(current_case, activity);
+                if (handler->event) handler->event(context, activity, timestamp);
+                K_STATS_COUNT(0, 1);
             }
             in_event = 0;
             continue;
@@ -217,7 +231,7 @@ void parse_xes(FILE *fp, Log *log) {
 
         /* Inside an event, look for concept:name attributes */
         if (in_event) {
-            if (strstr(trimmed, "key=\"concept:name\"")) {
+            if (strstr(trimmed, "key=\"concept:name\"") || strstr(trimmed, "key='concept:name'")) {
                 /* Extract the value */
                 char *val_start = strstr(trimmed, "value=");
                 if (val_start) {
@@ -232,13 +246,41 @@ void parse_xes(FILE *fp, Log *log) {
                         has_concept = 1;
                     }
                 }
+            } else if (strstr(trimmed, "key=\"time:timestamp\"") || strstr(trimmed, "key='time:timestamp'")) {
+                char *val_start = strstr(trimmed, "value=");
+                if (val_start) {
+                    val_start += 6;
+                    char quote = *val_start++;
+                    char *val_end = strchr(val_start, quote);
+                    if (val_end) timestamp = parse_timestamp(val_start, val_end);
+                }
             }
         }
     }
+    K_STATS_COUNT(ftell(fp), 0);
+    K_STATS_END();
+}
+
+/* Handler of parse_xes: the events go to the last case of the log */
+static void log_begin_trace(void *context) {
+    add_case((Log *)context);
+}
+
+static void log_event(void *context, const char *activity, long long timestamp) {
+    Log *log = (Log *)context;
+    if (log->case_count > 0) add_event_to_case(log, &log->cases[log->case_count - 1], activity, timestamp);
+}
+
+void parse_xes(FILE *fp, Log *log) {
+    static const XesHandler handler = { log_begin_trace, NULL, log_event };
+    read_xes(fp, &handler, log);
 }
 
 /* Export the log to XES format */
 void export_xes(FILE *fp, Log *log) {
+    K_STATS_BEGIN("export");
+    K_STATS_COUNT(-ftell(fp), 0);
+
     /* Write XML header */
     fprintf(fp, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
     fprintf(fp, "<log xes.version=\"1.0\" xes.features=\"\">\n");
@@ -253,8 +295,122 @@ void export_xes(FILE *fp, Log *log) {
             fprintf(fp, "      <string key=\"concept:name\" value=\"%s\"/>\n", c->activities[j]);
             fprintf(fp, "    </event>\n");
         }
+        K_STATS_COUNT(0, c->activity_count);
         fprintf(fp, "  </trace>\n");
     }
 
     fprintf(fp, "</log>\n");
-}
\ No newline at end of file
+    K_STATS_COUNT(ftell(fp), 0);
+    K_STATS_END();
+}
+/* Activity dictionary */
+
+/* FNV-1a hash of a NUL-terminated string */
+static unsigned int hash_activity(const char *s) {
+    unsigned int h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+void init_activity_dictionary(ActivityDictionary *dict) {
+    dict->count = 0;
+    dict->capacity = INITIAL_DICTIONARY_CAPACITY;
+    dict->names = (char **)malloc(sizeof(char *) * dict->capacity);
+    dict->slot_capacity = INITIAL_DICTIONARY_CAPACITY * 2;
+    dict->slots = (int *)malloc(sizeof(int) * dict->slot_capacity);
+    for (int i = 0; i < dict->slot_capacity; i++) dict->slots[i] = -1;
+}
+
+void free_activity_dictionary(ActivityDictionary *dict) {
+    for (int i = 0; i < dict->count; i++) {
+        free(dict->names[i]);
+    }
+    free(dict->names);
+    free(dict->slots);
+    dict->names = NULL;
+    dict->slots = NULL;
+    dict->count = dict->capacity = dict->slot_capacity = 0;
+}
+
+/* Return the id of an activity, or -1 if it is not in the dictionary */
+int lookup_activity(const ActivityDictionary *dict, const char *activity) {
+    unsigned int mask = (unsigned int)dict->slot_capacity - 1;
+    unsigned int slot = hash_activity(activity) & mask;
+    while (dict->slots[slot] >= 0) {
+        if (strcmp(dict->names[dict->slots[slot]], activity) == 0) return dict->slots[slot];
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+/* Return the id of an activity, adding it to the dictionary if needed */
+int intern_activity(ActivityDictionary *dict, const char *activity) {
+    unsigned int mask = (unsigned int)dict->slot_capacity - 1;
+    unsigned int slot = hash_activity(activity) & mask;
+    while (dict->slots[slot] >= 0) {
+        if (strcmp(dict->names[dict->slots[slot]], activity) == 0) return dict->slots[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    if (dict->count >= dict->capacity) {
+        dict->capacity *= 2;
+        dict->names = (char **)realloc(dict->names, sizeof(char *) * dict->capacity);
+    }
+    int id = dict->count++;
+    dict->names[id] = strdup(activity);
+    dict->slots[slot] = id;
+
+    /* Keep the load factor below 1/2 */
+    if (dict->count * 2 > dict->slot_capacity) {
+        free(dict->slots);
+        dict->slot_capacity *= 2;
+        dict->slots = (int *)malloc(sizeof(int) * dict->slot_capacity);
+        for (int i = 0; i < dict->slot_capacity; i++) dict->slots[i] = -1;
+        mask = (unsigned int)dict->slot_capacity - 1;
+        for (int i = 0; i < dict->count; i++) {
+            slot = hash_activity(dict->names[i]) & mask;
+            while (dict->slots[slot] >= 0) slot = (slot + 1) & mask;
+            dict->slots[slot] = i;
+        }
+    }
+    return id;
+}
+
+/* Encode a log as activity ids in CSR layout */
+EncodedLog *encode_log(const Log *log) {
+    K_STATS_BEGIN("encode");
+    EncodedLog *enc = (EncodedLog *)malloc(sizeof(EncodedLog));
+    init_activity_dictionary(&enc->dictionary);
+
+    enc->case_count = log->case_count;
+    enc->event_count = 0;
+    for (int i = 0; i < log->case_count; i++) {
+        enc->event_count += log->cases[i].activity_count;
+    }
+
+    enc->case_offsets = (int *)malloc(sizeof(int) * (enc->case_count + 1));
+    enc->events = (int *)malloc(sizeof(int) * (enc->event_count > 0 ? enc->event_count : 1));
+
+    int pos = 0;
+    for (int i = 0; i < log->case_count; i++) {
+        Case *c = &log->cases[i];
+        enc->case_offsets[i] = pos;
+        for (int j = 0; j < c->activity_count; j++) {
+            enc->events[pos++] = intern_activity(&enc->dictionary, c->activities[j]);
+        }
+    }
+    enc->case_offsets[enc->case_count] = pos;
+    K_STATS_COUNT(0, pos);
+    K_STATS_END();
+    return enc;
+}
+
+void free_encoded_log(EncodedLog *enc) {
+    free_activity_dictionary(&enc->dictionary);
+    free(enc->case_offsets);
+    free(enc->events);
+    free(enc);
+}
@@ -0,0 +1,82 @@
+/*
+ * XES Importer/Exporter - shared declarations
+ *
+ * Data structures and functions of c_xes.c, for the programs that reuse the
+ * XES importer (e.g. the discovery algorithms). When c_xes.c is linked into
+ * another program it must be compiled with -DK_LIB, which leaves out its main.
+ */
+
+#ifndef C_XES_H
+#define C_XES_H
+
+#include <stdio.h>
+
+#include "c_arena.h"
+
+/* Data structure to hold activities for each case */
+typedef struct {
+    char **activities;
+    long long *timestamps;   /* per activity: time:timestamp in ms since the epoch, TIMESTAMP_NONE
+                                if the event has none (c_timestamp.h) */
+    int activity_count;
+    int activity_capacity;
+} Case;
+
+typedef struct {
+    Case *cases;
+    int case_count;
+    int case_capacity;
+    Arena arena;             /* activity strings and the arrays of the cases (c_arena.h) */
+} Log;
+
+/* Dictionary interning activity names to dense integer ids (0, 1, 2, ...) */
+typedef struct {
+    char **names;        /* id -> activity name */
+    int count;
+    int capacity;
+    int *slots;          /* open-addressing hash table of ids, -1 if empty */
+    int slot_capacity;   /* power of two */
+} ActivityDictionary;
+
+/*
+ * Log encoded over the activity dictionary, in CSR layout:
+ * the events of case i are events[case_offsets[i] .. case_offsets[i + 1]).
+ */
+typedef struct {
+    ActivityDictionary dictionary;
+    int case_count;
+    int event_count;
+    int *case_offsets;   /* case_count + 1 entries */
+    int *events;         /* activity id of each event */
+} EncodedLog;
+
+/*
+ * Callbacks of read_xes, any of them may be NULL: the start and the end of a
+ * trace and each event with its activity (valid during the call only) and
+ * its timestamp (TIMESTAMP_NONE if it has none)
+ */
+typedef struct {
+    void (*begin_trace)(void *context);
+    void (*end_trace)(void *context);
+    void (*event)(void *context, const char *activity, long long timestamp);
+} XesHandler;
+
+/* Function prototypes */
+Log *create_log();
+void free_log(Log *log);
+void add_activity_to_case(Log *log, Case *c, const char *activity);
+void add_event_to_case(Log *log, Case *c, const char *activity, long long timestamp);
+void add_case(Log *log);
+void read_xes(FILE *fp, const XesHandler *handler, void *context);
+void parse_xes(FILE *fp, Log *log);
+void export_xes(FILE *fp, Log *log);
+
+void init_activity_dictionary(ActivityDictionary *dict);
+void free_activity_dictionary(ActivityDictionary *dict);
+int intern_activity(ActivityDictionary *dict, const char *activity);
+int lookup_activity(const ActivityDictionary *dict, const char *activity);
+
+EncodedLog *encode_log(const Log *log);
+void free_encoded_log(EncodedLog *enc);
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * XML helpers shared by the PNML, PTML and OCEL XML readers and writers
+ * (c_pnml.c, c_process_tree.c, c_ocel20_xml.c): entity decoding, the
+ * attributes of a start tag, escaping, a buffered writer and reading a whole
+ * file. Header only, like c_timestamp.h.
+ */
+
+#ifndef C_XML_H
+#define C_XML_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define XML_WRITE_BUFFER_SIZE 65536
+
+/* Attribute of a start tag; name and value point into the document */
+typedef struct {
+    const char *name;
+    size_t name_len;
+    const char *value;
+    size_t value_len;
+} XmlAttribute;
+
+static inline int xml_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/*
+ * Decode the XML entities of src[0..len) into dest (at most size-1 characters, NUL-terminated);
+ * returns the decoded length. A reference is never shorter than its UTF-8 encoding, so dest may
+ * be src (decoding in place). Unknown entities and malformed character references are kept.
+ */
+static inline size_t xml_decode_entities(char *dest, size_t size, const char *src, size_t len) {
+    size_t o = 0, i = 0;
+    while (i < len && o + 1 < size) {
+        if (src[i] == '&') {
+            const char *s = src + i;
+            size_t rest = len - i;
+            if (rest >= 5 && strncmp(s, "&amp;", 5) == 0) { dest[o++] = '&'; i += 5; continue; }
+            if (rest >= 4 && strncmp(s, "&lt;", 4) == 0) { dest[o++] = '<'; i += 4; continue; }
+            if (rest >= 4 && strncmp(s, "&gt;", 4) == 0) { dest[o++] = '>'; i += 4; continue; }
+            if (rest >= 6 && strncmp(s, "&quot;", 6) == 0) { dest[o++] = '"'; i += 6; continue; }
+            if (rest >= 6 && strncmp(s, "&apos;", 6) == 0) { dest[o++] = '\''; i += 6; continue; }
+            if (rest >= 4 && s[1] == '#') {
+                int base = s[2] == 'x' || s[2] == 'X' ? 16 : 10;
+                size_t j = base == 16 ? 3 : 2, digits = j;
+                long code = 0;
+                for (; j < rest && code <= 0x10FFFF; j++) {
+                    char c = s[j];
+                    int d = c >= '0' && c <= '9' ? c - '0'
+                          : base == 16 && c >= 'a' && c <= 'f' ? c - 'a' + 10
+                          : base == 16 && c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+                    if (d < 0) break;
+                    code = code * base + d;
+                }
+                if (j > digits && j < rest && s[j] == ';' && code > 0 && code <= 0x10FFFF) {
+                    /* Encode the code point as UTF-8 (left out if it does not fit) */
+                    if (code < 0x80) {
+                        dest[o++] = (char)code;
+                    } else if (code < 0x800) {
+                        if (o + 2 < size) {
+                            dest[o++] = (char)(0xC0 | (code >> 6));
+                            dest[o++] = (char)(0x80 | (code & 0x3F));
+                        }
+                    } else if (code < 0x10000) {
+                        if (o + 3 < size) {
+                            dest[o++] = (char)(0xE0 | (code >> 12));
+                            dest[o++] = (char)(0x80 | ((code >> 6) & 0x3F));
+                            dest[o++] = (char)(0x80 | (code & 0x3F));
+                        }
+                    } else if (o + 4 < size) {
+                        dest[o++] = (char)(0xF0 | (code >> 18));
+                        dest[o++] = (char)(0x80 | ((code >> 12) & 0x3F));
+                        dest[o++] = (char)(0x80 | ((code >> 6) & 0x3F));
+                        dest[o++] = (char)(0x80 | (code & 0x3F));
+                    }
+                    i += j + 1;
+                    continue;
+                }
+            }
+        }
+        dest[o++] = src[i++];
+    }
+    dest[o] = '\0';
+    return o;
+}
+
+/*
+ * Parse the attributes of a start tag, from just after its name up to its '>' or '/>'; returns
+ * the position after the tag and sets self_closing (may be NULL) for '/>'. The values are left
+ * undecoded; at most max attributes are kept and attributes without a quoted value are skipped.
+ */
+static inline char *xml_parse_attributes(char *p, XmlAttribute *attrs, int max, int *count, int *self_closing) {
+    *count = 0;
+    if (self_closing) *self_closing = 0;
+    while (*p) {
+        while (xml_is_space(*p)) p++;
+        if (*p == '>') return p + 1;
+        if (*p == '/' && p[1] == '>') {
+            if (self_closing) *self_closing = 1;
+            return p + 2;
+        }
+        if (*p == '\0') break;
+        const char *name = p;
+        while (*p && *p != '=' && *p != '>' && *p != '/' && !xml_is_space(*p)) p++;
+        size_t name_len = (size_t)(p - name);
+        while (xml_is_space(*p)) p++;
+        if (*p != '=') continue; /* Attribute without value: ignore it */
+        p++;
+        while (xml_is_space(*p)) p++;
+        char quote = *p;
+        if (quote != '"' && quote != '\'') continue;
+        p++;
+        const char *value = p;
+        while (*p && *p != quote) p++;
+        if (*count < max) {
+            attrs[*count].name = name;
+            attrs[*count].name_len = name_len;
+            attrs[*count].value = value;
+            attrs[*count].value_len = (size_t)(p - value);
+            (*count)++;
+        }
+        if (*p) p++;
+    }
+    return p;
+}
+
+/* Raw (undecoded) value of an attribute, or NULL */
+static inline const char *xml_find_attribute(const XmlAttribute *attrs, int count, const char *name, size_t *len) {
+    size_t name_len = strlen(name);
+    for (int i = 0; i < count; i++) {
+        if (attrs[i].name_len == name_len && strncmp(attrs[i].name, name, name_len) == 0) {
+            *len = attrs[i].value_len;
+            return attrs[i].value;
+        }
+    }
+    return NULL;
+}
+
+/* Decode the value of an attribute into out (size bytes); 1 if found, 0 (and out empty) if not */
+static inline int xml_get_attribute(const XmlAttribute *attrs, int count, const char *name, char *out, size_t size) {
+    size_t len;
+    const char *value = xml_find_attribute(attrs, count, name, &len);
+    if (!value) {
+        out[0] = '\0';
+        return 0;
+    }
+    xml_decode_entities(out, size, value, len);
+    return 1;
+}
+
+/* Entity of an XML special character, or NULL */
+static inline const char *xml_entity(char c) {
+    switch (c) {
+    case '&': return "&amp;";
+    case '<': return "&lt;";
+    case '>': return "&gt;";
+    case '"': return "&quot;";
+    case '\'': return "&apos;";
+    default: return NULL;
+    }
+}
+
+/* Write s to file escaping the XML special characters */
+static inline void xml_fwrite_escaped(FILE *file, const char *s) {
+    const char *run = s;
+    for (; *s; s++) {
+        const char *entity = xml_entity(*s);
+        if (!entity) continue;
+        fwrite(run, 1, (size_t)(s - run), file);
+        fputs(entity, file);
+        run = s + 1;
+    }
+    fwrite(run, 1, (size_t)(s - run), file);
+}
+
+/* Output buffer flushed with fwrite when full, instead of several fprintf calls per element */
+typedef struct {
+    FILE *file;
+    size_t len;
+    char buf[XML_WRITE_BUFFER_SIZE];
+} XmlWriter;
+
+static inline void xml_writer_flush(XmlWriter *w) {
+    if (w->len) fwrite(w->buf, 1, w->len, w->file);
+    w->len = 0;
+}
+
+static inline void xml_write_raw(XmlWriter *w, const char *s, size_t len) {
+    if (w->len + len > XML_WRITE_BUFFER_SIZE) {
+        xml_writer_flush(w);
+        if (len > XML_WRITE_BUFFER_SIZE) {
+            fwrite(s, 1, len, w->file);
+            return;
+        }
+    }
+    memcpy(w->buf + w->len, s, len);
+    w->len += len;
+}
+
+static inline void xml_write_string(XmlWriter *w, const char *s) {
+    xml_write_raw(w, s, strlen(s));
+}
+
+/* Write s escaping the XML special characters */
+static inline void xml_write_escaped(XmlWriter *w, const char *s) {
+    const char *run = s;
+    for (; *s; s++) {
+        const char *entity = xml_entity(*s);
+        if (!entity) continue;
+        xml_write_raw(w, run, (size_t)(s - run));
+        xml_write_string(w, entity);
+        run = s + 1;
+    }
+    xml_write_raw(w, run, (size_t)(s - run));
+}
+
+static inline void xml_write_int(XmlWriter *w, int value) {
+    char digits[16];
+    int n = 0;
+    unsigned int v = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (value < 0) xml_write_raw(w, "-", 1);
+    while (n) xml_write_raw(w, &digits[--n], 1);
+}
+
+/* The whole file in memory, NUL-terminated; NULL if it can not be opened, sized or read */
+static inline char *xml_read_file(const char *filename) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) return NULL;
+    char *buffer = NULL;
+    long length = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    if (length >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+        buffer = (char *)malloc((size_t)length + 1);
+        if (buffer && fread(buffer, 1, (size_t)length, file) != (size_t)length) {
+            free(buffer);
+            buffer = NULL;
+        }
+        if (buffer) buffer[length] = '\0';
+    }
+    fclose(file);
+    return buffer;
+}
+
+#endif
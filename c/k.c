@@ -0,0 +1,691 @@
+/*
+ * k - command line of the common log-processing library (see k.h)
+ * One program for the conversion, discovery, replay and statistics steps, which share their
+ * models in memory instead of writing and re-parsing intermediate files
+ *
+ * Build: cc -O2 -fopenmp -DK_LIB -DK_CLI -o k k.c c_xes.c c_dfg.c c_pnml.c c_process_tree.c \
+ *           c_ocel.c c_ocel20_json.c c_ocel20_xml.c c_filter.c c_append_log.c c_alpha_miner.c \
+ *           c_inductive_miner.c c_tree_to_petri.c c_tree_fitness.c c_trace_clustering.c \
+ *           c_trace_distance.c c_prefix_tree.c c_log_stats.c c_ocdfg.c c_radix_sort.c \
+ *           c_ocel_time.c c_sort_log.c c_batch_import.c
+ * With -DK_CLI, the algorithm modules (c_alpha_miner.c, c_inductive_miner.c, c_tree_to_petri.c,
+ * c_tree_fitness.c, c_trace_clustering.c) leave out their mains; their entry points are
+ * declared in k.h and used by the commands below.
+ *
+ * Usage:
+ *   k convert [--stream] <input> <output>
+ *                                      .xes -> .xes, OCEL .json/.jsonocel <-> .xml/.xmlocel,
+ *                                      .pnml -> .pnml, .ptml -> .ptml or .pnml,
+ *                                      .xes -> .kpt (prefix tree)
+ *   k filter <log.xes> <output.xes> <filter>...
+ *   k discover <alpha|inductive> <log.xes> <model.pnml|model.ptml>
+ *   k replay <model.ptml|inductive> <log.xes>
+ *   k stats <log.xes|log.json|log.xml> [delta.xes|delta.bin]...
+ *   k cluster <log.xes> <k> <output_prefix>
+ *   k nearest <log.xes> <A,B,...> [max]
+ *   k prefix <log.xes|index.kpt> [A,B,...]
+ *   k baseline <log.xes> <flower.ptml> [footprint.tsv]
+ *   k ocdfg <log.json|log.xml>
+ *   k window <log.json|log.xml> <from> <to>
+ *   k value <log.json|log.xml> <object> <attribute> <time>
+ *   k load <log.xes|log.json|log.xml>...
+ *
+ * The formats are recognized by the file extension. 'replay inductive' discovers the tree and
+ * replays the log on it in one run; 'discover inductive' to a .pnml converts the tree in memory.
+ * The events of the cases of XES logs are put in timestamp order when loaded, where they are
+ * not already (see c_sort_log.h).
+ * 'convert --stream' converts OCEL logs record by record: each object and event is written as
+ * soon as it is read, so the memory used does not grow with the log (the types must come
+ * before the records, as in the files written by the exporters).
+ *
+ * 'stats' appends the XES fragments and binary deltas given after an XES log to it, updating the
+ * statistics incrementally (see c_append_log.h).
+ *
+ * 'cluster' groups the variants by MinHash similarity into at most k clusters and writes the
+ * cases of each to output_prefix_<i>.xes (see c_trace_clustering.c).
+ *
+ * 'nearest' lists the variants closest to the activity sequence A,B,... by edit distance (at
+ * most max, if given), with their number of cases (see c_trace_distance.h).
+ *
+ * 'prefix' counts the cases that start with A,B,... (all cases without a prefix) and gives the
+ * distribution of their next activity, from the prefix tree of the log or from a saved one,
+ * which is mapped instead of parsed (see c_prefix_tree.h).
+ *
+ * 'baseline' reads the log in one streaming pass, without loading it, prints its statistics
+ * (activity, start and end counts, trace lengths) and writes the flower model and the
+ * footprint (see c_log_stats.h).
+ *
+ * 'ocdfg' prints the object-centric DFG of an OCEL log: per object type, the directly-follows
+ * counts between the event types along the time-ordered events of each object (see c_ocdfg.h).
+ *
+ * 'window' counts the events of each type with from <= time < to; 'value' prints the value the
+ * attribute of the object (by id) had at the time. Times are ISO 8601 as in the logs or seconds
+ * since the epoch (see c_ocel_time.h).
+ *
+ * 'load' imports the logs concurrently, one per thread, and prints their sizes (see
+ * c_batch_import.h).
+ *
+ * The filters of 'filter' are applied in the order given, each to the result of the ones
+ * before (see c_filter.h); activity lists are separated by commas:
+ *   --start A,B  --end A,B          first/last activity of the case
+ *   --with A,B  --without A,B       cases with/without any of the activities
+ *   --min-length N  --max-length N  number of events of the case
+ *   --min-variant-count N           cases whose variant occurs at least N times
+ *   --activities A,B                keep only the events of the activities
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "k.h"
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s <command> [arguments]\n"
+            "  convert [--stream] <input> <output>\n"
+            "                                 .xes -> .xes, OCEL .json <-> .xml, .pnml -> .pnml,\n"
+            "                                 .ptml -> .ptml or .pnml, .xes -> .kpt (prefix tree)\n"
+            "                                 (--stream: OCEL only)\n"
+            "  filter <log.xes> <output.xes> <filter>...\n"
+            "                                 --start A,B  --end A,B  --with A,B  --without A,B\n"
+            "                                 --min-length N  --max-length N  --min-variant-count N\n"
+            "                                 --activities A,B\n"
+            "  discover <alpha|inductive> <log.xes> <model.pnml|model.ptml>\n"
+            "  replay <model.ptml|inductive> <log.xes>\n"
+            "  stats <log.xes|log.json|log.xml> [delta.xes|delta.bin]...\n"
+            "  cluster <log.xes> <k> <output_prefix>\n"
+            "  nearest <log.xes> <A,B,...> [max]\n"
+            "  prefix <log.xes|index.kpt> [A,B,...]\n"
+            "  baseline <log.xes> <flower.ptml> [footprint.tsv]\n"
+            "  ocdfg <log.json|log.xml>\n"
+            "  window <log.json|log.xml> <from> <to>\n"
+            "  value <log.json|log.xml> <object> <attribute> <time>\n"
+            "  load <log.xes|log.json|log.xml>...\n",
+            program);
+}
+
+/* Loading and saving */
+
+static Log *load_xes(const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) {
+        perror("Failed to open input file");
+        return NULL;
+    }
+    Log *log = create_log();
+    parse_xes(fp, log);
+    fclose(fp);
+    sort_log_events(log);
+    return log;
+}
+
+static int save_xes(Log *log, const char *filename) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        perror("Failed to open output file");
+        return -1;
+    }
+    export_xes(fp, log);
+    fclose(fp);
+    return 0;
+}
+
+static int import_ocel(OcelLog *log, const char *filename) {
+    return file_format(filename) == FORMAT_OCEL_JSON ? import_ocel_json(log, filename) : import_ocel_xml(log, filename);
+}
+
+static const OcelFormat *ocel_format(const char *filename) {
+    return file_format(filename) == FORMAT_OCEL_JSON ? &ocel_json_format : &ocel_xml_format;
+}
+
+static OcelLog *load_ocel(const char *filename) {
+    OcelLog *log = create_ocel();
+    if (import_ocel(log, filename) != 0) {
+        free_ocel(log);
+        return NULL;
+    }
+    return log;
+}
+
+static int save_ocel(const OcelLog *log, const char *filename) {
+    return file_format(filename) == FORMAT_OCEL_JSON ? export_ocel_json(log, filename) : export_ocel_xml(log, filename);
+}
+
+/* Import input with a writer to output as the record handler: only one record is kept */
+static int stream_ocel(const char *input, const char *output) {
+    OcelWriter writer;
+    if (open_ocel_writer(&writer, ocel_format(output), output) != 0) return -1;
+    OcelLog *log = create_ocel();
+    log->record_handler = stream_ocel_record;
+    log->record_context = &writer;
+    int status = import_ocel(log, input);
+    if (close_ocel_writer(&writer, log, output) != 0) status = -1;
+    free_ocel(log);
+    return status;
+}
+
+/* Commands */
+
+static int convert(const char *input, const char *output, int streaming) {
+    FileFormat in = file_format(input), out = file_format(output);
+    int status = -1;
+
+    if (streaming && !(is_ocel_format(in) && is_ocel_format(out))) {
+        fprintf(stderr, "--stream converts OCEL logs only (.json, .xml)\n");
+    } else if (streaming) {
+        status = stream_ocel(input, output);
+    } else if (in == FORMAT_XES && out == FORMAT_XES) {
+        Log *log = load_xes(input);
+        if (!log) return 1;
+        status = save_xes(log, output);
+        free_log(log);
+    } else if (in == FORMAT_XES && out == FORMAT_PREFIX_TREE) {
+        Log *log = load_xes(input);
+        if (!log) return 1;
+        EncodedLog *enc = encode_log(log);
+        PrefixTree *tree = build_prefix_tree(enc);
+        status = save_prefix_tree(tree, output);
+        free_prefix_tree(tree);
+        free_encoded_log(enc);
+        free_log(log);
+    } else if (is_ocel_format(in) && is_ocel_format(out)) {
+        OcelLog *log = load_ocel(input);
+        if (!log) return 1;
+        status = save_ocel(log, output);
+        free_ocel(log);
+    } else if (in == FORMAT_PNML && out == FORMAT_PNML) {
+        PetriNet *net = createPetriNet();
+        status = importPNML(net, input);
+        if (status == 0) exportPNML(net, output);
+        freePetriNet(net);
+    } else if (in == FORMAT_PTML && (out == FORMAT_PTML || out == FORMAT_PNML)) {
+        ProcessTree *tree = create_process_tree();
+        if (import_ptml(tree, input) == 0) {
+            if (out == FORMAT_PTML) {
+                status = export_ptml(tree, output);
+            } else {
+                PetriNet *net = process_tree_to_petri_net(tree);
+                exportPNML(net, output);
+                freePetriNet(net);
+                status = 0;
+            }
+        }
+        free_process_tree(tree);
+    } else {
+        fprintf(stderr, "Cannot convert %s to %s\n", input, output);
+    }
+    return status == 0 ? 0 : 1;
+}
+
+/* Bitset of the activities of a comma-separated list; names not in the log are ignored */
+static bitset_word *parse_activities(const EncodedLog *enc, const char *list) {
+    bitset_word *activities = bitset_alloc(bitset_words(enc->dictionary.count));
+    char *copy = strdup(list);
+    for (char *name = strtok(copy, ","); name; name = strtok(NULL, ",")) {
+        int id = lookup_activity(&enc->dictionary, name);
+        if (id >= 0) bitset_set(activities, id);
+    }
+    free(copy);
+    return activities;
+}
+
+/* Apply the filter option with its argument to sel: 0 on success, -1 if unknown */
+static int apply_filter(LogSelection *sel, const char *option, const char *argument) {
+    const EncodedLog *enc = sel->log;
+    if (strcmp(option, "--min-length") == 0) {
+        filter_case_length(sel, atoi(argument), -1);
+    } else if (strcmp(option, "--max-length") == 0) {
+        filter_case_length(sel, 0, atoi(argument));
+    } else if (strcmp(option, "--min-variant-count") == 0) {
+        filter_variant_frequency(sel, atoi(argument));
+    } else {
+        bitset_word *activities = parse_activities(enc, argument);
+        int status = 0;
+        if (strcmp(option, "--start") == 0) filter_start_activities(sel, activities);
+        else if (strcmp(option, "--end") == 0) filter_end_activities(sel, activities);
+        else if (strcmp(option, "--with") == 0) filter_activity_presence(sel, activities, 1);
+        else if (strcmp(option, "--without") == 0) filter_activity_presence(sel, activities, 0);
+        else if (strcmp(option, "--activities") == 0) filter_event_activities(sel, activities);
+        else status = -1;
+        free(activities);
+        return status;
+    }
+    return 0;
+}
+
+static int filter(const char *input, const char *output, int argc, char *argv[]) {
+    if (file_format(input) != FORMAT_XES || file_format(output) != FORMAT_XES) {
+        fprintf(stderr, "The filters read and write .xes logs\n");
+        return 1;
+    }
+    if (argc % 2 != 0) {
+        fprintf(stderr, "Every filter takes one argument\n");
+        return 1;
+    }
+
+    Log *log = load_xes(input);
+    if (!log) return 1;
+    EncodedLog *enc = encode_log(log);
+    LogSelection *sel = select_all(enc);
+    int status = 0;
+
+    for (int i = 0; i < argc && status == 0; i += 2) {
+        if (apply_filter(sel, argv[i], argv[i + 1]) != 0) {
+            fprintf(stderr, "Unknown filter: %s\n", argv[i]);
+            status = 1;
+        }
+    }
+    if (status == 0) {
+        FILE *fp = fopen(output, "w");
+        if (fp) {
+            export_selection_xes(fp, sel);
+            fclose(fp);
+            printf("Cases: %d / %d\n", selected_case_count(sel), enc->case_count);
+            printf("Events: %d / %d\n", selected_event_count(sel), enc->event_count);
+        } else {
+            perror("Failed to open output file");
+            status = 1;
+        }
+    }
+
+    free_selection(sel);
+    free_encoded_log(enc);
+    free_log(log);
+    return status;
+}
+
+/* Discover a process tree with the Inductive Miner from an encoded log */
+static ProcessTree *discover_tree(const EncodedLog *enc) {
+    DFG *dfg = compute_dfg(enc);
+    ProcessTree *tree = inductive_miner(dfg, enc->dictionary.names);
+    free_dfg(dfg);
+    return tree;
+}
+
+static int discover(const char *algorithm, const char *input, const char *output) {
+    FileFormat out = file_format(output);
+    int is_alpha = strcmp(algorithm, "alpha") == 0;
+    if (!is_alpha && strcmp(algorithm, "inductive") != 0) {
+        fprintf(stderr, "Unknown discovery algorithm: %s (alpha or inductive)\n", algorithm);
+        return 1;
+    }
+    if (out != FORMAT_PNML && (is_alpha || out != FORMAT_PTML)) {
+        fprintf(stderr, "The %s miner writes %s\n", algorithm, is_alpha ? ".pnml" : ".pnml or .ptml");
+        return 1;
+    }
+
+    Log *log = load_xes(input);
+    if (!log) return 1;
+    EncodedLog *enc = encode_log(log);
+    int status = 0;
+
+    if (is_alpha) {
+        PetriNet *net = alpha_miner(enc);
+        exportPNML(net, output);
+        freePetriNet(net);
+    } else {
+        ProcessTree *tree = discover_tree(enc);
+        if (out == FORMAT_PTML) {
+            status = export_ptml(tree, output);
+        } else {
+            PetriNet *net = process_tree_to_petri_net(tree);
+            exportPNML(net, output);
+            freePetriNet(net);
+        }
+        free_process_tree(tree);
+    }
+
+    free_encoded_log(enc);
+    free_log(log);
+    return status == 0 ? 0 : 1;
+}
+
+static int replay(const char *model, const char *input) {
+    int discovered = strcmp(model, "inductive") == 0;
+    if (!discovered && file_format(model) != FORMAT_PTML) {
+        fprintf(stderr, "The model must be a .ptml process tree or 'inductive'\n");
+        return 1;
+    }
+
+    Log *log = load_xes(input);
+    if (!log) return 1;
+    EncodedLog *enc = encode_log(log);
+    ProcessTree *tree;
+    if (discovered) {
+        tree = discover_tree(enc);
+    } else {
+        tree = create_process_tree();
+        if (import_ptml(tree, model) != 0) {
+            free_process_tree(tree);
+            free_encoded_log(enc);
+            free_log(log);
+            return 1;
+        }
+    }
+
+    int variant_count, fitting_variants;
+    int fitting = tree_fitness(tree, enc, &variant_count, &fitting_variants);
+    printf("Variants: %d (%d fitting)\n", variant_count, fitting_variants);
+    printf("Fitting traces: %d / %d\n", fitting, enc->case_count);
+    printf("Trace fitness: %.4f\n", enc->case_count ? (double)fitting / enc->case_count : 1.0);
+
+    free_process_tree(tree);
+    free_encoded_log(enc);
+    free_log(log);
+    return 0;
+}
+
+/* Append an XES fragment or a binary delta (any other extension) to log: 0 on success */
+static int append_file(AppendLog *log, const char *filename) {
+    int xes = file_format(filename) == FORMAT_XES;
+    FILE *fp = fopen(filename, xes ? "r" : "rb");
+    if (!fp) {
+        perror("Failed to open input file");
+        return -1;
+    }
+    int events = xes ? append_xes(log, fp) : append_delta(log, fp);
+    fclose(fp);
+    return events < 0 ? -1 : 0;
+}
+
+static int stats(const char *input, int delta_count, char *deltas[]) {
+    FileFormat format = file_format(input);
+
+    if (format == FORMAT_XES) {
+        AppendLog *log = create_append_log();
+        int status = append_file(log, input);
+        for (int i = 0; i < delta_count && status == 0; i++) status = append_file(log, deltas[i]);
+        if (status == 0) {
+            printf("Cases: %d\n", log->case_count);
+            printf("Events: %d\n", log->event_count);
+            printf("Activities: %d\n", log->dictionary.count);
+            printf("Variants: %d\n", log->variant_count);
+        }
+        free_append_log(log);
+        return status == 0 ? 0 : 1;
+    }
+    if (delta_count > 0) {
+        fprintf(stderr, "Deltas can only be appended to .xes logs\n");
+        return 1;
+    }
+    if (is_ocel_format(format)) {
+        OcelLog *log = load_ocel(input);
+        if (!log) return 1;
+        printf("Event types: %d\n", log->event_type_count);
+        printf("Object types: %d\n", log->object_type_count);
+        printf("Events: %d\n", log->event_count);
+        printf("Objects: %d\n", log->object_count);
+        printf("Event attributes: %d\n", log->event_attribute_count);
+        printf("Object attributes: %d\n", log->object_attribute_count);
+        printf("E2O relationships: %d\n", log->event_relationship_count);
+        printf("O2O relationships: %d\n", log->object_relationship_count);
+        free_ocel(log);
+        return 0;
+    }
+    fprintf(stderr, "Unsupported log format: %s\n", input);
+    return 1;
+}
+
+static int cluster(const char *input, const char *k, const char *prefix) {
+    if (atoi(k) < 1) {
+        fprintf(stderr, "The number of clusters must be positive\n");
+        return 1;
+    }
+    Log *log = load_xes(input);
+    if (!log) return 1;
+    EncodedLog *enc = encode_log(log);
+
+    int *case_cluster = (int *)malloc(sizeof(int) * (enc->case_count > 0 ? enc->case_count : 1));
+    int clusters = cluster_traces(enc, atoi(k), case_cluster);
+    int status = export_clusters(log, case_cluster, clusters, prefix);
+
+    free(case_cluster);
+    free_encoded_log(enc);
+    free_log(log);
+    return status == 0 ? 0 : 1;
+}
+
+#define NEAREST_VARIANTS 10
+
+static int nearest(const char *input, const char *list, int max) {
+    Log *log = load_xes(input);
+    if (!log) return 1;
+    EncodedLog *enc = encode_log(log);
+    int *case_variant = (int *)malloc(sizeof(int) * (enc->case_count > 0 ? enc->case_count : 1));
+    EncodedLog *variants = encode_variants(enc, case_variant);
+    int *weights = (int *)calloc(variants->case_count > 0 ? variants->case_count : 1, sizeof(int));
+    for (int c = 0; c < enc->case_count; c++) weights[case_variant[c]]++;
+
+    /* Activities not in the log stay in the query and match no event */
+    int *query = (int *)malloc(sizeof(int) * (strlen(list) + 1));
+    int length = 0;
+    char *copy = strdup(list);
+    for (char *name = strtok(copy, ","); name; name = strtok(NULL, ",")) query[length++] = lookup_activity(&enc->dictionary, name);
+    free(copy);
+
+    TracePattern *p = create_trace_pattern(query, length, enc->dictionary.count);
+    int *distances = (int *)malloc(sizeof(int) * (variants->case_count > 0 ? variants->case_count : 1));
+    trace_distances(p, variants, max, distances);
+
+    /* The nearest variants, by distance and then by order of first occurrence */
+    int *order = (int *)malloc(sizeof(int) * NEAREST_VARIANTS);
+    int shown = 0;
+    for (int v = 0; v < variants->case_count; v++) {
+        if (max >= 0 && distances[v] > max) continue;
+        int i = shown < NEAREST_VARIANTS ? shown++ : NEAREST_VARIANTS;
+        while (i > 0 && distances[order[i - 1]] > distances[v]) {
+            if (i < NEAREST_VARIANTS) order[i] = order[i - 1];
+            i--;
+        }
+        if (i < NEAREST_VARIANTS) order[i] = v;
+    }
+    printf("Variants: %d\n", variants->case_count);
+    for (int i = 0; i < shown; i++) {
+        int v = order[i];
+        printf("%d (%d cases):", distances[v], weights[v]);
+        for (int e = variants->case_offsets[v]; e < variants->case_offsets[v + 1]; e++) {
+            printf("%s%s", e > variants->case_offsets[v] ? "," : " ", variants->dictionary.names[variants->events[e]]);
+        }
+        printf("\n");
+    }
+
+    free(order);
+    free(distances);
+    free_trace_pattern(p);
+    free(query);
+    free(weights);
+    free(case_variant);
+    free_encoded_log(variants);
+    free_encoded_log(enc);
+    free_log(log);
+    return 0;
+}
+
+static int prefix(const char *input, const char *list) {
+    PrefixTree *tree;
+    if (file_format(input) == FORMAT_PREFIX_TREE) {
+        tree = load_prefix_tree(input);
+        if (!tree) return 1;
+    } else {
+        Log *log = load_xes(input);
+        if (!log) return 1;
+        EncodedLog *enc = encode_log(log);
+        tree = build_prefix_tree(enc);
+        free_encoded_log(enc);
+        free_log(log);
+    }
+
+    /* Follow the prefix one activity at a time */
+    int node = 0;
+    if (list) {
+        char *copy = strdup(list);
+        for (char *name = strtok(copy, ","); name && node >= 0; name = strtok(NULL, ",")) {
+            int a = prefix_tree_activity(tree, name);
+            node = a < 0 ? -1 : prefix_child(tree, node, a);
+        }
+        free(copy);
+    }
+
+    /* No case has the prefix (or the log is empty): no ratios to print */
+    if (node < 0 || tree->nodes[node].case_to == tree->nodes[node].case_from) {
+        printf("Cases: 0\n");
+    } else {
+        const PrefixNode *v = &tree->nodes[node];
+        int cases = v->case_to - v->case_from;
+        int *activities = (int *)malloc(sizeof(int) * (v->child_count > 0 ? v->child_count : 1));
+        int *counts = (int *)malloc(sizeof(int) * (v->child_count > 0 ? v->child_count : 1));
+        int children = next_activities(tree, node, activities, counts);
+        printf("Cases: %d\n", cases);
+        printf("Ending: %d (%.4f)\n", v->end_count, (double)v->end_count / cases);
+        for (int i = 0; i < children; i++) {
+            printf("Next %s: %d (%.4f)\n", tree->activities[activities[i]], counts[i], (double)counts[i] / cases);
+        }
+        free(activities);
+        free(counts);
+    }
+    free_prefix_tree(tree);
+    return 0;
+}
+
+static int baseline(const char *input, const char *flower, const char *footprint) {
+    FILE *fp = fopen(input, "r");
+    if (!fp) {
+        perror("Failed to open input file");
+        return 1;
+    }
+    LogStatistics *stats = create_log_statistics();
+    read_log_statistics(fp, stats);
+    fclose(fp);
+
+    print_log_statistics(stdout, stats);
+    ProcessTree *tree = flower_tree(stats);
+    int status = export_ptml(tree, flower);
+    free_process_tree(tree);
+    if (status == 0 && footprint) status = export_footprint(stats, footprint);
+
+    free_log_statistics(stats);
+    return status == 0 ? 0 : 1;
+}
+
+static int ocdfg(const char *input) {
+    if (!is_ocel_format(file_format(input))) {
+        fprintf(stderr, "Unsupported log format: %s\n", input);
+        return 1;
+    }
+    OcelLog *log = load_ocel(input);
+    if (!log) return 1;
+    OcelObjectIndex *index = build_ocel_object_index(log);
+    if (index->unresolved > 0) fprintf(stderr, "Warning: %lld relationships to unknown objects\n", index->unresolved);
+    OcDfg *graph = compute_ocdfg(index);
+    print_ocdfg(stdout, graph, log);
+
+    free_ocdfg(graph);
+    free_ocel_object_index(index);
+    free_ocel(log);
+    return 0;
+}
+
+/* Time argument of window and value, TIMESTAMP_NONE (after a message) if not recognized */
+static long long time_argument(const char *text) {
+    long long time = parse_timestamp_string(text);
+    if (time == TIMESTAMP_NONE) fprintf(stderr, "Invalid time: %s\n", text);
+    return time;
+}
+
+static int window(const char *input, const char *from_text, const char *to_text) {
+    long long from = time_argument(from_text), to = time_argument(to_text);
+    if (from == TIMESTAMP_NONE || to == TIMESTAMP_NONE) return 1;
+    if (!is_ocel_format(file_format(input))) {
+        fprintf(stderr, "Unsupported log format: %s\n", input);
+        return 1;
+    }
+    OcelLog *log = load_ocel(input);
+    if (!log) return 1;
+    OcelTimeIndex *index = build_ocel_time_index(log);
+    int count;
+    const int *events = ocel_events_between(index, from, to, &count);
+    int *type_counts = (int *)calloc(log->event_type_count > 0 ? log->event_type_count : 1, sizeof(int));
+    for (int i = 0; i < count; i++) type_counts[log->events[events[i]].type]++;
+
+    printf("Events: %d\n", count);
+    for (int t = 0; t < log->event_type_count; t++) {
+        if (type_counts[t]) printf("%s: %d\n", log->event_types[t].name, type_counts[t]);
+    }
+    free(type_counts);
+    free_ocel_time_index(index);
+    free_ocel(log);
+    return 0;
+}
+
+static int value(const char *input, const char *object_id, const char *attribute, const char *time_text) {
+    long long time = time_argument(time_text);
+    if (time == TIMESTAMP_NONE) return 1;
+    if (!is_ocel_format(file_format(input))) {
+        fprintf(stderr, "Unsupported log format: %s\n", input);
+        return 1;
+    }
+    OcelLog *log = load_ocel(input);
+    if (!log) return 1;
+    int object = -1;
+    for (int o = 0; o < log->object_count && object < 0; o++) {
+        if (strcmp(log->objects[o].id, object_id) == 0) object = o;
+    }
+    int status = 0;
+    if (object < 0) {
+        fprintf(stderr, "Unknown object: %s\n", object_id);
+        status = 1;
+    } else {
+        OcelTimeIndex *index = build_ocel_time_index(log);
+        const char *v = ocel_object_value_at(index, object, attribute, time);
+        if (v) printf("%s\n", v);
+        else printf("(no value)\n");
+        free_ocel_time_index(index);
+    }
+    free_ocel(log);
+    return status;
+}
+
+static int load(int count, char **inputs) {
+    ImportJob *jobs = (ImportJob *)calloc(count, sizeof(ImportJob));
+    for (int i = 0; i < count; i++) jobs[i].filename = inputs[i];
+    int failed = import_logs(jobs, count);
+    for (int i = 0; i < count; i++) {
+        if (jobs[i].xes) {
+            long long events = 0;
+            for (int c = 0; c < jobs[i].xes->case_count; c++) events += jobs[i].xes->cases[c].activity_count;
+            printf("%s: %d cases, %lld events\n", jobs[i].filename, jobs[i].xes->case_count, events);
+        } else if (jobs[i].ocel) {
+            printf("%s: %d events, %d objects\n", jobs[i].filename, jobs[i].ocel->event_count, jobs[i].ocel->object_count);
+        } else {
+            printf("%s: failed\n", jobs[i].filename);
+        }
+    }
+    free_import_jobs(jobs, count);
+    free(jobs);
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *command = argv[1];
+    if (strcmp(command, "convert") == 0 && argc == 4) return convert(argv[2], argv[3], 0);
+    if (strcmp(command, "convert") == 0 && argc == 5 && strcmp(argv[2], "--stream") == 0) return convert(argv[3], argv[4], 1);
+    if (strcmp(command, "filter") == 0 && argc >= 4) return filter(argv[2], argv[3], argc - 4, argv + 4);
+    if (strcmp(command, "discover") == 0 && argc == 5) return discover(argv[2], argv[3], argv[4]);
+    if (strcmp(command, "replay") == 0 && argc == 4) return replay(argv[2], argv[3]);
+    if (strcmp(command, "stats") == 0 && argc >= 3) return stats(argv[2], argc - 3, argv + 3);
+    if (strcmp(command, "cluster") == 0 && argc == 5) return cluster(argv[2], argv[3], argv[4]);
+    if (strcmp(command, "ocdfg") == 0 && argc == 3) return ocdfg(argv[2]);
+    if (strcmp(command, "window") == 0 && argc == 5) return window(argv[2], argv[3], argv[4]);
+    if (strcmp(command, "load") == 0 && argc >= 3) return load(argc - 2, argv + 2);
+    if (strcmp(command, "value") == 0 && argc == 6) return value(argv[2], argv[3], argv[4], argv[5]);
+    if (strcmp(command, "baseline") == 0 && (argc == 4 || argc == 5)) return baseline(argv[2], argv[3], argc == 5 ? argv[4] : NULL);
+    if (strcmp(command, "prefix") == 0 && (argc == 3 || argc == 4)) return prefix(argv[2], argc == 4 ? argv[3] : NULL);
+    if (strcmp(command, "nearest") == 0 && (argc == 4 || argc == 5)) return nearest(argv[2], argv[3], argc == 5 ? atoi(argv[4]) : -1);
+    usage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,61 @@
+/*
+ * k - common log-processing library
+ *
+ * Umbrella header of the C modules that can be linked together into one
+ * program (the k command line, k.c, or any other client): the models with
+ * their importers/exporters and the entry points of the algorithms.
+ *
+ * Build the library modules with -DK_LIB (leaves out the mains of the
+ * importers/exporters) and the algorithm modules with -DK_CLI (leaves out the
+ * mains of the tools):
+ *   cc -O2 -fopenmp -DK_LIB -DK_CLI -o k k.c c_xes.c c_dfg.c c_pnml.c c_process_tree.c \
+ *      c_ocel.c c_ocel20_json.c c_ocel20_xml.c c_filter.c c_append_log.c c_alpha_miner.c \
+ *      c_inductive_miner.c c_tree_to_petri.c c_tree_fitness.c c_trace_clustering.c \
+ *      c_trace_distance.c c_prefix_tree.c c_log_stats.c c_ocdfg.c c_radix_sort.c \
+ *      c_ocel_time.c c_sort_log.c c_batch_import.c
+ *
+ * No module keeps global state: every model (Log, EncodedLog, DFG, PetriNet,
+ * ProcessTree, OcelLog, LogSelection, AppendLog, TracePattern, PrefixTree,
+ * LogStatistics, OcDfg, OcelTimeIndex) is created, filled and freed explicitly,
+ * so one process can hold several of them and pass them from step to step.
+ */
+
+#ifndef K_H
+#define K_H
+
+#include "c_xes.h"
+#include "c_dfg.h"
+#include "c_filter.h"
+#include "c_append_log.h"
+#include "c_trace_distance.h"
+#include "c_prefix_tree.h"
+#include "c_log_stats.h"
+#include "c_pnml.h"
+#include "c_process_tree.h"
+#include "c_ocel.h"
+#include "c_ocdfg.h"
+#include "c_ocel_time.h"
+#include "c_radix_sort.h"
+#include "c_sort_log.h"
+#include "c_batch_import.h"
+#include "c_timestamp.h"
+#include "c_file_format.h"
+
+/* c_alpha_miner.c: accepting Petri net of the Alpha Miner */
+PetriNet *alpha_miner(const EncodedLog *enc);
+
+/* c_inductive_miner.c: process tree of the Inductive Miner (IMd); the labels are the activities */
+ProcessTree *inductive_miner(const DFG *dfg, char **activities);
+
+/* c_tree_to_petri.c: accepting Petri net (source/sink) of a process tree */
+PetriNet *process_tree_to_petri_net(const ProcessTree *tree);
+
+/* c_tree_fitness.c: number of traces of enc accepted by the tree (checked once per variant) */
+int tree_fitness(const ProcessTree *tree, const EncodedLog *enc, int *variant_count, int *fitting_variants);
+
+/* c_trace_clustering.c: cluster (at most k, numbered by first case) of each case, by MinHash/LSH over the variants */
+int cluster_traces(const EncodedLog *enc, int k, int *case_cluster);
+/* c_trace_clustering.c: write the cases of each cluster to prefix_<cluster>.xes; 0 on success */
+int export_clusters(const Log *log, const int *case_cluster, int cluster_count, const char *prefix);
+
+#endif
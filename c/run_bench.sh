@@ -0,0 +1,27 @@
+#!/bin/sh
+# Builds the benchmark harnesses (c_bench.c) and appends their JSON lines to a results file,
+# labelled with the current commit, so runs can be compared across commits.
+#
+# Usage: ./run_bench.sh [results.jsonl] [harness options, e.g. --cases 10000 --iterations 10]
+
+set -e
+
+SRC=$(dirname "$0")
+RESULTS=bench_results.jsonl
+case "$1" in
+    ""|--*) ;;
+    *) RESULTS=$1; shift ;;
+esac
+CC=${CC:-cc}
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+
+LABEL=$(git -C "$SRC" rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+for format in XES PNML OCEL_JSON OCEL_XML; do
+    name=$(echo "$format" | tr 'A-Z' 'a-z')
+    $CC -O2 -DK_LIB -DBENCH_$format -o "$BUILD/bench_$name" "$SRC/c_bench.c" "$SRC/c_bench_gen.c"
+    "$BUILD/bench_$name" --label "$LABEL" --dir "$BUILD" "$@" >> "$RESULTS"
+done
+
+echo "Results appended to $RESULTS"
@@ -0,0 +1,235 @@
+! OCEL logs through the C importer (c/c_ocel.h, c/c_ocel_columns.h) via ISO_C_BINDING
+!
+! The C importer loads the log and lays it out in columns (c_ocel_columns.h); the
+! module maps the C arrays to Fortran array pointers with c_f_pointer, so the columns
+! are used where C keeps them, without copying. The C indices and offsets are 0-based:
+! the events of object o (1-based) are object_events(object_event_offsets(o) + 1 :
+! object_event_offsets(o + 1)), holding 0-based event indices, and likewise for the
+! objects of an event.
+!
+! Build (from this directory):
+!   gfortran -O2 -fopenmp -DK_LIB -o ocel_statistics f2003_ocel_c.f90 ../c/c_ocel_columns.c ../c/c_ocel.c \
+!     ../c/c_ocel20_json.c ../c/c_ocel20_xml.c ../c/c_ocdfg.c ../c/c_dfg.c ../c/c_radix_sort.c
+module ocel_c
+  use iso_c_binding
+  implicit none
+
+  ! Layout of OcelColumns (c_ocel_columns.h)
+  type, bind(c) :: ocel_columns_t
+    type(c_ptr) :: log
+    type(c_ptr) :: index
+    integer(c_int) :: event_count
+    integer(c_int) :: object_count
+    integer(c_int) :: event_type_count
+    integer(c_int) :: object_type_count
+    type(c_ptr) :: event_timestamps
+    type(c_ptr) :: event_types
+    type(c_ptr) :: object_types
+    type(c_ptr) :: event_object_offsets
+    type(c_ptr) :: event_objects
+    type(c_ptr) :: object_event_offsets
+    type(c_ptr) :: object_events
+  end type ocel_columns_t
+
+  ! Missing timestamp (TIMESTAMP_NONE of c_timestamp.h)
+  integer(c_long_long), parameter :: timestamp_none = -huge(0_c_long_long) - 1
+
+  ! A loaded log: the C handles and Fortran views of its columns
+  type :: ocel_log
+    type(c_ptr) :: log = c_null_ptr
+    type(c_ptr) :: columns = c_null_ptr
+    integer :: num_events = 0
+    integer :: num_objects = 0
+    integer :: num_event_types = 0
+    integer :: num_object_types = 0
+    integer(c_long_long), pointer :: event_timestamps(:) => null()
+    integer(c_int), pointer :: event_types(:) => null()
+    integer(c_int), pointer :: object_types(:) => null()
+    integer(c_int), pointer :: event_object_offsets(:) => null()
+    integer(c_int), pointer :: event_objects(:) => null()
+    integer(c_int), pointer :: object_event_offsets(:) => null()
+    integer(c_int), pointer :: object_events(:) => null()
+  end type ocel_log
+
+  interface
+    type(c_ptr) function load_ocel_file(filename) bind(c, name='load_ocel_file')
+      import :: c_ptr, c_char
+      character(kind=c_char), intent(in) :: filename(*)
+    end function load_ocel_file
+
+    subroutine free_ocel(log) bind(c, name='free_ocel')
+      import :: c_ptr
+      type(c_ptr), value :: log
+    end subroutine free_ocel
+
+    type(c_ptr) function ocel_columns(log) bind(c, name='ocel_columns')
+      import :: c_ptr
+      type(c_ptr), value :: log
+    end function ocel_columns
+
+    subroutine free_ocel_columns(columns) bind(c, name='free_ocel_columns')
+      import :: c_ptr
+      type(c_ptr), value :: columns
+    end subroutine free_ocel_columns
+
+    type(c_ptr) function ocel_event_type_name(log, type) bind(c, name='ocel_event_type_name')
+      import :: c_ptr, c_int
+      type(c_ptr), value :: log
+      integer(c_int), value :: type
+    end function ocel_event_type_name
+
+    type(c_ptr) function ocel_object_type_name(log, type) bind(c, name='ocel_object_type_name')
+      import :: c_ptr, c_int
+      type(c_ptr), value :: log
+      integer(c_int), value :: type
+    end function ocel_object_type_name
+
+    integer(c_size_t) function c_strlen(string) bind(c, name='strlen')
+      import :: c_ptr, c_size_t
+      type(c_ptr), value :: string
+    end function c_strlen
+  end interface
+
+contains
+
+  ! Load filename (.json/.jsonocel, otherwise OCEL XML); status is 0 if loaded, -1 on error
+  subroutine open_ocel(filename, log, status)
+    character(len=*), intent(in) :: filename
+    type(ocel_log), intent(out) :: log
+    integer, intent(out) :: status
+    type(ocel_columns_t), pointer :: columns
+
+    status = -1
+    log%log = load_ocel_file(trim(filename) // c_null_char)
+    if (.not. c_associated(log%log)) return
+
+    log%columns = ocel_columns(log%log)
+    call c_f_pointer(log%columns, columns)
+    log%num_events = columns%event_count
+    log%num_objects = columns%object_count
+    log%num_event_types = columns%event_type_count
+    log%num_object_types = columns%object_type_count
+
+    call c_f_pointer(columns%event_timestamps, log%event_timestamps, [log%num_events])
+    call c_f_pointer(columns%event_types, log%event_types, [log%num_events])
+    call c_f_pointer(columns%object_types, log%object_types, [log%num_objects])
+    call c_f_pointer(columns%event_object_offsets, log%event_object_offsets, [log%num_events + 1])
+    call c_f_pointer(columns%object_event_offsets, log%object_event_offsets, [log%num_objects + 1])
+    call c_f_pointer(columns%event_objects, log%event_objects, &
+                     [log%event_object_offsets(log%num_events + 1)])
+    call c_f_pointer(columns%object_events, log%object_events, &
+                     [log%object_event_offsets(log%num_objects + 1)])
+    status = 0
+  end subroutine open_ocel
+
+  ! Free the log and its columns; the array pointers are nullified
+  subroutine close_ocel(log)
+    type(ocel_log), intent(inout) :: log
+
+    if (c_associated(log%columns)) call free_ocel_columns(log%columns)
+    if (c_associated(log%log)) call free_ocel(log%log)
+    log%columns = c_null_ptr
+    log%log = c_null_ptr
+    nullify(log%event_timestamps, log%event_types, log%object_types, log%event_object_offsets, &
+            log%event_objects, log%object_event_offsets, log%object_events)
+  end subroutine close_ocel
+
+  ! Name of event type / object type (0-based type code, as in the columns)
+  function event_type_name(log, type) result(name)
+    type(ocel_log), intent(in) :: log
+    integer, intent(in) :: type
+    character(len=:), allocatable :: name
+
+    name = c_string(ocel_event_type_name(log%log, int(type, c_int)))
+  end function event_type_name
+
+  function object_type_name(log, type) result(name)
+    type(ocel_log), intent(in) :: log
+    integer, intent(in) :: type
+    character(len=:), allocatable :: name
+
+    name = c_string(ocel_object_type_name(log%log, int(type, c_int)))
+  end function object_type_name
+
+  ! Copy of a NUL-terminated C string ('' for NULL)
+  function c_string(pointer) result(string)
+    type(c_ptr), intent(in) :: pointer
+    character(len=:), allocatable :: string
+    character(kind=c_char), pointer :: chars(:)
+    integer :: i, length
+
+    if (.not. c_associated(pointer)) then
+      string = ''
+      return
+    end if
+    length = int(c_strlen(pointer))
+    call c_f_pointer(pointer, chars, [length])
+    allocate(character(len=length) :: string)
+    do i = 1, length
+      string(i:i) = chars(i)
+    end do
+  end function c_string
+
+end module ocel_c
+
+! Counts of an OCEL log, computed on the C columns
+program ocel_statistics
+  use ocel_c
+  implicit none
+
+  type(ocel_log) :: log
+  integer :: argc, status, i
+  integer, allocatable :: events_per_type(:), objects_per_type(:)
+  integer(c_long_long) :: first_time, last_time
+  character(len=1024) :: input_filename
+
+  argc = command_argument_count()
+  if (argc /= 1) then
+    print *, 'Usage: ./ocel_statistics input.jsonocel|input.xmlocel'
+    stop
+  end if
+  call get_command_argument(1, input_filename)
+
+  call open_ocel(input_filename, log, status)
+  if (status /= 0) then
+    print *, 'Error loading file: ', trim(input_filename)
+    stop
+  end if
+
+  ! Type codes are 0-based
+  allocate(events_per_type(0:max(log%num_event_types, 1) - 1))
+  allocate(objects_per_type(0:max(log%num_object_types, 1) - 1))
+  events_per_type = 0
+  objects_per_type = 0
+  do i = 1, log%num_events
+    events_per_type(log%event_types(i)) = events_per_type(log%event_types(i)) + 1
+  end do
+  do i = 1, log%num_objects
+    objects_per_type(log%object_types(i)) = objects_per_type(log%object_types(i)) + 1
+  end do
+
+  first_time = huge(0_c_long_long)
+  last_time = -huge(0_c_long_long)
+  do i = 1, log%num_events
+    if (log%event_timestamps(i) == timestamp_none) cycle
+    first_time = min(first_time, log%event_timestamps(i))
+    last_time = max(last_time, log%event_timestamps(i))
+  end do
+
+  write(*, '(A, I0)') 'Events: ', log%num_events
+  do i = 0, log%num_event_types - 1
+    write(*, '(2X, A, ": ", I0)') event_type_name(log, i), events_per_type(i)
+  end do
+  write(*, '(A, I0)') 'Objects: ', log%num_objects
+  do i = 0, log%num_object_types - 1
+    write(*, '(2X, A, ": ", I0)') object_type_name(log, i), objects_per_type(i)
+  end do
+  write(*, '(A, I0)') 'E2O relationships: ', log%event_object_offsets(log%num_events + 1)
+  if (first_time <= last_time) then
+    write(*, '(A, I0, A, I0)') 'Time span (ms since epoch): ', first_time, ' .. ', last_time
+  end if
+
+  deallocate(events_per_type, objects_per_type)
+  call close_ocel(log)
+
+end program ocel_statistics
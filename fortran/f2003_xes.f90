@@ -1,16 +1,31 @@
 program xes_processor
   implicit none
-  ! Declare types
-  type Event
-     character(len=:), allocatable :: activity
-  end type Event
 
-  type Trace
-     type(Event), allocatable :: events(:)
-  end type Trace
+  ! Initial capacities; every array doubles when full, so importing n events costs O(n)
+  integer, parameter :: initial_capacity = 1024
+  integer, parameter :: initial_text_capacity = 4096
+  integer, parameter :: initial_slot_capacity = 64
 
+  ! Declare types
+  ! Activity names interned to integer codes 1, 2, ...: the names are stored one after another
+  ! in text, name i being text(nameStart(i):nameStart(i+1)-1); slots is an open-addressing
+  ! hash table of the codes (0: empty)
+  type ActivityDictionary
+     integer :: count = 0
+     integer :: textLength = 0
+     character(len=:), allocatable :: text
+     integer, allocatable :: nameStart(:)
+     integer, allocatable :: slots(:)
+  end type ActivityDictionary
+
+  ! Log in CSR layout: the events of trace i are events(traceStart(i):traceStart(i+1)-1),
+  ! each the code of its activity in the dictionary
   type Log
-     type(Trace), allocatable :: traces(:)
+     integer :: traceCount = 0
+     integer :: eventCount = 0
+     integer, allocatable :: traceStart(:)
+     integer, allocatable :: events(:)
+     type(ActivityDictionary) :: dictionary
   end type Log
 
   ! Declare variables
@@ -45,21 +60,16 @@ contains
     character(len=*), intent(in) :: filename
     type(Log), intent(out) :: logData
 
-    integer :: unit, ios
+    integer :: unit, ios, valueStart, valueEnd, n
     character(len=1000) :: line
     logical :: inTrace, inEvent
-    type(Trace) :: currentTrace
-    type(Event) :: currentEvent
-
-    integer :: traceCount, eventCount
+    integer :: activity
 
     ! Initialize variables
     inTrace = .false.
     inEvent = .false.
-    traceCount = 0
-    eventCount = 0
-    if (allocated(logData%traces)) deallocate(logData%traces)
-    if (allocated(currentTrace%events)) deallocate(currentTrace%events)
+    activity = 0
+    call initLog(logData)
 
     ! Open the file
     open(newunit=unit, file=filename, status='old', action='read', iostat=ios)
@@ -73,56 +83,48 @@ contains
       read(unit, '(A)', iostat=ios) line
       if (ios /= 0) exit
 
-      ! Trim leading spaces
+      ! Trim leading spaces; the tests look at the n characters up to the trailing blanks only
       line = adjustl(line)
+      n = len_trim(line)
 
-      ! Check for trace start
-      if (index(line, '<trace') > 0) then
+      ! Check for trace start: the events of the trace are appended from here
+      if (index(line(1:n), '<trace') > 0) then
          inTrace = .true.
-         eventCount = 0
-         if (allocated(currentTrace%events)) deallocate(currentTrace%events)
          cycle
       end if
 
       ! Check for trace end
-      if (index(line, '</trace') > 0) then
+      if (index(line(1:n), '</trace') > 0) then
          inTrace = .false.
-         traceCount = traceCount + 1
-         if (.not. allocated(logData%traces)) then
-            allocate(logData%traces(1))
-         else
-            call resizeTraces(logData%traces, traceCount)
-         end if
-         logData%traces(traceCount) = currentTrace
-         if (allocated(currentTrace%events)) deallocate(currentTrace%events)
+         logData%traceCount = logData%traceCount + 1
+         call growIntegers(logData%traceStart, logData%traceCount + 1)
+         logData%traceStart(logData%traceCount + 1) = logData%eventCount + 1
          cycle
       end if
 
       if (inTrace) then
          ! Check for event start
-         if (index(line, '<event') > 0) then
+         if (index(line(1:n), '<event') > 0) then
             inEvent = .true.
-            currentEvent%activity = ''
+            activity = 0
             cycle
          end if
 
          ! Check for event end
-         if (index(line, '</event') > 0) then
+         if (index(line(1:n), '</event') > 0) then
             inEvent = .false.
-            eventCount = eventCount + 1
-            if (.not. allocated(currentTrace%events)) then
-               allocate(currentTrace%events(1))
-            else
-               call resizeEvents(currentTrace%events, eventCount)
-            end if
-            currentTrace%events(eventCount) = currentEvent
+            if (activity == 0) activity = internActivity(logData%dictionary, '')
+            logData%eventCount = logData%eventCount + 1
+            call growIntegers(logData%events, logData%eventCount)
+            logData%events(logData%eventCount) = activity
             cycle
          end if
 
          if (inEvent) then
             ! Check for concept:name attribute
-            if (index(line, 'key="concept:name"') > 0) then
-               call extractActivity(line, currentEvent%activity)
+            if (index(line(1:n), 'key="concept:name"') > 0) then
+               call findActivity(line(1:n), valueStart, valueEnd)
+               activity = internActivity(logData%dictionary, line(valueStart:valueEnd))
             end if
          end if
       end if
@@ -131,26 +133,148 @@ contains
     close(unit)
   end subroutine importXES
 
-  subroutine extractActivity(line, activity)
+  subroutine initLog(logData)
+    type(Log), intent(inout) :: logData
+
+    logData%traceCount = 0
+    logData%eventCount = 0
+    allocate(logData%traceStart(initial_capacity))
+    allocate(logData%events(initial_capacity))
+    logData%traceStart(1) = 1
+
+    logData%dictionary%count = 0
+    logData%dictionary%textLength = 0
+    allocate(character(len=initial_text_capacity) :: logData%dictionary%text)
+    allocate(logData%dictionary%nameStart(initial_capacity))
+    allocate(logData%dictionary%slots(initial_slot_capacity))
+    logData%dictionary%nameStart(1) = 1
+    logData%dictionary%slots = 0
+  end subroutine initLog
+
+  ! Position of the value of the value attribute in line (valueEnd < valueStart if none)
+  subroutine findActivity(line, valueStart, valueEnd)
     character(len=*), intent(in) :: line
-    character(len=:), allocatable, intent(out) :: activity
-    integer :: startPos, endPos
+    integer, intent(out) :: valueStart, valueEnd
 
     ! Find the value attribute
-    startPos = index(line, 'value="') + len('value="')
-    if (startPos > len('value="')) then
-       endPos = index(line(startPos:), '"') + startPos - 2
-       activity = line(startPos:endPos)
+    valueStart = index(line, 'value="') + len('value="')
+    if (valueStart > len('value="')) then
+       valueEnd = index(line(valueStart:), '"') + valueStart - 2
     else
-       activity = ''
+       valueStart = 1
+       valueEnd = 0
+    end if
+  end subroutine findActivity
+
+  ! Make room for at least needed elements, doubling the capacity
+  subroutine growIntegers(array, needed)
+    integer, allocatable, intent(inout) :: array(:)
+    integer, intent(in) :: needed
+    integer, allocatable :: temp(:)
+    integer :: capacity
+
+    capacity = size(array)
+    if (needed <= capacity) return
+    do while (capacity < needed)
+       capacity = capacity * 2
+    end do
+    allocate(temp(capacity))
+    temp(1:size(array)) = array
+    call move_alloc(temp, array)
+  end subroutine growIntegers
+
+  subroutine growText(text, needed)
+    character(len=:), allocatable, intent(inout) :: text
+    integer, intent(in) :: needed
+    character(len=:), allocatable :: temp
+    integer :: capacity
+
+    capacity = len(text)
+    if (needed <= capacity) return
+    do while (capacity < needed)
+       capacity = capacity * 2
+    end do
+    allocate(character(len=capacity) :: temp)
+    temp(1:len(text)) = text
+    call move_alloc(temp, text)
+  end subroutine growText
+
+  ! FNV-1a hash of name, 0 .. 2**32 - 1
+  integer(8) function hashName(name)
+    character(len=*), intent(in) :: name
+    integer :: i
+
+    hashName = 2166136261_8
+    do i = 1, len(name)
+       hashName = iand(ieor(hashName, int(ichar(name(i:i)), 8)) * 16777619_8, 4294967295_8)
+    end do
+  end function hashName
+
+  function activityName(dictionary, code) result(name)
+    type(ActivityDictionary), intent(in) :: dictionary
+    integer, intent(in) :: code
+    character(len=:), allocatable :: name
+
+    name = dictionary%text(dictionary%nameStart(code):dictionary%nameStart(code + 1) - 1)
+  end function activityName
+
+  ! Slot of name in the hash table: the slot holding its code, or the empty slot to put it in
+  integer function findSlot(dictionary, name)
+    type(ActivityDictionary), intent(in) :: dictionary
+    character(len=*), intent(in) :: name
+    integer :: mask, code
+
+    mask = size(dictionary%slots) - 1
+    findSlot = int(iand(hashName(name), int(mask, 8))) + 1
+    do
+       code = dictionary%slots(findSlot)
+       if (code == 0) return
+       if (dictionary%nameStart(code + 1) - dictionary%nameStart(code) == len(name)) then
+          if (dictionary%text(dictionary%nameStart(code):dictionary%nameStart(code + 1) - 1) == name) return
+       end if
+       findSlot = iand(findSlot, mask) + 1
+    end do
+  end function findSlot
+
+  ! Code of name, adding it to the dictionary if it is new
+  integer function internActivity(dictionary, name)
+    type(ActivityDictionary), intent(inout) :: dictionary
+    character(len=*), intent(in) :: name
+    integer :: slot, code
+
+    slot = findSlot(dictionary, name)
+    if (dictionary%slots(slot) /= 0) then
+       internActivity = dictionary%slots(slot)
+       return
+    end if
+
+    dictionary%count = dictionary%count + 1
+    internActivity = dictionary%count
+    call growText(dictionary%text, dictionary%textLength + len(name))
+    dictionary%text(dictionary%textLength + 1:dictionary%textLength + len(name)) = name
+    dictionary%textLength = dictionary%textLength + len(name)
+    call growIntegers(dictionary%nameStart, dictionary%count + 1)
+    dictionary%nameStart(dictionary%count + 1) = dictionary%textLength + 1
+    dictionary%slots(slot) = internActivity
+
+    ! Keep the load factor below 1/2
+    if (2 * dictionary%count > size(dictionary%slots)) then
+       code = 2 * size(dictionary%slots)
+       deallocate(dictionary%slots)
+       allocate(dictionary%slots(code))
+       dictionary%slots = 0
+       do code = 1, dictionary%count
+          slot = findSlot(dictionary, activityName(dictionary, code))
+          dictionary%slots(slot) = code
+       end do
     end if
-  end subroutine extractActivity
+  end function internActivity
 
   subroutine exportXES(filename, logData)
     character(len=*), intent(in) :: filename
     type(Log), intent(in) :: logData
 
-    integer :: unit, ios, i, j
+    integer :: unit, ios, i, j, code
 
     ! Open the file for writing
     open(newunit=unit, file=filename, status='replace', action='write', iostat=ios)
@@ -164,13 +288,15 @@ contains
     write(unit, '(A)') '<log>'
 
     ! Loop over traces
-    do i = 1, size(logData%traces)
+    do i = 1, logData%traceCount
        write(unit, '(A)') '  <trace>'
        ! Loop over events
-       do j = 1, size(logData%traces(i)%events)
+       do j = logData%traceStart(i), logData%traceStart(i + 1) - 1
+          code = logData%events(j)
           write(unit, '(A)') '    <event>'
           write(unit, '(A)', advance='no') '      <string key="concept:name" value="'
-          write(unit, '(A)', advance='no') trim(logData%traces(i)%events(j)%activity)
+          write(unit, '(A)', advance='no') &
+               trim(logData%dictionary%text(logData%dictionary%nameStart(code):logData%dictionary%nameStart(code + 1) - 1))
           write(unit, '(A)') '"/>'
           write(unit, '(A)') '    </event>'
        end do
@@ -181,44 +307,4 @@ contains
     close(unit)
   end subroutine exportXES
 
-  subroutine resizeTraces(traces, newSize)
-    type(Trace), allocatable, intent(inout) :: traces(:)
-    integer, intent(in) :: newSize
-    type(Trace), allocatable :: temp(:)
-    integer :: oldSize
-
-    if (allocated(traces)) then
-        oldSize = size(traces)
-    else
-        oldSize = 0
-    end if
-
-    allocate(temp(newSize))
-    if (oldSize > 0) then
-        temp(1:oldSize) = traces
-    end if
-    deallocate(traces)
-    traces = temp
-  end subroutine resizeTraces
-
-  subroutine resizeEvents(events, newSize)
-    type(Event), allocatable, intent(inout) :: events(:)
-    integer, intent(in) :: newSize
-    type(Event), allocatable :: temp(:)
-    integer :: oldSize
-
-    if (allocated(events)) then
-        oldSize = size(events)
-    else
-        oldSize = 0
-    end if
-
-    allocate(temp(newSize))
-    if (oldSize > 0) then
-        temp(1:oldSize) = events
-    end if
-    deallocate(events)
-    events = temp
-  end subroutine resizeEvents
-
-end program xes_processor
\ No newline at end of file
+end program xes_processor
@@ -30,21 +30,25 @@ end
 
 traces = xes_importer.traces
 
-# Initialize DFG components
-activities = Set.new
-start_activities = Set.new
-end_activities = Set.new
-edges = Set.new
-
-traces.each do |trace|
-  next if trace.empty?
-
-  activities.merge(trace)
-  start_activities << trace.first
-  end_activities << trace.last
-
-  trace.each_cons(2) do |from_activity, to_activity|
-    edges << [from_activity, to_activity]
+# Initialize DFG components (counted natively if the extension of rb_k_native.c is built)
+if defined?(KNative)
+  activities, start_activities, end_activities, edges = KNative.dfg(traces).map(&:to_set)
+else
+  activities = Set.new
+  start_activities = Set.new
+  end_activities = Set.new
+  edges = Set.new
+
+  traces.each do |trace|
+    next if trace.empty?
+
+    activities.merge(trace)
+    start_activities << trace.first
+    end_activities << trace.last
+
+    trace.each_cons(2) do |from_activity, to_activity|
+      edges << [from_activity, to_activity]
+    end
   end
 end
 
@@ -80,11 +84,54 @@ class DFG
 	end
 end
 
+# Analyses of the sub-DFGs met during the recursion, computed once per activity subset: the
+# entries are keyed by the bitset of their activities (bit i: activity i of the root DFG) and
+# hold the projected DFG, its reachability closure, the connected components of its undirected
+# graph and its cut
+class DFGCache
+  Entry = Struct.new(:dfg, :reachability, :components, :cut)
+
+  def initialize(root_dfg)
+    @bits = {}
+    root_dfg.activities.each_with_index { |activity, i| @bits[activity] = 1 << i }
+    @entries = {}
+  end
+
+  # DFG projected on activities (a subset of those of dfg)
+  def project(dfg, activities)
+    entry(dfg, activities).dfg
+  end
+
+  def reachability(dfg)
+    cached = entry(dfg, dfg.activities)
+    cached.reachability ||= compute_reachability(cached.dfg)
+  end
+
+  # Components of the DFG projected on activities (by default, of dfg itself)
+  def components(dfg, activities = dfg.activities)
+    cached = entry(dfg, activities)
+    cached.components ||= connected_components(cached.dfg)
+  end
+
+  # Cut of dfg, computed by the block the first time
+  def cut(dfg)
+    cached = entry(dfg, dfg.activities)
+    cached.cut ||= yield
+  end
+
+  private
+
+  def entry(dfg, activities)
+    key = activities.sum { |activity| @bits[activity] }
+    @entries[key] ||= Entry.new(activities.size == dfg.activities.size ? dfg : dfg.project(activities))
+  end
+end
+
 # Create the DFG
 dfg = DFG.new(activities, start_activities, end_activities, edges)
 
 # Implement the Inductive Miner algorithm
-def inductive_miner(dfg)
+def inductive_miner(dfg, cache)
   # Base case: if DFG has only one activity
   if dfg.activities.size == 1
     activity = dfg.activities.to_a.first
@@ -92,61 +139,37 @@ def inductive_miner(dfg)
     return node
   end
 
-  # Try to detect sequence cut
-  sequence_groups = detect_sequence_cut(dfg)
-  if sequence_groups && sequence_groups.length > 1
-    sequence_node = ProcessNode.new(SecureRandom.uuid, '', 'sequence')
-    sequence_groups.each do |group|
-      projected_dfg = dfg.project(group)
-      child_node = inductive_miner(projected_dfg)
-      sequence_node.add_child(child_node)
-    end
-    return sequence_node
-  end
+  operator, groups = detect_cut(dfg, cache)
 
-  # Try to detect XOR cut
-  xor_groups = detect_xor_cut(dfg)
-  if xor_groups && xor_groups.length > 1
-    xor_node = ProcessNode.new(SecureRandom.uuid, '', 'xor')
-    xor_groups.each do |group|
-      projected_dfg = dfg.project(group)
-      child_node = inductive_miner(projected_dfg)
-      xor_node.add_child(child_node)
+  # Sequence, XOR or parallel cut: one child per group
+  if operator == 'sequence' || operator == 'xor' || operator == 'and'
+    cut_node = ProcessNode.new(SecureRandom.uuid, '', operator)
+    groups.each do |group|
+      projected_dfg = cache.project(dfg, group)
+      child_node = inductive_miner(projected_dfg, cache)
+      cut_node.add_child(child_node)
     end
-    return xor_node
+    return cut_node
   end
 
-  # Try to detect parallel cut
-  parallel_groups = detect_parallel_cut(dfg)
-  if parallel_groups && parallel_groups.length > 1
-    and_node = ProcessNode.new(SecureRandom.uuid, '', 'and')
-    parallel_groups.each do |group|
-      projected_dfg = dfg.project(group)
-      child_node = inductive_miner(projected_dfg)
-      and_node.add_child(child_node)
-    end
-    return and_node
-  end
-
-  # Try to detect loop cut
-  loop_groups = detect_loop_cut(dfg)
-  if loop_groups && loop_groups.length > 1
+  # Loop cut
+  if operator == 'xorLoop'
     loop_node = ProcessNode.new(SecureRandom.uuid, '', 'xorLoop')
 
     # 'Do' group
-    do_group = loop_groups.shift
-    do_dfg = dfg.project(do_group)
-    do_node = inductive_miner(do_dfg)
+    do_group, *redo_groups = groups
+    do_dfg = cache.project(dfg, do_group)
+    do_node = inductive_miner(do_dfg, cache)
 
     # 'Redo' group (merge if multiple groups exist)
-    if loop_groups.length == 1
-      redo_dfg = dfg.project(loop_groups.first)
-      redo_node = inductive_miner(redo_dfg)
+    if redo_groups.length == 1
+      redo_dfg = cache.project(dfg, redo_groups.first)
+      redo_node = inductive_miner(redo_dfg, cache)
     else
       redo_node = ProcessNode.new(SecureRandom.uuid, '', 'xor')
-      loop_groups.each do |group|
-        projected_dfg = dfg.project(group)
-        child_node = inductive_miner(projected_dfg)
+      redo_groups.each do |group|
+        projected_dfg = cache.project(dfg, group)
+        child_node = inductive_miner(projected_dfg, cache)
         redo_node.add_child(child_node)
       end
     end
@@ -176,8 +199,24 @@ def inductive_miner(dfg)
   return loop_node
 end
 
+# Cut of the DFG as [operator, groups] ([nil, nil] if there is none), trying the sequence,
+# XOR, parallel and loop cuts in this order; memoized per activity subset
+def detect_cut(dfg, cache)
+  cache.cut(dfg) do
+    sequence_groups = detect_sequence_cut(dfg, cache)
+    next ['sequence', sequence_groups] if sequence_groups && sequence_groups.length > 1
+    xor_groups = detect_xor_cut(dfg, cache)
+    next ['xor', xor_groups] if xor_groups && xor_groups.length > 1
+    parallel_groups = detect_parallel_cut(dfg)
+    next ['and', parallel_groups] if parallel_groups && parallel_groups.length > 1
+    loop_groups = detect_loop_cut(dfg, cache)
+    next ['xorLoop', loop_groups] if loop_groups && loop_groups.length > 1
+    [nil, nil]
+  end
+end
+
 # Detect sequence cut
-def detect_sequence_cut(dfg)
+def detect_sequence_cut(dfg, cache)
   # Step 1: Create a group per activity
   groups = {}
   dfg.activities.each do |activity|
@@ -185,7 +224,7 @@ def detect_sequence_cut(dfg)
   end
 
   # Step 2: Merge pairwise reachable nodes
-  reachability = compute_reachability(dfg)
+  reachability = cache.reachability(dfg)
   union_find = UnionFind.new(dfg.activities)
 
   dfg.activities.each do |a|
@@ -314,7 +353,19 @@ def topological_sort_groups(groups, dfg)
 end
 
 # Detect XOR cut
-def detect_xor_cut(dfg)
+def detect_xor_cut(dfg, cache)
+  components = cache.components(dfg)
+
+  if components.size > 1
+    # Return the groups
+    return components
+  else
+    return nil
+  end
+end
+
+# Connected components of the DFG, with its edges taken as undirected
+def connected_components(dfg)
   # Convert DFG edges to undirected edges
   undirected_edges = dfg.edges.to_a + dfg.edges.map { |from, to| [to, from] }
   # Build adjacency list
@@ -344,13 +395,7 @@ def detect_xor_cut(dfg)
     end
     components << component
   end
-
-  if components.size > 1
-    # Return the groups
-    return components
-  else
-    return nil
-  end
+  components
 end
 
 # Detect parallel cut
@@ -430,43 +475,15 @@ def detect_parallel_cut(dfg)
 end
 
 # Detect loop cut
-def detect_loop_cut(dfg)
+def detect_loop_cut(dfg, cache)
   # Step 1: Merge all start and end activities into one group ('do' group)
   do_group = dfg.start_activities | dfg.end_activities
   remaining_activities = dfg.activities - do_group
 
-  # Step 2: Remove start/end activities from the DFG
-  reduced_edges = dfg.edges.reject { |from, to| do_group.include?(from) || do_group.include?(to) }
-  reduced_dfg = DFG.new(remaining_activities, Set.new, Set.new, reduced_edges)
-
+  # Step 2: Remove start/end activities from the DFG: what is left is the DFG projected on the
+  # remaining activities
   # Step 3: Detect connected components in the reduced graph
-  undirected_edges = reduced_dfg.edges.to_a + reduced_dfg.edges.map { |from, to| [to, from] }
-  adjacency = Hash.new { |hash, key| hash[key] = [] }
-  undirected_edges.each do |from, to|
-    adjacency[from] << to
-    adjacency[to] << from
-  end
-  visited = {}
-  components = []
-
-  reduced_dfg.activities.each do |activity|
-    next if visited[activity]
-    # Start a new component
-    component = Set.new
-    queue = [activity]
-    visited[activity] = true
-    while !queue.empty?
-      current = queue.shift
-      component << current
-      adjacency[current].each do |neighbor|
-        unless visited[neighbor]
-          visited[neighbor] = true
-          queue << neighbor
-        end
-      end
-    end
-    components << component
-  end
+  components = cache.components(dfg, remaining_activities)
 
   # Step 4: Check if each component meets the start/end criteria, else merge with 'do' group
   valid_components = []
@@ -487,7 +504,7 @@ def detect_loop_cut(dfg)
 end
 
 # Now, run the inductive miner on the DFG
-root_node = inductive_miner(dfg)
+root_node = inductive_miner(dfg, DFGCache.new(dfg))
 
 # Build the process tree
 nodes = []
@@ -0,0 +1,198 @@
+/*
+ * Native extension for the Ruby miners: the C XES importer and DFG (c/c_xes.c, c/c_dfg.c)
+ *
+ * KNative.import_xes(path)      traces of the XES file, as Arrays of activity names (frozen, interned Strings)
+ * KNative.import_xes_ids(path)  [activities, traces]: the distinct activity names (frozen, interned) in order of
+ *                               first occurrence and the traces as Arrays of indices into them
+ * KNative.dfg(traces)           [activities, start_activities, end_activities, edges] of traces given as Arrays of
+ *                               activity names (Strings), the edges as [from, to] pairs
+ *
+ * rb_xes.rb imports through the extension when it is built, so do the miners that use it, and
+ * rb_inductive_miner.rb takes its DFG from KNative.dfg. Without the extension both stay in Ruby.
+ *
+ * Build (from this directory):
+ *   cc -O2 -shared -fPIC -DK_LIB -I"$(ruby -e 'print RbConfig::CONFIG["rubyhdrdir"]')" \
+ *     -I"$(ruby -e 'print RbConfig::CONFIG["rubyarchhdrdir"]')" -o k_native.so rb_k_native.c ../c/c_xes.c ../c/c_dfg.c
+ *
+ * **Main Components:**
+
+- **Import:**
+  - The file is read in one pass by `read_xes` (no `Log` in between); its handler appends to the Ruby
+    arrays directly. The activities are interned in an `ActivityDictionary`, so each distinct name is
+    converted to a Ruby String once and all its events share that object.
+  - The file is closed and the dictionary freed by `rb_ensure`, also when Ruby raises in between.
+  - The limits of `read_xes` apply: lines are read 1023 bytes at a time and activity names are
+    cut to 255 bytes (MAX_ACTIVITY_LENGTH - 1 in c/c_xes.c).
+
+- **DFG:**
+  - The traces are encoded over an `ActivityDictionary` into an `EncodedLog` and `compute_dfg` counts the
+    relations; the result refers to the String objects of the traces (the first occurrence of each name).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ruby.h>
+#include <ruby/encoding.h>
+
+#include "../c/c_xes.h"
+#include "../c/c_dfg.h"
+
+#define INITIAL_EVENT_CAPACITY 1024
+
+/* Import */
+
+typedef struct {
+    const char *path;
+    FILE *fp;
+    ActivityDictionary dictionary;
+    VALUE names;        /* activity id -> frozen String */
+    VALUE traces;
+    VALUE trace;        /* trace being read, Qnil outside of traces */
+    int ids;            /* 1: events as activity ids, 0: as names */
+} XesImport;
+
+static void import_begin_trace(void *context) {
+    XesImport *import = (XesImport *)context;
+    import->trace = rb_ary_new();
+}
+
+static void import_end_trace(void *context) {
+    XesImport *import = (XesImport *)context;
+    if (!NIL_P(import->trace)) rb_ary_push(import->traces, import->trace);
+    import->trace = Qnil;
+}
+
+static void import_event(void *context, const char *activity, long long timestamp) {
+    XesImport *import = (XesImport *)context;
+    (void)timestamp;
+    if (NIL_P(import->trace)) return;
+    int id = intern_activity(&import->dictionary, activity);
+    if (id == RARRAY_LEN(import->names)) {
+        rb_ary_push(import->names, rb_enc_interned_str(activity, (long)strlen(activity), rb_utf8_encoding()));
+    }
+    rb_ary_push(import->trace, import->ids ? INT2FIX(id) : RARRAY_AREF(import->names, id));
+}
+
+static VALUE import_read(VALUE arg) {
+    static const XesHandler handler = { import_begin_trace, import_end_trace, import_event };
+    XesImport *import = (XesImport *)arg;
+    read_xes(import->fp, &handler, import);
+    return Qnil;
+}
+
+static VALUE import_close(VALUE arg) {
+    XesImport *import = (XesImport *)arg;
+    fclose(import->fp);
+    free_activity_dictionary(&import->dictionary);
+    return Qnil;
+}
+
+static void import_file(XesImport *import, VALUE path, int ids) {
+    import->path = StringValueCStr(path);
+    import->fp = fopen(import->path, "r");
+    if (!import->fp) rb_sys_fail(import->path);
+    init_activity_dictionary(&import->dictionary);
+    import->names = rb_ary_new();
+    import->traces = rb_ary_new();
+    import->trace = Qnil;
+    import->ids = ids;
+    rb_ensure(import_read, (VALUE)import, import_close, (VALUE)import);
+}
+
+static VALUE k_import_xes(VALUE self, VALUE path) {
+    XesImport import;
+    (void)self;
+    import_file(&import, path, 0);
+    RB_GC_GUARD(import.names);
+    return import.traces;
+}
+
+static VALUE k_import_xes_ids(VALUE self, VALUE path) {
+    XesImport import;
+    (void)self;
+    import_file(&import, path, 1);
+    return rb_assoc_new(import.names, import.traces);
+}
+
+/* DFG */
+
+typedef struct {
+    VALUE traces;
+    VALUE names;        /* activity id -> String of the traces */
+    EncodedLog *enc;
+    DFG *dfg;
+} DfgBuild;
+
+static VALUE dfg_compute(VALUE arg) {
+    DfgBuild *build = (DfgBuild *)arg;
+    EncodedLog *enc = build->enc;
+    long case_count = RARRAY_LEN(build->traces);
+    int capacity = INITIAL_EVENT_CAPACITY;
+
+    enc->case_offsets = (int *)malloc(sizeof(int) * (case_count + 1));
+    enc->events = (int *)malloc(sizeof(int) * capacity);
+    for (long c = 0; c < case_count; c++) {
+        VALUE trace = rb_ary_entry(build->traces, c);
+        Check_Type(trace, T_ARRAY);
+        enc->case_offsets[enc->case_count++] = enc->event_count;
+        for (long i = 0; i < RARRAY_LEN(trace); i++) {
+            VALUE activity = rb_ary_entry(trace, i);
+            int id = intern_activity(&enc->dictionary, StringValueCStr(activity));
+            if (id == RARRAY_LEN(build->names)) rb_ary_push(build->names, activity);
+            if (enc->event_count >= capacity) {
+                capacity *= 2;
+                enc->events = (int *)realloc(enc->events, sizeof(int) * capacity);
+            }
+            enc->events[enc->event_count++] = id;
+        }
+    }
+    enc->case_offsets[enc->case_count] = enc->event_count;
+
+    DFG *dfg = build->dfg = compute_dfg(enc);
+    VALUE starts = rb_ary_new(), ends = rb_ary_new(), edges = rb_ary_new();
+    for (int a = 0; a < dfg->n; a++) {
+        VALUE name = RARRAY_AREF(build->names, a);
+        if (dfg->start_counts[a] > 0) rb_ary_push(starts, name);
+        if (dfg->end_counts[a] > 0) rb_ary_push(ends, name);
+        for (int b = 0; b < dfg->n; b++) {
+            if (dfg->counts[(size_t)a * dfg->n + b] > 0) {
+                rb_ary_push(edges, rb_assoc_new(name, RARRAY_AREF(build->names, b)));
+            }
+        }
+    }
+    return rb_ary_new_from_args(4, rb_ary_dup(build->names), starts, ends, edges);
+}
+
+static VALUE dfg_free(VALUE arg) {
+    DfgBuild *build = (DfgBuild *)arg;
+    if (build->dfg) free_dfg(build->dfg);
+    free_encoded_log(build->enc);
+    return Qnil;
+}
+
+static VALUE k_dfg(VALUE self, VALUE traces) {
+    DfgBuild build;
+    (void)self;
+    Check_Type(traces, T_ARRAY);
+    build.traces = traces;
+    build.names = rb_ary_new();
+    build.dfg = NULL;
+    build.enc = (EncodedLog *)malloc(sizeof(EncodedLog));
+    init_activity_dictionary(&build.enc->dictionary);
+    build.enc->case_count = 0;
+    build.enc->event_count = 0;
+    build.enc->case_offsets = NULL;
+    build.enc->events = NULL;
+    VALUE result = rb_ensure(dfg_compute, (VALUE)&build, dfg_free, (VALUE)&build);
+    RB_GC_GUARD(build.names);
+    return result;
+}
+
+void Init_k_native(void) {
+    VALUE module = rb_define_module("KNative");
+    rb_define_module_function(module, "import_xes", k_import_xes, 1);
+    rb_define_module_function(module, "import_xes_ids", k_import_xes_ids, 1);
+    rb_define_module_function(module, "dfg", k_dfg, 1);
+}
@@ -1,3 +1,12 @@
+# Native importer (rb_k_native.c), used by import when it is built. It reads with the line
+# parser of c/c_xes.c, which has limits the Ruby importer does not: lines are read in pieces of
+# at most 1023 bytes (a longer line is split, so an attribute on it may be missed or misread)
+# and activity names are cut to 255 bytes.
+begin
+  require_relative 'k_native'
+rescue LoadError
+end
+
 class XESImporterExporter
   attr_accessor :traces
 
@@ -7,6 +16,9 @@ class XESImporterExporter
 
   # Import XES file and populate @traces
   def import(file_path)
+    # Natively if available: the same traces, the activities as frozen, shared strings
+    return @traces.concat(KNative.import_xes(file_path)) if defined?(KNative)
+
     current_trace = nil
     inside_event = false
 